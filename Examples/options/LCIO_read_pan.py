@@ -74,7 +74,6 @@ pandoralg.collections = [
 pandoralg.WriteClusterCollection               = "PandoraClusters"              
 pandoralg.WriteReconstructedParticleCollection = "PandoraPFOs" 
 pandoralg.WriteVertexCollection                = "PandoraPFANewStartVertices"               
-pandoralg.AnaOutput = "Pandora_Ana.root"
 
 pandoralg.PandoraSettingsDefault_xml = "../Reconstruction/PFA/Pandora/PandoraSettingsDefault.xml"
 #### Do not chage the collection name, only add or delete ###############
@@ -119,11 +118,16 @@ write = PodioOutput("write")
 write.filename = "test.root"
 write.outputCommands = ["keep *"]
 
+# optional analysis tree of the pandora output
+from Configurables import PandoraAnaAlg
+pandoraana = PandoraAnaAlg("PandoraAnaAlg")
+pandoraana.AnaOutput = "Pandora_Ana.root"
+
 # ApplicationMgr
 from Configurables import ApplicationMgr
 ApplicationMgr(
         #TopAlg = [read, pandoralg, write],
-        TopAlg = [read, pandoralg],
+        TopAlg = [read, pandoralg, pandoraana],
         EvtSel = 'NONE',
         EvtMax = 1,
         ExtSvc = [dsvc, gearSvc],
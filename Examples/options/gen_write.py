@@ -6,26 +6,28 @@ from Configurables import CEPCDataSvc
 dsvc = CEPCDataSvc("EventDataSvc")
 
 from Configurables import GenAlgo
+from Configurables import SLCIORdr
+from Configurables import GenPrinter
+from Configurables import GenWriter
 
-read = GenAlgo("read")
 #######################################
 #support format: stdhep, slcio, hepmc #
 #######################################
-#read.Input = "/junofs/users/wxfang/CEPC/CEPCOFF/TestExample/stdhep/nnh_e2e2.e0.p0.00001.stdhep"
-#read.FileFormat = "stdhep"
-read.Input = "/junofs/users/wxfang/CEPC/whizard_apply/ee/ee.slcio"
-read.FileFormat = "slcio"
-read.PrintEvent = True # true for printing mc info
-read.WriteFile = True  # true for writting info to root
-
-from Configurables import PodioOutput
-out = PodioOutput("out")
-out.filename = "test.root" #name of output root file
-out.outputCommands = ["keep *"]
+lciordr = SLCIORdr("SLCIORdr")
+lciordr.Input = "/junofs/users/wxfang/CEPC/whizard_apply/ee/ee.slcio"
+
+genprinter = GenPrinter("GenPrinter") # for printing mc info
+
+writer = GenWriter("GenWriter") # for writting info to root
+writer.Output = "test.root" #name of output root file
+writer.QueueSize = 16
+
+read = GenAlgo("read")
+read.GenTools = ["SLCIORdr", "GenPrinter", "GenWriter"]
 
 # ApplicationMgr
 from Configurables import ApplicationMgr
-ApplicationMgr( TopAlg = [read, out],
+ApplicationMgr( TopAlg = [read],
                 EvtSel = 'NONE',
                 EvtMax = 11,
                 ExtSvc=[dsvc],
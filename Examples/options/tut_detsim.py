@@ -78,6 +78,18 @@ gun.PhiMaxs = [360.] # rad; 360deg
 # hepmcrdr = HepMCRdr("HepMCRdr")
 # hepmcrdr.Input = "example_UsingIterators.txt"
 
+# background overlay: a pool of events of another reader, added to each event
+# bkgrdr = HepMCRdr("BkgRdr")
+# bkgrdr.Input = "pairs.hepmc"
+# from Configurables import GenOverlayTool
+# overlay = GenOverlayTool("GenOverlayTool")
+# overlay.Source = "HepMCRdr/BkgRdr"
+# overlay.PoolSize = 1000
+# overlay.MeanPerBunchCrossing = 1.
+# overlay.FirstBunchCrossing = -5
+# overlay.LastBunchCrossing = 5
+# overlay.BunchSpacing = 680. # ns
+
 genprinter = GenPrinter("GenPrinter")
 
 genalg = GenAlgo("GenAlgo")
@@ -86,6 +98,17 @@ genalg.GenTools = ["GtGunTool"]
 # genalg.GenTools = ["StdHepRdr", "GenPrinter"]
 # genalg.GenTools = ["SLCIORdr", "GenPrinter"]
 # genalg.GenTools = ["HepMCRdr", "GenPrinter"]
+# genalg.GenTools = ["StdHepRdr", "GenOverlayTool"]
+
+# preselection: a muon with pt > 10 GeV in the acceptance, the rejected events are not simulated
+# from Configurables import GenFilterTool
+# genfilter = GenFilterTool("GenFilterTool")
+# genfilter.PDGs = [13]
+# genfilter.PtMin = 10. # GeV
+# genfilter.ThetaMin = 10. # deg
+# genfilter.ThetaMax = 170. # deg
+# genalg.GenTools = ["StdHepRdr", "GenFilterTool"]
+# and GenAlgo in a sequencer before the simulation, see below
 
 ##############################################################################
 # Detector Simulation
@@ -129,6 +152,11 @@ out.outputCommands = ["keep *"]
 # ApplicationMgr
 ##############################################################################
 
+# with a GenFilterTool, the sequencer stops at GenAlgo for the rejected events
+# from Configurables import Gaudi__Sequencer
+# genseq = Gaudi__Sequencer("GenSimSeq", Members = [genalg, detsimalg, out], ShortCircuit = True)
+# and TopAlg = [genseq]
+
 from Configurables import ApplicationMgr
 ApplicationMgr( TopAlg = [genalg, detsimalg, out],
                 EvtSel = 'NONE',
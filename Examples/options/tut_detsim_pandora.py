@@ -156,7 +156,6 @@ pandoralg.collections = [
 pandoralg.WriteClusterCollection               = "PandoraClusters"              
 pandoralg.WriteReconstructedParticleCollection = "PandoraPFOs" 
 pandoralg.WriteVertexCollection                = "PandoraPFANewStartVertices"               
-pandoralg.AnaOutput = "Ana.root"
 
 pandoralg.PandoraSettingsDefault_xml = "../Reconstruction/PFA/Pandora/PandoraSettingsDefault.xml"
 #### Do not chage the collection name, only add or remove ###############
@@ -201,10 +200,15 @@ write = PodioOutput("write")
 write.filename = "test.root"
 write.outputCommands = ["keep *"]
 
+# optional analysis tree of the pandora output
+from Configurables import PandoraAnaAlg
+pandoraana = PandoraAnaAlg("PandoraAnaAlg")
+pandoraana.AnaOutput = "Ana.root"
+
 # ApplicationMgr
 from Configurables import ApplicationMgr
 ApplicationMgr(
-        TopAlg = [genalg, detsimalg, example_CaloDigiAlg, pandoralg],
+        TopAlg = [genalg, detsimalg, example_CaloDigiAlg, pandoralg, pandoraana],
         EvtSel = 'NONE',
         EvtMax = 10,
         ExtSvc = [rndmengine, dsvc, geosvc, gearSvc,detsimsvc],
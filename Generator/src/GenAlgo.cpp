@@ -7,11 +7,14 @@
 
 #include "edm4hep/MCParticleCollection.h"//plico
 
+#include <algorithm>
 #include <iostream>
 #include <vector>
 #include <fstream>
+#include <string>
 
 #include "IGenTool.h"
+#include "GenReader.h"
 #include "GenEvent.h"
 // #include "StdHepRdr.h"
 // #include "HepevtRdr.h"// not correct still
@@ -41,6 +44,43 @@ GenAlgo::initialize() {
     for (auto gtname: m_genToolNames) {
         m_genTools.push_back(gtname);
     }
+
+    // checked even if they select the whole input, e.g. a Shard 3 with the default NShards 1
+    if (m_first_event.value() < 0 || m_n_shards.value() < 1 || m_shard.value() < 0 || m_shard.value() >= m_n_shards.value()) {
+        error() << "Invalid event range: FirstEvent " << m_first_event.value()
+                << ", Shard " << m_shard.value() << " of " << m_n_shards.value() << endmsg;
+        return StatusCode::FAILURE;
+    }
+
+    if (m_first_event.value() > 0 || m_n_shards.value() > 1) {
+        if (m_genTools.retrieve().isFailure()) {
+            error() << "Failed to retrieve the gentools." << endmsg;
+            return StatusCode::FAILURE;
+        }
+        // the readers are positioned before the first event is read
+        for (auto gentool: m_genTools) {
+            GenReader* reader = dynamic_cast<GenReader*>(gentool.get());
+            if (!reader) continue;
+            long first = m_first_event.value();
+            long count = -1;
+            if (m_n_shards.value() > 1) {
+                const long total = reader->numEvents();
+                if (total < 0) {
+                    error() << "Number of events of " << gentool.name() << " unknown, can not shard it." << endmsg;
+                    return StatusCode::FAILURE;
+                }
+                const long n = std::max(total - first, 0L);
+                first += n * m_shard.value() / m_n_shards.value();
+                count = n * (m_shard.value() + 1) / m_n_shards.value() - n * m_shard.value() / m_n_shards.value();
+            }
+            info() << gentool.name() << " reads " << (count < 0 ? std::string("all") : std::to_string(count))
+                   << " events from event " << first << endmsg;
+            if (!reader->setEventRange(first, count)) {
+                error() << "Failed to move " << gentool.name() << " to event " << first << endmsg;
+                return StatusCode::FAILURE;
+            }
+        }
+    }
     
     // cout << "initialize start" << endl; 
     // string generatorName = m_input_file.value();
@@ -72,7 +112,14 @@ GenAlgo::execute() {
     MyHepMC::GenEvent m_event(*mcCol);
 
     for(auto gentool: m_genTools) {
-        if (gentool->mutate(m_event)) {} 
+        if (gentool->mutate(m_event)) {
+            // rejected by a filter tool: the next tools and the algorithms after GenAlgo
+            // in a sequencer are skipped
+            if (!m_event.getFilterPassed()) {
+                setFilterPassed(false);
+                return StatusCode::SUCCESS;
+            }
+        } 
         else {
             cout << "Have read all events, stop now." << endl; 
             auto ep = serviceLocator()->as<IEventProcessor>();
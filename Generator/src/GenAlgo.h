@@ -34,6 +34,11 @@ private:
     Gaudi::Property<std::string> m_output_file{this, "OutputRootFile", "NULL"};
     Gaudi::Property<bool> m_print{this, "PrintEvent", "NULL"};
     Gaudi::Property<bool> m_do_write{this, "WriteFile", "NULL"};
+    // first event of the input files to read
+    Gaudi::Property<long> m_first_event{this, "FirstEvent", 0};
+    // split the events from FirstEvent on into NShards equal ranges, and read the range Shard only
+    Gaudi::Property<int> m_shard{this, "Shard", 0};
+    Gaudi::Property<int> m_n_shards{this, "NShards", 1};
 
     std::vector<std::string> m_genToolNames;                                                         
     // std::vector<IGenTool*> m_genTools;
@@ -0,0 +1,197 @@
+#include "GenAsciiInput.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+const std::size_t buffer_size = 1 << 20;
+
+inline bool is_space(char c){
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+// exactly representable powers of ten
+const double exact_pow10[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+// general case: let strtod do it on a terminated copy of the token
+bool parse_double_slow(const char* begin, std::size_t length, double& value){
+    std::string token(begin, length);
+    char* end = nullptr;
+    value = std::strtod(token.c_str(), &end);
+    return end == token.c_str() + length;
+}
+
+bool parse_double(const char* begin, std::size_t length, double& value){
+    const char* p = begin;
+    const char* end = begin + length;
+    bool negative = false;
+    if (p != end && (*p == '-' || *p == '+')) negative = (*p++ == '-');
+
+    std::uint64_t mantissa = 0;
+    int digits = 0;      // significant digits in the mantissa
+    int exponent = 0;
+    bool any_digit = false;
+    for (; p != end && *p >= '0' && *p <= '9'; ++p) {
+        any_digit = true;
+        if (mantissa == 0 && *p == '0') continue;
+        if (++digits > 19) return parse_double_slow(begin, length, value);
+        mantissa = mantissa * 10 + (*p - '0');
+    }
+    if (p != end && *p == '.') {
+        for (++p; p != end && *p >= '0' && *p <= '9'; ++p) {
+            any_digit = true;
+            --exponent;
+            if (mantissa == 0 && *p == '0') continue;
+            if (++digits > 19) return parse_double_slow(begin, length, value);
+            mantissa = mantissa * 10 + (*p - '0');
+        }
+    }
+    if (!any_digit) return parse_double_slow(begin, length, value); // inf, nan, ...
+    if (p != end && (*p == 'e' || *p == 'E')) {
+        ++p;
+        bool negative_exponent = false;
+        if (p != end && (*p == '-' || *p == '+')) negative_exponent = (*p++ == '-');
+        if (p == end) return false;
+        int e = 0;
+        for (; p != end && *p >= '0' && *p <= '9'; ++p) {
+            if (e > 100000) return parse_double_slow(begin, length, value);
+            e = e * 10 + (*p - '0');
+        }
+        exponent += negative_exponent ? -e : e;
+    }
+    if (p != end) return false;
+
+    // exact when both the mantissa and the power of ten are exact doubles
+    if (mantissa > (std::uint64_t(1) << 53) || exponent < -22 || exponent > 22) return parse_double_slow(begin, length, value);
+    double v = double(mantissa);
+    if (exponent < 0) v /= exact_pow10[-exponent];
+    else              v *= exact_pow10[exponent];
+    value = negative ? -v : v;
+    return true;
+}
+
+bool parse_int(const char* p, std::size_t length, int& value){
+    const char* end = p + length;
+    bool negative = false;
+    if (p != end && (*p == '-' || *p == '+')) negative = (*p++ == '-');
+    if (p == end) return false;
+    long long v = 0;
+    for (; p != end; ++p) {
+        if (*p < '0' || *p > '9') return false;
+        v = v * 10 + (*p - '0');
+        if (v > 2147483648LL) return false;
+    }
+    if (negative) v = -v;
+    if (v > 2147483647LL) return false;
+    value = int(v);
+    return true;
+}
+
+}
+
+GenAsciiInput::GenAsciiInput()
+    : m_pos(0), m_end(0), m_eof(true){
+}
+
+GenAsciiInput::~GenAsciiInput(){
+    close();
+}
+
+bool GenAsciiInput::open(const std::string& filename){
+    close();
+    if (!m_stream.open(filename)) return false;
+    m_buffer.resize(buffer_size);
+    m_pos = m_end = 0;
+    m_eof = false;
+    return true;
+}
+
+void GenAsciiInput::close(){
+    m_stream.close();
+    m_pos = m_end = 0;
+    m_eof = true;
+}
+
+bool GenAsciiInput::isOpen() const{
+    return m_stream.isOpen();
+}
+
+bool GenAsciiInput::seek(long long offset){
+    if (!m_stream.seek(offset)) return false;
+    m_pos = m_end = 0;
+    m_eof = false;
+    return true;
+}
+
+long long GenAsciiInput::tell(){
+    if (atEnd()) return -1;
+    // the stream is ahead by the bytes still in the buffer
+    return m_stream.tell() - static_cast<long long>(m_end - m_pos);
+}
+
+bool GenAsciiInput::failed() const{
+    return m_stream.failed();
+}
+
+bool GenAsciiInput::fill(){
+    if (m_eof) return false;
+    if (m_pos > 0) {
+        std::memmove(m_buffer.data(), m_buffer.data() + m_pos, m_end - m_pos);
+        m_end -= m_pos;
+        m_pos = 0;
+    }
+    // a token longer than the buffer grows it
+    if (m_end == m_buffer.size()) m_buffer.resize(2 * m_buffer.size());
+    const std::size_t n = m_stream.read(m_buffer.data() + m_end, m_buffer.size() - m_end);
+    if (n == 0) m_eof = true;
+    m_end += n;
+    return n > 0;
+}
+
+const char* GenAsciiInput::token(std::size_t& length){
+    for (;;) {
+        while (m_pos < m_end && is_space(m_buffer[m_pos])) ++m_pos;
+        if (m_pos < m_end) break;
+        if (!fill()) return nullptr;
+    }
+    std::size_t end = m_pos;
+    for (;;) {
+        while (end < m_end && !is_space(m_buffer[end])) ++end;
+        // the token may go on in the part of the file not read yet
+        if (end < m_end || m_eof) break;
+        // fill moves the bytes down even when it finds the end of the file
+        const std::size_t offset = end - m_pos;
+        const bool more = fill();
+        end = m_pos + offset;
+        if (!more) break;
+    }
+    const char* begin = m_buffer.data() + m_pos;
+    length = end - m_pos;
+    m_pos = end;
+    return begin;
+}
+
+bool GenAsciiInput::next(int& value){
+    std::size_t length = 0;
+    const char* begin = token(length);
+    return begin && parse_int(begin, length, value);
+}
+
+bool GenAsciiInput::next(double& value){
+    std::size_t length = 0;
+    const char* begin = token(length);
+    return begin && parse_double(begin, length, value);
+}
+
+bool GenAsciiInput::atEnd(){
+    for (;;) {
+        while (m_pos < m_end && is_space(m_buffer[m_pos])) ++m_pos;
+        if (m_pos < m_end) return false;
+        if (!fill()) return true;
+    }
+}
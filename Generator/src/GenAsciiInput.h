@@ -0,0 +1,55 @@
+#ifndef GenAsciiInput_h
+#define GenAsciiInput_h 1
+
+/*
+ * GenAsciiInput reads whitespace separated numbers from an ASCII generator
+ * file through a large buffer. The numbers are parsed in place, without
+ * the locale handling and allocations of std::istream extraction.
+ * Compressed files are read through GenInputStream.
+ */
+
+#include "GenInputStream.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+class GenAsciiInput {
+    public:
+        GenAsciiInput();
+        ~GenAsciiInput();
+
+        bool open(const std::string& filename);
+        void close();
+        bool isOpen() const;
+        // continue reading at a byte offset of the file
+        bool seek(long long offset);
+        // the byte offset of the next token, -1 at the end of the input
+        long long tell();
+        // true if a compressed file turned out to be corrupt or truncated
+        bool failed() const;
+
+        // read the next number, false at the end of the input or if the token is not a number
+        bool next(int& value);
+        bool next(double& value);
+
+        // true once the input has no more tokens
+        bool atEnd();
+
+    private:
+        GenAsciiInput(const GenAsciiInput&);
+        GenAsciiInput& operator=(const GenAsciiInput&);
+
+        // refill the buffer, keeping the bytes from m_pos on
+        bool fill();
+        // the next token, or NULL at the end of the input
+        const char* token(std::size_t& length);
+
+        GenInputStream m_stream;
+        std::vector<char> m_buffer;
+        std::size_t m_pos;
+        std::size_t m_end;
+        bool m_eof;
+};
+
+#endif
@@ -13,6 +13,7 @@ GenEvent::GenEvent(edm4hep::MCParticleCollection& mcCol)
     m_run_id=-1;
     m_time=-1;
     m_det_name="";
+    m_filter_passed=true;
 
 }
 GenEvent::~GenEvent(){}
@@ -23,6 +24,9 @@ void GenEvent::SetEventHeader(long event_id_, long run_id_, float time_, string
     m_time = time_;
     m_det_name = det_name_;
 }
+void GenEvent::SetFilterPassed(bool passed_){
+    m_filter_passed = passed_;
+}
 /*
 void GenEvent::SetMCCollection(edm4hep::MCParticleCollection vec_){
 m_mc_vec = vec_;
@@ -38,6 +42,7 @@ return m_event_id;
 long GenEvent::getRun() {return m_run_id;}
 long GenEvent::getTime() {return m_time;}
 std::string GenEvent::getName() {return m_det_name;}
+bool GenEvent::getFilterPassed() {return m_filter_passed;}
 
 void GenEvent::ReSet(){
 
@@ -45,6 +50,7 @@ void GenEvent::ReSet(){
     m_run_id=-1;
     m_time=-1;
     m_det_name="";
+    m_filter_passed=true;
     m_mc_vec.clear();
 }
 }
@@ -11,12 +11,15 @@ class GenEvent{
         GenEvent(edm4hep::MCParticleCollection& mcCol);
         ~GenEvent();
         void SetEventHeader(long event_id_, long run_id_, float time_, std::string det_name_);
+        // a filter tool rejects the event with false
+        void SetFilterPassed(bool passed_);
         //void SetMCCollection(edm4hep::MCParticleCollection vec_);
         long getID();
         long getRun();
         long getTime();
         void ReSet();
         std::string getName();
+        bool getFilterPassed();
         edm4hep::MCParticleCollection getMCVec();
         edm4hep::MCParticleCollection& m_mc_vec;
         //edm4hep::MCParticleCollection m_mc_vec;
@@ -25,6 +28,7 @@ class GenEvent{
         long m_run_id;
         float m_time;
         std::string m_det_name;
+        bool m_filter_passed;
 };
 
 }
@@ -0,0 +1,155 @@
+#include "GenEventIndex.h"
+#include "GenInputStream.h"
+#include "HepevtParser.h"
+
+#include <cstdio>
+#include <iostream>
+#include <random>
+
+#include <unistd.h>
+
+namespace {
+
+// v2: the HEPEvt events are the ones of HepevtParser
+const char* index_tag = "GenEventIndex.v2";
+const char* index_end_tag = "End";
+
+// FNV-1a over the offsets, to reject a truncated or corrupt index
+unsigned long long checksum(const std::vector<long long>& offsets){
+    unsigned long long hash = 14695981039346656037ULL;
+    for (long long offset: offsets) {
+        for (int byte = 0; byte < 8; byte++) {
+            hash ^= (static_cast<unsigned long long>(offset) >> (8*byte)) & 0xff;
+            hash *= 1099511628211ULL;
+        }
+    }
+    return hash;
+}
+
+long long file_size(const std::string& path){
+    std::FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) return -1;
+    long long size = -1;
+    if (std::fseek(f, 0, SEEK_END) == 0) size = std::ftell(f);
+    std::fclose(f);
+    return size;
+}
+
+}
+
+bool GenEventIndex::open(const std::string& input, Format format){
+    if (!m_input.empty() && m_input == input && m_format == format) return true;
+    m_input.clear();
+    m_offsets.clear();
+    m_format = format;
+
+    const long long input_size = file_size(input);
+    if (input_size < 0) {
+        std::cout << "GenEventIndex: can not open " << input << std::endl;
+        return false;
+    }
+    const std::string path = input + ".idx";
+    if (!load(path, input_size)) {
+        std::cout << "GenEventIndex: building the event index of " << input << std::endl;
+        if (!build(input)) return false;
+        if (!save(path, input_size)) std::cout << "GenEventIndex: could not save " << path << ", the index is kept in memory" << std::endl;
+    }
+    m_input = input;
+    std::cout << "GenEventIndex: " << m_offsets.size() << " events in " << input << std::endl;
+    return true;
+}
+
+long GenEventIndex::size() const{
+    return m_offsets.size();
+}
+
+long long GenEventIndex::offset(long event) const{
+    return m_offsets.at(event);
+}
+
+bool GenEventIndex::load(const std::string& path, long long input_size){
+    std::FILE* f = std::fopen(path.c_str(), "r");
+    if (!f) return false;
+    char tag[32] = {0};
+    int format = 0;
+    long long size = -1;
+    long n = -1;
+    bool ok = std::fscanf(f, "%31s %d %lld %ld", tag, &format, &size, &n) == 4
+           && std::string(tag) == index_tag && format == m_format && size == input_size && n >= 0;
+    if (ok) {
+        m_offsets.resize(n);
+        for (long i = 0; ok && i < n; i++) {
+            ok = std::fscanf(f, "%lld", &m_offsets[i]) == 1 && m_offsets[i] >= 0
+              && (i == 0 || m_offsets[i] > m_offsets[i-1]);
+        }
+    }
+    if (ok) {
+        char end_tag[8] = {0};
+        unsigned long long hash = 0;
+        ok = std::fscanf(f, "%7s %llu", end_tag, &hash) == 2
+          && std::string(end_tag) == index_end_tag && hash == checksum(m_offsets);
+    }
+    std::fclose(f);
+    if (!ok) m_offsets.clear();
+    return ok;
+}
+
+bool GenEventIndex::build(const std::string& input){
+    // the offsets are the ones of the decompressed file
+    if (m_format == Hepevt) return buildHepevt(input);
+
+    GenInputStream f;
+    if (!f.open(input)) return false;
+
+    std::vector<char> buffer(1 << 20);
+    long long pos = 0;          // offset of the buffer in the file
+    bool line_start = true;
+    long long line_offset = 0;  // offset of the current line
+    // an event line starts with "E "
+    bool maybe_event = false;
+
+    std::size_t n = 0;
+    while ((n = f.read(buffer.data(), buffer.size())) > 0) {
+        for (std::size_t i = 0; i < n; i++) {
+            const char c = buffer[i];
+            if (line_start) line_offset = pos + i;
+            if (maybe_event && c == ' ') m_offsets.push_back(line_offset);
+            maybe_event = line_start && c == 'E';
+            line_start = (c == '\n');
+        }
+        pos += n;
+    }
+    return !f.failed();
+}
+
+bool GenEventIndex::buildHepevt(const std::string& input){
+    // the numbers are whitespace separated, not one particle per line: only the parser knows where an event ends
+    HepevtParser parser;
+    if (!parser.open(input)) return false;
+
+    std::vector<HepevtParticle> particles;
+    for (long long offset = parser.tell(); offset >= 0; offset = parser.tell()) {
+        if (!parser.readEvent(particles)) {
+            // the reader stops there as well
+            std::cout << "GenEventIndex: event " << m_offsets.size() << " of " << input << " is malformed, the index ends before it" << std::endl;
+            break;
+        }
+        m_offsets.push_back(offset);
+    }
+    return !parser.failed();
+}
+
+bool GenEventIndex::save(const std::string& path, long long input_size) const{
+    // jobs sharing the input may save at the same time: each one writes its own
+    // file and renames it into place, so a reader never sees a partial index
+    const std::string tmp = path + ".tmp." + std::to_string(::getpid()) + "." + std::to_string(std::random_device()());
+    std::FILE* f = std::fopen(tmp.c_str(), "w");
+    if (!f) return false;
+    bool ok = std::fprintf(f, "%s %d %lld %ld\n", index_tag, int(m_format), input_size, long(m_offsets.size())) > 0;
+    for (std::size_t i = 0; ok && i < m_offsets.size(); i++) ok = std::fprintf(f, "%lld\n", m_offsets[i]) > 0;
+    ok = ok && std::fprintf(f, "%s %llu\n", index_end_tag, checksum(m_offsets)) > 0;
+    ok = (std::fclose(f) == 0) && ok;
+    ok = ok && std::rename(tmp.c_str(), path.c_str()) == 0;
+    if (!ok) std::remove(tmp.c_str());
+    return ok;
+}
@@ -0,0 +1,44 @@
+#ifndef GenEventIndex_h
+#define GenEventIndex_h 1
+
+/*
+ * GenEventIndex maps the event number of an ASCII generator file to the
+ * byte offset where the event starts, so that a reader can start at any
+ * event without parsing the ones before.
+ *
+ * The index is kept in a sidecar file "<input>.idx". It is loaded if it
+ * matches the size of the input and its checksum, otherwise it is built by
+ * one scan of the input and saved next to it when the directory is
+ * writable, through a rename so that concurrent jobs read whole files. The offsets
+ * of a compressed input are the ones in the decompressed file.
+ *
+ * HepMC events start with a line "E ...". HEPEvt events are found by
+ * reading them with HepevtParser, so that the index and the reader agree
+ * on where an event starts whatever the line breaks between the numbers.
+ */
+
+#include <string>
+#include <vector>
+
+class GenEventIndex {
+    public:
+        enum Format { HepMC = 1, Hepevt = 2 };
+
+        // load or build the index of the input, does nothing if it is already open for it
+        bool open(const std::string& input, Format format);
+
+        long size() const;
+        long long offset(long event) const;
+
+    private:
+        bool load(const std::string& path, long long input_size);
+        bool build(const std::string& input);
+        bool buildHepevt(const std::string& input);
+        bool save(const std::string& path, long long input_size) const;
+
+        std::string m_input;
+        Format m_format{HepMC};
+        std::vector<long long> m_offsets;
+};
+
+#endif
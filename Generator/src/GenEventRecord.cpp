@@ -0,0 +1,84 @@
+#include "GenEventRecord.h"
+
+#include "edm4hep/MCParticle.h"
+#include "edm4hep/MCParticleCollection.h"
+
+namespace MyHepMC {
+
+void GenEventRecord::clear(){
+    m_particles.clear();
+    m_parents.clear();
+    m_daughters.clear();
+}
+
+void GenEventRecord::reserve(int n_particle){
+    m_particles.reserve(n_particle);
+    m_parents.reserve(n_particle);
+    m_daughters.reserve(n_particle);
+}
+
+GenParticleRecord& GenEventRecord::addParticle(){
+    m_particles.emplace_back();
+    return m_particles.back();
+}
+
+void GenEventRecord::addParent(int index, int parent){
+    m_parents.emplace_back(index, parent);
+}
+
+void GenEventRecord::addDaughter(int index, int daughter){
+    m_daughters.emplace_back(index, daughter);
+}
+
+void GenEventRecord::readCollection(const edm4hep::MCParticleCollection& collection){
+    clear();
+    reserve(collection.size());
+    for (unsigned int i = 0; i < collection.size(); i++){
+        const edm4hep::ConstMCParticle mcp = collection.at(i);
+        GenParticleRecord& p = addParticle();
+        p.pdg                = mcp.getPDG();
+        p.generatorStatus    = mcp.getGeneratorStatus();
+        p.simulatorStatus    = mcp.getSimulatorStatus();
+        p.charge             = mcp.getCharge();
+        p.time               = mcp.getTime();
+        p.mass               = mcp.getMass();
+        p.vertex             = mcp.getVertex();
+        p.endpoint           = mcp.getEndpoint();
+        p.momentum           = mcp.getMomentum();
+        p.momentumAtEndpoint = mcp.getMomentumAtEndpoint();
+        p.spin               = mcp.getSpin();
+        p.colorFlow          = mcp.getColorFlow();
+    }
+    // the related particles are in the same collection, so their index is the one of the object id
+    for (unsigned int i = 0; i < collection.size(); i++){
+        const edm4hep::ConstMCParticle mcp = collection.at(i);
+        for (auto it = mcp.parents_begin(), end = mcp.parents_end(); it != end; ++it)     addParent  (i, it->getObjectID().index);
+        for (auto it = mcp.daughters_begin(), end = mcp.daughters_end(); it != end; ++it) addDaughter(i, it->getObjectID().index);
+    }
+}
+
+void GenEventRecord::fillEvent(GenEvent& event, float time_offset) const{
+    std::vector<edm4hep::MCParticle> mcps;
+    mcps.reserve(m_particles.size());
+    for (const GenParticleRecord& p: m_particles){
+        edm4hep::MCParticle mcp = event.m_mc_vec.create();
+        mcp.setPDG                (p.pdg);
+        mcp.setGeneratorStatus    (p.generatorStatus);
+        mcp.setSimulatorStatus    (p.simulatorStatus);
+        mcp.setCharge             (p.charge);
+        mcp.setTime               (p.time + time_offset);
+        mcp.setMass               (p.mass);
+        mcp.setVertex             (p.vertex);
+        mcp.setEndpoint           (p.endpoint);
+        mcp.setMomentum           (p.momentum);
+        mcp.setMomentumAtEndpoint (p.momentumAtEndpoint);
+        mcp.setSpin               (p.spin);
+        mcp.setColorFlow          (p.colorFlow);
+        mcps.push_back(mcp);
+    }
+    // the links are kept in particle order, so each particle gets its relations in the reader's order
+    for (const std::pair<int, int>& link: m_parents)   mcps[link.first].addToParents  (mcps[link.second]);
+    for (const std::pair<int, int>& link: m_daughters) mcps[link.first].addToDaughters(mcps[link.second]);
+}
+
+}
@@ -0,0 +1,55 @@
+#ifndef GenEventRecord_h
+#define GenEventRecord_h 1
+
+/*
+ * GenEventRecord holds one decoded generator event as plain data: the
+ * particles and their parent/daughter links by index in the event.
+ * Readers decode into it away from the event store (e.g. in a read-ahead
+ * thread), and fillEvent copies it into the MCParticle collection in one pass.
+ */
+
+#include "edm4hep/Vector2i.h"
+#include "edm4hep/Vector3d.h"
+#include "edm4hep/Vector3f.h"
+
+#include "GenEvent.h"
+
+#include <utility>
+#include <vector>
+
+namespace MyHepMC {
+
+struct GenParticleRecord {
+    int                pdg{0};
+    int                generatorStatus{0};
+    int                simulatorStatus{0};
+    float              charge{0};
+    float              time{0};
+    double             mass{0};
+    edm4hep::Vector3d  vertex;
+    edm4hep::Vector3d  endpoint;
+    edm4hep::Vector3f  momentum;
+    edm4hep::Vector3f  momentumAtEndpoint;
+    edm4hep::Vector3f  spin;
+    edm4hep::Vector2i  colorFlow;
+};
+
+class GenEventRecord {
+    public:
+        void clear();
+        void reserve(int n_particle);
+        GenParticleRecord& addParticle();
+        void addParent(int index, int parent);
+        void addDaughter(int index, int daughter);
+        // copy the particles and their links of a collection, e.g. one filled by another IGenTool
+        void readCollection(const edm4hep::MCParticleCollection& collection);
+        // append the particles after the ones already in the event, with their time shifted by time_offset
+        void fillEvent(GenEvent& event, float time_offset=0) const;
+
+        std::vector<GenParticleRecord>    m_particles;
+        std::vector<std::pair<int, int> > m_parents;   // (particle, parent)
+        std::vector<std::pair<int, int> > m_daughters; // (particle, daughter)
+};
+
+}
+#endif
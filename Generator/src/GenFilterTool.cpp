@@ -0,0 +1,101 @@
+#include "GenFilterTool.h"
+
+#include "CLHEP/Units/SystemOfUnits.h"
+
+#include "edm4hep/MCParticle.h"
+#include "edm4hep/MCParticleCollection.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+DECLARE_COMPONENT(GenFilterTool)
+
+StatusCode
+GenFilterTool::initialize() {
+    StatusCode sc;
+    if (m_theta_min.value() < 0 || m_theta_max.value() > 180. || m_theta_min.value() > m_theta_max.value()) {
+        error() << "ThetaMin and ThetaMax should be within [0, 180] deg." << endmsg;
+        return StatusCode::FAILURE;
+    }
+    if (m_max_count.value() >= 0 && m_max_count.value() < m_min_count.value()) {
+        error() << "MaxCount is smaller than MinCount." << endmsg;
+        return StatusCode::FAILURE;
+    }
+
+    if (not configure_gentool()) {
+        error() << "failed to initialize." << endmsg;
+        return StatusCode::FAILURE;
+    }
+
+    return sc;
+}
+
+StatusCode
+GenFilterTool::finalize() {
+    StatusCode sc;
+    const long n_events = m_n_accepted + m_n_rejected;
+    info() << "Accepted " << m_n_accepted << " and rejected " << m_n_rejected << " of " << n_events
+           << " events, efficiency " << (n_events ? double(m_n_accepted)/n_events : 0.) << endmsg;
+    return sc;
+}
+
+bool
+GenFilterTool::mutate(MyHepMC::GenEvent& event) {
+
+    const bool any_pdg = m_abs_pdgs.empty();
+    const bool any_status = m_status.value().empty();
+    const std::vector<int>& status = m_status.value();
+    // without an upper limit, the loop ends once enough particles are found
+    const int enough = m_max_count.value() >= 0 ? m_max_count.value() + 1 : m_min_count.value();
+
+    int count = 0;
+    for (auto mcp: event.m_mc_vec) {
+        if (!any_status && std::find(status.begin(), status.end(), mcp.getGeneratorStatus()) == status.end()) continue;
+        if (!any_pdg && !std::binary_search(m_abs_pdgs.begin(), m_abs_pdgs.end(), std::abs(mcp.getPDG()))) continue;
+
+        const edm4hep::Vector3f& mom = mcp.getMomentum();
+        const double pt2 = double(mom.x)*mom.x + double(mom.y)*mom.y;
+        const double p2 = pt2 + double(mom.z)*mom.z;
+        const double p = std::sqrt(p2);
+        // cos(theta) = pz/p within [cos(ThetaMax), cos(ThetaMin)], without the division
+        count += (pt2 >= m_pt2_min) & (p2 >= m_p2_min)
+               & (mom.z >= m_cos_theta_max * p) & (mom.z <= m_cos_theta_min * p);
+        if (count >= enough) break;
+    }
+
+    const bool passed = count >= m_min_count.value() && (m_max_count.value() < 0 || count <= m_max_count.value());
+    if (passed) ++m_n_accepted;
+    else ++m_n_rejected;
+    if (msgLevel(MSG::DEBUG)) debug() << "event " << event.getID() << ": " << count << " selected particles, "
+                                      << (passed ? "accepted" : "rejected") << endmsg;
+    event.SetFilterPassed(passed);
+
+    return true;
+}
+
+bool
+GenFilterTool::finish() {
+    return true;
+}
+
+bool
+GenFilterTool::configure_gentool() {
+
+    m_pt2_min = m_pt_min.value() * m_pt_min.value();
+    m_p2_min = m_p_min.value() * m_p_min.value();
+    // theta grows as cos(theta) decreases
+    m_cos_theta_min = std::cos(m_theta_min.value() * CLHEP::deg);
+    m_cos_theta_max = std::cos(m_theta_max.value() * CLHEP::deg);
+    if (m_theta_min.value() == 0.) m_cos_theta_min = 1.;
+    if (m_theta_max.value() == 180.) m_cos_theta_max = -1.;
+
+    m_abs_pdgs.clear();
+    for (int pdg: m_pdgs.value()) m_abs_pdgs.push_back(std::abs(pdg));
+    std::sort(m_abs_pdgs.begin(), m_abs_pdgs.end());
+
+    m_n_accepted = 0;
+    m_n_rejected = 0;
+
+    return true;
+}
@@ -0,0 +1,62 @@
+#ifndef GenFilterTool_h
+#define GenFilterTool_h
+
+/*
+ * Description:
+ *   A generator level preselection. The event passes if the number of
+ *   selected MCParticles is within [MinCount, MaxCount]; a particle is
+ *   selected by its generator status, |PDG|, pt, momentum and polar angle.
+ *   A rejected event stops GenAlgo, which fails its filter: put GenAlgo and
+ *   the simulation in a sequencer to skip them.
+ *
+ *   It should be the last of the GenTools which fill the event.
+ */
+
+#include <GaudiKernel/AlgTool.h>
+#include <GaudiKernel/Property.h>
+#include "IGenTool.h"
+
+#include <vector>
+
+class GenFilterTool: public extends<AlgTool, IGenTool> {
+public:
+    using extends::extends;
+
+    // Overriding initialize and finalize
+    StatusCode initialize() override;
+    StatusCode finalize() override;
+
+    // IGenTool
+    bool mutate(MyHepMC::GenEvent& event) override;
+    bool finish() override;
+    bool configure_gentool() override;
+
+private:
+    // the cuts in the units of the loop: squared momenta, cosines
+    double m_pt2_min{0};
+    double m_p2_min{0};
+    double m_cos_theta_min{-1};
+    double m_cos_theta_max{1};
+    std::vector<int> m_abs_pdgs;
+
+    long m_n_accepted{0};
+    long m_n_rejected{0};
+
+    // |PDG| of the selected particles, empty for any
+    Gaudi::Property<std::vector<int>> m_pdgs{this, "PDGs"};
+    // generator status of the selected particles, empty for any
+    Gaudi::Property<std::vector<int>> m_status{this, "GeneratorStatus", {1}};
+    // GeV
+    Gaudi::Property<double> m_pt_min{this, "PtMin", 0.};
+    Gaudi::Property<double> m_p_min{this, "PMin", 0.};
+    // deg
+    Gaudi::Property<double> m_theta_min{this, "ThetaMin", 0.};
+    Gaudi::Property<double> m_theta_max{this, "ThetaMax", 180.};
+    // number of selected particles, MaxCount -1 for no limit
+    Gaudi::Property<int> m_min_count{this, "MinCount", 1};
+    Gaudi::Property<int> m_max_count{this, "MaxCount", -1};
+
+};
+
+
+#endif
@@ -0,0 +1,370 @@
+#include "GenInputStream.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#ifdef GENINPUT_WITH_ZLIB
+#include <zlib.h>
+#endif
+#ifdef GENINPUT_WITH_LZMA
+#include <lzma.h>
+#endif
+#ifdef GENINPUT_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+namespace {
+
+const std::size_t block_size = 1 << 20;
+// decompressed blocks ready for the reader
+const std::size_t queue_depth = 4;
+
+const char* compression_name(GenInputStream::Compression compression){
+    switch (compression) {
+        case GenInputStream::Gzip: return "gzip";
+        case GenInputStream::Xz:   return "xz";
+        case GenInputStream::Zstd: return "zstd";
+        default:                   return "none";
+    }
+}
+
+GenInputStream::Compression find_compression(const unsigned char* magic, std::size_t n){
+    if (n >= 2 && magic[0] == 0x1f && magic[1] == 0x8b) return GenInputStream::Gzip;
+    if (n >= 6 && std::memcmp(magic, "\xfd" "7zXZ\0", 6) == 0) return GenInputStream::Xz;
+    if (n >= 4 && magic[0] == 0x28 && magic[1] == 0xb5 && magic[2] == 0x2f && magic[3] == 0xfd) return GenInputStream::Zstd;
+    return GenInputStream::None;
+}
+
+#ifdef GENINPUT_WITH_ZLIB
+// gzip, with several members one after the other (pigz, bgzip)
+class GzipDecoder: public GenInputStream::Decoder {
+    public:
+        GzipDecoder(){
+            std::memset(&m_stream, 0, sizeof(m_stream));
+            m_ok = inflateInit2(&m_stream, 15 + 16) == Z_OK;
+        }
+        ~GzipDecoder(){
+            if (m_ok) inflateEnd(&m_stream);
+        }
+        bool decode(const char* in, std::size_t in_size, bool, std::size_t& consumed,
+                    char* out, std::size_t out_size, std::size_t& produced, bool& boundary) override{
+            if (!m_ok) return false;
+            m_stream.next_in   = reinterpret_cast<Bytef*>(const_cast<char*>(in));
+            m_stream.avail_in  = in_size;
+            m_stream.next_out  = reinterpret_cast<Bytef*>(out);
+            m_stream.avail_out = out_size;
+            const int ret = inflate(&m_stream, Z_NO_FLUSH);
+            consumed = in_size - m_stream.avail_in;
+            produced = out_size - m_stream.avail_out;
+            if (ret == Z_STREAM_END) {
+                boundary = true;
+                return inflateReset(&m_stream) == Z_OK;
+            }
+            if (consumed || produced) boundary = false;
+            return ret == Z_OK || ret == Z_BUF_ERROR;
+        }
+    private:
+        z_stream m_stream;
+        bool m_ok;
+};
+#endif
+
+#ifdef GENINPUT_WITH_LZMA
+class XzDecoder: public GenInputStream::Decoder {
+    public:
+        XzDecoder(): m_stream(LZMA_STREAM_INIT){
+            m_ok = lzma_stream_decoder(&m_stream, UINT64_MAX, LZMA_CONCATENATED) == LZMA_OK;
+        }
+        ~XzDecoder(){
+            lzma_end(&m_stream);
+        }
+        bool decode(const char* in, std::size_t in_size, bool last, std::size_t& consumed,
+                    char* out, std::size_t out_size, std::size_t& produced, bool& boundary) override{
+            if (!m_ok) return false;
+            m_stream.next_in   = reinterpret_cast<const uint8_t*>(in);
+            m_stream.avail_in  = in_size;
+            m_stream.next_out  = reinterpret_cast<uint8_t*>(out);
+            m_stream.avail_out = out_size;
+            const lzma_ret ret = lzma_code(&m_stream, last ? LZMA_FINISH : LZMA_RUN);
+            consumed = in_size - m_stream.avail_in;
+            produced = out_size - m_stream.avail_out;
+            if (ret == LZMA_STREAM_END) {
+                boundary = true;
+                return true;
+            }
+            if (consumed || produced) boundary = false;
+            return ret == LZMA_OK || ret == LZMA_BUF_ERROR;
+        }
+    private:
+        lzma_stream m_stream;
+        bool m_ok;
+};
+#endif
+
+#ifdef GENINPUT_WITH_ZSTD
+class ZstdDecoder: public GenInputStream::Decoder {
+    public:
+        ZstdDecoder(): m_stream(ZSTD_createDStream()){
+            if (m_stream) ZSTD_initDStream(m_stream);
+        }
+        ~ZstdDecoder(){
+            ZSTD_freeDStream(m_stream);
+        }
+        bool decode(const char* in, std::size_t in_size, bool, std::size_t& consumed,
+                    char* out, std::size_t out_size, std::size_t& produced, bool& boundary) override{
+            if (!m_stream) return false;
+            ZSTD_inBuffer input = {in, in_size, 0};
+            ZSTD_outBuffer output = {out, out_size, 0};
+            const std::size_t ret = ZSTD_decompressStream(m_stream, &output, &input);
+            if (ZSTD_isError(ret)) return false;
+            consumed = input.pos;
+            produced = output.pos;
+            // 0 once a frame is complete and flushed
+            if (consumed || produced) boundary = (ret == 0);
+            return true;
+        }
+    private:
+        ZSTD_DStream* m_stream;
+};
+#endif
+
+GenInputStream::Decoder* create_decoder(GenInputStream::Compression compression){
+    switch (compression) {
+#ifdef GENINPUT_WITH_ZLIB
+        case GenInputStream::Gzip: return new GzipDecoder();
+#endif
+#ifdef GENINPUT_WITH_LZMA
+        case GenInputStream::Xz:   return new XzDecoder();
+#endif
+#ifdef GENINPUT_WITH_ZSTD
+        case GenInputStream::Zstd: return new ZstdDecoder();
+#endif
+        default: return nullptr;
+    }
+}
+
+}
+
+GenInputStream::GenInputStream()
+    : m_file(nullptr), m_compression(None), m_offset(0),
+      m_end(true), m_stop(false), m_failed(false), m_block_pos(0){
+}
+
+GenInputStream::~GenInputStream(){
+    close();
+}
+
+bool GenInputStream::open(const std::string& filename){
+    close();
+    m_file = std::fopen(filename.c_str(), "rb");
+    if (!m_file) return false;
+    m_filename = filename;
+
+    unsigned char magic[6];
+    const std::size_t n = std::fread(magic, 1, sizeof(magic), m_file);
+    m_compression = find_compression(magic, n);
+    std::rewind(m_file);
+    if (m_compression != None && !start()) {
+        std::cout << "GenInputStream: no " << compression_name(m_compression) << " support for " << filename << std::endl;
+        close();
+        return false;
+    }
+    m_offset = 0;
+    return true;
+}
+
+void GenInputStream::close(){
+    stop();
+    if (m_file) std::fclose(m_file);
+    m_file = nullptr;
+    m_compression = None;
+    m_offset = 0;
+    m_failed = false;
+}
+
+bool GenInputStream::isOpen() const{
+    return m_file != nullptr;
+}
+
+GenInputStream::Compression GenInputStream::compression() const{
+    return m_compression;
+}
+
+bool GenInputStream::failed() const{
+    return m_failed;
+}
+
+long long GenInputStream::tell() const{
+    return m_offset;
+}
+
+std::size_t GenInputStream::read(char* buffer, std::size_t size){
+    if (!m_file) return 0;
+    if (m_compression == None) {
+        const std::size_t n = std::fread(buffer, 1, size, m_file);
+        m_offset += n;
+        return n;
+    }
+    std::size_t done = 0;
+    while (done < size) {
+        if (m_block_pos == m_block.size() && !nextBlock()) break;
+        const std::size_t n = std::min(size - done, m_block.size() - m_block_pos);
+        std::memcpy(buffer + done, m_block.data() + m_block_pos, n);
+        m_block_pos += n;
+        done += n;
+    }
+    m_offset += done;
+    return done;
+}
+
+bool GenInputStream::seek(long long offset){
+    if (!m_file || offset < 0) return false;
+    if (m_compression == None) {
+        if (std::fseek(m_file, long(offset), SEEK_SET) != 0) return false;
+        m_offset = offset;
+        return true;
+    }
+    if (offset < m_offset) {
+        stop();
+        std::rewind(m_file);
+        if (!start()) return false;
+        m_offset = 0;
+    }
+    // a compressed stream has to be decoded up to the offset
+    std::vector<char> skipped(block_size);
+    while (m_offset < offset) {
+        const std::size_t n = std::min<long long>(offset - m_offset, skipped.size());
+        if (read(skipped.data(), n) != n) return false;
+    }
+    return true;
+}
+
+bool GenInputStream::start(){
+    stop();
+    m_decoder.reset(create_decoder(m_compression));
+    if (!m_decoder) return false;
+    m_blocks.clear();
+    m_block.clear();
+    m_block_pos = 0;
+    m_end = false;
+    m_stop = false;
+    m_failed = false;
+    m_thread = std::thread(&GenInputStream::run, this);
+    return true;
+}
+
+void GenInputStream::stop(){
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_not_full.notify_all();
+    if (m_thread.joinable()) m_thread.join();
+    m_blocks.clear();
+    m_block.clear();
+    m_block_pos = 0;
+    m_decoder.reset();
+}
+
+bool GenInputStream::nextBlock(){
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_not_empty.wait(lock, [this]{ return !m_blocks.empty() || m_end; });
+    if (m_blocks.empty()) return false;
+    m_block.swap(m_blocks.front());
+    m_blocks.pop_front();
+    m_block_pos = 0;
+    m_not_full.notify_one();
+    return true;
+}
+
+void GenInputStream::run(){
+    std::vector<char> in(block_size);
+    std::size_t in_pos = 0;
+    std::size_t in_end = 0;
+    bool in_eof = false;
+    bool boundary = false;
+    bool done = false;
+    bool failed = false;
+
+    while (!done) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_not_full.wait(lock, [this]{ return m_stop || m_blocks.size() < queue_depth; });
+            if (m_stop) return;
+        }
+
+        std::vector<char> out(block_size);
+        std::size_t out_end = 0;
+        while (out_end < out.size()) {
+            if (in_pos == in_end && !in_eof) {
+                in_pos = 0;
+                in_end = std::fread(in.data(), 1, in.size(), m_file);
+                in_eof = (in_end == 0);
+            }
+            std::size_t consumed = 0;
+            std::size_t produced = 0;
+            if (!m_decoder->decode(in.data() + in_pos, in_end - in_pos, in_eof, consumed,
+                                   out.data() + out_end, out.size() - out_end, produced, boundary)) {
+                failed = done = true;
+                break;
+            }
+            in_pos += consumed;
+            out_end += produced;
+            if (consumed == 0 && produced == 0) {
+                // nothing more to decode: fine at the end of a stream, truncated otherwise
+                failed = !(in_eof && in_pos == in_end && boundary);
+                done = true;
+                break;
+            }
+        }
+        out.resize(out_end);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!out.empty()) m_blocks.push_back(std::move(out));
+        if (done) {
+            m_end = true;
+            m_failed = failed;
+            if (failed) std::cout << "GenInputStream: corrupt or truncated " << compression_name(m_compression) << " file " << m_filename << std::endl;
+        }
+        m_not_empty.notify_one();
+    }
+}
+
+bool GenInputStreamBuf::open(const std::string& filename){
+    m_buffer.resize(1 << 16);
+    setg(m_buffer.data(), m_buffer.data(), m_buffer.data());
+    return m_input.open(filename);
+}
+
+void GenInputStreamBuf::close(){
+    m_input.close();
+    setg(m_buffer.data(), m_buffer.data(), m_buffer.data());
+}
+
+GenInputStreamBuf::int_type GenInputStreamBuf::underflow(){
+    if (gptr() < egptr()) return traits_type::to_int_type(*gptr());
+    const std::size_t n = m_input.read(m_buffer.data(), m_buffer.size());
+    setg(m_buffer.data(), m_buffer.data(), m_buffer.data() + n);
+    if (n == 0) return traits_type::eof();
+    return traits_type::to_int_type(*gptr());
+}
+
+GenInputStreamBuf::pos_type GenInputStreamBuf::seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which){
+    if (!(which & std::ios_base::in)) return pos_type(off_type(-1));
+    // the position of the next character, m_input being ahead by the buffered ones
+    const long long current = m_input.tell() - (egptr() - gptr());
+    if (dir == std::ios_base::cur) return seekpos(pos_type(current + off), which);
+    if (dir == std::ios_base::beg) return seekpos(pos_type(off), which);
+    return pos_type(off_type(-1));
+}
+
+GenInputStreamBuf::pos_type GenInputStreamBuf::seekpos(pos_type pos, std::ios_base::openmode which){
+    if (!(which & std::ios_base::in)) return pos_type(off_type(-1));
+    const long long offset = off_type(pos);
+    const long long current = m_input.tell() - (egptr() - gptr());
+    if (offset == current) return pos;
+    setg(m_buffer.data(), m_buffer.data(), m_buffer.data());
+    if (!m_input.seek(offset)) return pos_type(off_type(-1));
+    return pos;
+}
@@ -0,0 +1,102 @@
+#ifndef GenInputStream_h
+#define GenInputStream_h 1
+
+/*
+ * GenInputStream reads a generator file which may be compressed with
+ * gzip, xz or zstd; the format is found from the magic number of the
+ * file. A compressed file is decompressed on a helper thread into a few
+ * blocks ahead of the reader, a plain file is read directly.
+ *
+ * The decoders are available if the libraries were found at build time
+ * (GENINPUT_WITH_ZLIB, GENINPUT_WITH_LZMA, GENINPUT_WITH_ZSTD).
+ *
+ * GenInputStreamBuf puts it behind a std::istream, for the readers of
+ * libraries taking one (e.g. HepMC::IO_GenEvent).
+ */
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+class GenInputStream {
+    public:
+        enum Compression { None, Gzip, Xz, Zstd };
+
+        // the decoder of a compressed format
+        class Decoder {
+            public:
+                virtual ~Decoder() {}
+                // decode from in to out; progress at the end of a stream or frame sets boundary.
+                // false on corrupt input
+                virtual bool decode(const char* in, std::size_t in_size, bool last, std::size_t& consumed,
+                                    char* out, std::size_t out_size, std::size_t& produced, bool& boundary) = 0;
+        };
+
+        GenInputStream();
+        ~GenInputStream();
+
+        bool open(const std::string& filename);
+        void close();
+        bool isOpen() const;
+        Compression compression() const;
+
+        // read up to size bytes of the (decompressed) file, less at its end
+        std::size_t read(char* buffer, std::size_t size);
+        // continue at an offset of the decompressed file; a compressed file is decompressed
+        // again from its start if the offset is behind
+        bool seek(long long offset);
+        long long tell() const;
+        // true if a compressed file turned out to be corrupt or truncated
+        bool failed() const;
+
+    private:
+        GenInputStream(const GenInputStream&);
+        GenInputStream& operator=(const GenInputStream&);
+
+        // (re)start the helper thread at the beginning of the file
+        bool start();
+        void stop();
+        void run();
+        bool nextBlock();
+
+        std::string m_filename;
+        std::FILE* m_file;
+        Compression m_compression;
+        long long m_offset;
+
+        std::unique_ptr<Decoder> m_decoder;
+        std::thread m_thread;
+        std::mutex m_mutex;
+        std::condition_variable m_not_full;
+        std::condition_variable m_not_empty;
+        std::deque<std::vector<char> > m_blocks;
+        bool m_end;
+        bool m_stop;
+        bool m_failed;
+        std::vector<char> m_block;
+        std::size_t m_block_pos;
+};
+
+class GenInputStreamBuf: public std::streambuf {
+    public:
+        bool open(const std::string& filename);
+        void close();
+
+    protected:
+        int_type underflow() override;
+        pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override;
+        pos_type seekpos(pos_type pos, std::ios_base::openmode which) override;
+
+    private:
+        GenInputStream m_input;
+        std::vector<char> m_buffer;
+};
+
+#endif
@@ -0,0 +1,64 @@
+#include "GenLCIOConverter.h"
+
+#include "EVENT/LCCollection.h"
+#include "EVENT/MCParticle.h"
+
+#include <algorithm>
+#include <iostream>
+#include <unordered_map>
+
+namespace MyHepMC {
+
+void convertLCIO(const EVENT::LCCollection* col, GenEventRecord& record, bool daughters_from_parents){
+    const int n_mc = col->getNumberOfElements();
+    record.clear();
+    record.reserve(n_mc);
+
+    std::vector<const EVENT::MCParticle*> particles(n_mc);
+    std::unordered_map<const EVENT::MCParticle*, int> index;
+    index.reserve(n_mc);
+    for (int i=0; i < n_mc; i++){
+        const EVENT::MCParticle* mc = dynamic_cast<const EVENT::MCParticle*>(col->getElementAt(i));
+        particles[i] = mc;
+        index[mc] = i;
+
+        GenParticleRecord& mcp = record.addParticle();
+        mcp.pdg                = mc->getPDG();
+        mcp.generatorStatus    = mc->getGeneratorStatus();
+        mcp.simulatorStatus    = mc->getSimulatorStatus();
+        mcp.charge             = mc->getCharge();
+        mcp.time               = mc->getTime();
+        mcp.mass               = mc->getMass();
+        mcp.vertex             = edm4hep::Vector3d(mc->getVertex());
+        mcp.endpoint           = edm4hep::Vector3d(mc->getEndpoint());
+        mcp.momentum           = edm4hep::Vector3f(float(mc->getMomentum()[0]), float(mc->getMomentum()[1]), float(mc->getMomentum()[2]) );
+        mcp.momentumAtEndpoint = edm4hep::Vector3f(float(mc->getMomentumAtEndpoint()[0]), float(mc->getMomentumAtEndpoint()[1]), float(mc->getMomentumAtEndpoint()[2]) );
+        mcp.spin               = edm4hep::Vector3f(mc->getSpin());
+        mcp.colorFlow          = edm4hep::Vector2i(mc->getColorFlow());
+    }
+
+    // second loop for setting parents and daughters
+    for (int i=0; i < n_mc; i++){
+        const EVENT::MCParticleVec& mc_parents = particles[i]->getParents();
+        for (unsigned int j=0; j < mc_parents.size(); j++){
+            std::unordered_map<const EVENT::MCParticle*, int>::const_iterator it = index.find(mc_parents[j]);
+            if (it == index.end()) { std::cout << "GenLCIOConverter: parent not in the collection" << std::endl; continue; }
+            if (daughters_from_parents) {
+                // a parent given twice is linked once
+                if (std::find(mc_parents.begin(), mc_parents.begin()+j, mc_parents[j]) != mc_parents.begin()+j) continue;
+                record.addDaughter(it->second, i);
+            }
+            record.addParent(i, it->second);
+        }
+        if (daughters_from_parents) continue;
+
+        const EVENT::MCParticleVec& mc_daughters = particles[i]->getDaughters();
+        for (unsigned int j=0; j < mc_daughters.size(); j++){
+            std::unordered_map<const EVENT::MCParticle*, int>::const_iterator it = index.find(mc_daughters[j]);
+            if (it == index.end()) { std::cout << "GenLCIOConverter: daughter not in the collection" << std::endl; continue; }
+            record.addDaughter(i, it->second);
+        }
+    }
+}
+
+}
@@ -0,0 +1,23 @@
+#ifndef GenLCIOConverter_h
+#define GenLCIOConverter_h 1
+
+/*
+ * Conversion of an LCIO MCParticle collection into a GenEventRecord in one
+ * pass. The relations are resolved to the index of the particle in the
+ * collection, so no intermediate copy or id lookup is needed.
+ */
+
+#include "GenEventRecord.h"
+
+namespace EVENT {
+    class LCCollection;
+}
+
+namespace MyHepMC {
+
+// With daughters_from_parents the daughters are the inverse of the parent
+// links, in the order of the particles, and the daughter lists are ignored.
+void convertLCIO(const EVENT::LCCollection* col, GenEventRecord& record, bool daughters_from_parents=false);
+
+}
+#endif
@@ -0,0 +1,96 @@
+#include "GenOverlayTool.h"
+
+#include "GaudiKernel/IToolSvc.h"
+
+#include "CLHEP/Random/RandFlat.h"
+#include "CLHEP/Random/RandPoisson.h"
+
+#include "edm4hep/MCParticleCollection.h"
+
+DECLARE_COMPONENT(GenOverlayTool)
+
+StatusCode
+GenOverlayTool::initialize() {
+    StatusCode sc;
+    if (m_source_name.value().empty()) {
+        error() << "Please specify the Source tool of the background events" << endmsg;
+        return StatusCode::FAILURE;
+    }
+    if (m_pool_size.value() == 0 || m_mean.value() < 0 || m_bx_first.value() > m_bx_last.value()) {
+        error() << "Invalid PoolSize, MeanPerBunchCrossing or bunch crossing window." << endmsg;
+        return StatusCode::FAILURE;
+    }
+    if (toolSvc()->retrieveTool(m_source_name.value(), m_source).isFailure()) {
+        error() << "Failed to retrieve the Source tool " << m_source_name.value() << endmsg;
+        return StatusCode::FAILURE;
+    }
+
+    if (not configure_gentool()) {
+        error() << "failed to initialize." << endmsg;
+        return StatusCode::FAILURE;
+    }
+
+    return sc;
+}
+
+StatusCode
+GenOverlayTool::finalize() {
+    StatusCode sc;
+    if (m_n_events) {
+        info() << m_n_overlaid << " background events overlaid on " << m_n_events
+               << " events, " << double(m_n_overlaid)/m_n_events << " per event" << endmsg;
+    }
+    m_pool.clear();
+    if (m_source) {
+        toolSvc()->releaseTool(m_source).ignore();
+        m_source = nullptr;
+    }
+    return sc;
+}
+
+bool
+GenOverlayTool::mutate(MyHepMC::GenEvent& event) {
+
+    for (int bx = m_bx_first.value(); bx <= m_bx_last.value(); ++bx) {
+        const float time = bx * m_bx_spacing.value();
+        const long n = CLHEP::RandPoisson::shoot(m_mean.value());
+        for (long i = 0; i < n; ++i) {
+            const MyHepMC::GenEventRecord& bkg = m_pool[CLHEP::RandFlat::shootInt(long(m_pool.size()))];
+            bkg.fillEvent(event, time);
+        }
+        m_n_overlaid += n;
+    }
+    ++m_n_events;
+
+    return true;
+}
+
+bool
+GenOverlayTool::finish() {
+    return true;
+}
+
+bool
+GenOverlayTool::configure_gentool() {
+
+    // the source fills a collection outside of the event store, which is kept as a record
+    m_pool.clear();
+    m_pool.reserve(m_pool_size.value());
+    while (m_pool.size() < m_pool_size.value()) {
+        edm4hep::MCParticleCollection collection;
+        MyHepMC::GenEvent bkg(collection);
+        if (!m_source->mutate(bkg)) break;
+        m_pool.emplace_back();
+        m_pool.back().readCollection(collection);
+    }
+    if (m_pool.empty()) {
+        error() << "No background event read from " << m_source_name.value() << endmsg;
+        return false;
+    }
+    if (m_pool.size() < m_pool_size.value()) {
+        warning() << "Only " << m_pool.size() << " background events in " << m_source_name.value() << endmsg;
+    }
+    info() << m_pool.size() << " background events in the pool" << endmsg;
+
+    return true;
+}
@@ -0,0 +1,58 @@
+#ifndef GenOverlayTool_h
+#define GenOverlayTool_h
+
+/*
+ * Description:
+ *   Overlay beam induced background on the generated event.
+ *   A pool of background events is read once at initialize from another
+ *   IGenTool (e.g. a HepMCRdr or StdHepRdr on the background file), and kept
+ *   in memory. For each bunch crossing of the window, a Poisson number of
+ *   events drawn from the pool is appended to the event, with their time
+ *   shifted by the time of the bunch crossing.
+ *
+ *   The source tool should not be in the GenTools of GenAlgo.
+ */
+
+#include <GaudiKernel/AlgTool.h>
+#include <GaudiKernel/Property.h>
+#include "IGenTool.h"
+#include "GenEventRecord.h"
+
+#include <string>
+#include <vector>
+
+class GenOverlayTool: public extends<AlgTool, IGenTool> {
+public:
+    using extends::extends;
+
+    // Overriding initialize and finalize
+    StatusCode initialize() override;
+    StatusCode finalize() override;
+
+    // IGenTool
+    bool mutate(MyHepMC::GenEvent& event) override;
+    bool finish() override;
+    bool configure_gentool() override;
+
+private:
+    IGenTool* m_source{nullptr};
+    std::vector<MyHepMC::GenEventRecord> m_pool;
+    long m_n_events{0};
+    long m_n_overlaid{0};
+
+    // type/name of the public IGenTool reading the background events
+    Gaudi::Property<std::string> m_source_name{this, "Source"};
+    // number of background events kept in memory
+    Gaudi::Property<unsigned int> m_pool_size{this, "PoolSize", 100};
+    // mean number of background events per bunch crossing
+    Gaudi::Property<double> m_mean{this, "MeanPerBunchCrossing", 1.};
+    // first and last bunch crossing overlaid, relative to the one of the event
+    Gaudi::Property<int> m_bx_first{this, "FirstBunchCrossing", 0};
+    Gaudi::Property<int> m_bx_last{this, "LastBunchCrossing", 0};
+    // time between two bunch crossings, ns
+    Gaudi::Property<double> m_bx_spacing{this, "BunchSpacing", 0.};
+
+};
+
+
+#endif
@@ -0,0 +1,80 @@
+#include "GenReadAhead.h"
+
+GenReadAhead::GenReadAhead()
+    : m_depth(0), m_end(false), m_stop(false){
+}
+
+GenReadAhead::~GenReadAhead(){
+    stop();
+}
+
+void GenReadAhead::start(const ReadFunction& read, unsigned int depth){
+    stop();
+    m_read  = read;
+    m_depth = depth;
+    m_end   = false;
+    m_stop  = false;
+    m_error = nullptr;
+}
+
+bool GenReadAhead::next(MyHepMC::GenEventRecord& record){
+    if (!m_read) return false;
+    if (m_depth == 0) return m_read(record);
+    if (!m_thread.joinable()) m_thread = std::thread(&GenReadAhead::run, this);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_not_empty.wait(lock, [this]{ return !m_queue.empty() || m_end; });
+    if (m_queue.empty()) {
+        if (m_error) {
+            std::exception_ptr error = m_error;
+            m_error = nullptr;
+            std::rethrow_exception(error);
+        }
+        return false;
+    }
+    record = std::move(m_queue.front());
+    m_queue.pop_front();
+    m_not_full.notify_one();
+    return true;
+}
+
+void GenReadAhead::stop(){
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_not_full.notify_all();
+    if (m_thread.joinable()) m_thread.join();
+    m_queue.clear();
+    m_read = ReadFunction();
+}
+
+void GenReadAhead::run(){
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_not_full.wait(lock, [this]{ return m_stop || m_queue.size() < m_depth; });
+            if (m_stop) return;
+        }
+
+        MyHepMC::GenEventRecord record;
+        bool ok = false;
+        std::exception_ptr error;
+        try {
+            ok = m_read(record);
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!ok) {
+            m_error = error;
+            m_end = true;
+            m_not_empty.notify_all();
+            return;
+        }
+        m_queue.push_back(std::move(record));
+        m_not_empty.notify_one();
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef GenReadAhead_h
+#define GenReadAhead_h 1
+
+/*
+ * GenReadAhead decodes the next events of a reader on a background thread
+ * into a bounded queue, so that file I/O and parsing overlap with the rest
+ * of the event loop. With a depth of 0 there is no thread, and next()
+ * simply calls the read function. The thread is started by the first
+ * next(), so the reader may still be positioned after start().
+ *
+ * The read function runs on the background thread only, and must not touch
+ * the event store. An exception thrown by it is rethrown by next().
+ */
+
+#include "GenEventRecord.h"
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+class GenReadAhead {
+    public:
+        typedef std::function<bool(MyHepMC::GenEventRecord&)> ReadFunction;
+
+        GenReadAhead();
+        ~GenReadAhead();
+
+        void start(const ReadFunction& read, unsigned int depth);
+        // take the next decoded event, false at the end of the input
+        bool next(MyHepMC::GenEventRecord& record);
+        // stop the thread, pending events are dropped
+        void stop();
+
+    private:
+        GenReadAhead(const GenReadAhead&);
+        GenReadAhead& operator=(const GenReadAhead&);
+
+        void run();
+
+        ReadFunction m_read;
+        unsigned int m_depth;
+        std::thread m_thread;
+        std::mutex m_mutex;
+        std::condition_variable m_not_full;
+        std::condition_variable m_not_empty;
+        std::deque<MyHepMC::GenEventRecord> m_queue;
+        bool m_end;
+        bool m_stop;
+        std::exception_ptr m_error;
+};
+
+#endif
@@ -14,6 +14,11 @@ class GenReader: virtual public IGenTool{
         virtual bool mutate(MyHepMC::GenEvent& event)=0;    
         virtual bool finish()=0;
         virtual bool isEnd()=0;
+        // number of events in the input, -1 if it is not known
+        virtual long numEvents()=0;
+        // read only the events [first, first+count), count -1 for all the events from first on;
+        // possible before the first event is read only
+        virtual bool setEventRange(long first, long count)=0;
 };
 
 #endif
@@ -1,44 +1,142 @@
 #include "GenWriter.h"
 #include "GenEvent.h"
+#include "GenEventRecord.h"
 
 #include "podio/EventStore.h" //podio
 #include "podio/ROOTWriter.h"
 
+#include "edm4hep/MCParticleCollection.h" //edm4hep
+#include "edm4hep/EventHeaderCollection.h"
 
-#include "plcio/MCParticleCollection.h"//plico
-#include "plcio/EventHeaderCollection.h"
+#include "GaudiKernel/GaudiException.h"
 
+#include "TROOT.h"
 
-GenWriter::GenWriter(string name){
-    m_output_name = name;
-    store  = new podio::EventStore();
-    writer = new podio::ROOTWriter(m_output_name, store);
-    ehc   =  &store->create<plcio::EventHeaderCollection>("EvtHeaders");
-    mcc   =  &store->create<plcio::MCParticleCollection>("MCParticles");
+#include <iostream>
 
-    writer->registerForWrite("EvtHeaders");
-    writer->registerForWrite("MCParticles");
-}
+DECLARE_COMPONENT(GenWriter)
 
 GenWriter::~GenWriter(){
+    finish();
 }
 
 bool GenWriter::mutate(MyHepMC::GenEvent& event){
-    std::cout << "write mc info for event "<< event.getID() << ", mc size ="<< event.m_mc_vec.size() <<  std::endl;
-    mcc=&event.m_mc_vec;
-    auto header = plcio::EventHeader(event.getID(), event.getRun(), event.getTime(), event.getName());
-    ehc->push_back(header);
-    writer->writeEvent();
-    store->clearCollections();
+    QueuedEvent queued;
+    queued.id   = event.getID();
+    queued.run  = event.getRun();
+    queued.time = event.getTime();
+    queued.record.readCollection(event.m_mc_vec);
+    if (msgLevel(MSG::DEBUG)) debug() << "write mc info for event " << queued.id << ", mc size =" << event.m_mc_vec.size() << endmsg;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_not_full.wait(lock, [this]{ return m_queue.size() < m_queue_size.value() || m_failed; });
+    // false would be taken as the end of the input, a failed output has to fail the job
+    if (m_failed) throw GaudiException("The writer of " + m_output_name.value() + " failed", name(), StatusCode::FAILURE);
+    m_queue.push_back(std::move(queued));
+    m_not_empty.notify_one();
     return true;
 }
 
-bool GenWriter::configure(){
-return true;
+void GenWriter::run(){
+    try {
+        // all the ROOT calls of the output file are made on this thread
+        podio::EventStore store;
+        podio::ROOTWriter writer(m_output_name.value(), &store);
+
+        auto& headers = store.create<edm4hep::EventHeaderCollection>("EventHeader");
+        auto& mcps    = store.create<edm4hep::MCParticleCollection>("MCParticle");
+        writer.registerForWrite("EventHeader");
+        writer.registerForWrite("MCParticle");
+
+        for (;;) {
+            QueuedEvent queued;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_not_empty.wait(lock, [this]{ return !m_queue.empty() || m_done; });
+                if (m_queue.empty()) break;
+                queued = std::move(m_queue.front());
+                m_queue.pop_front();
+            }
+            m_not_full.notify_one();
+
+            auto header = headers.create();
+            header.setEventNumber(queued.id);
+            header.setRunNumber(queued.run);
+            header.setTimeStamp(queued.time);
+            MyHepMC::GenEvent event(mcps);
+            queued.record.fillEvent(event);
+            writer.writeEvent();
+            store.clearCollections();
+            m_written++;
+        }
+        writer.finish();
+    }
+    catch (...) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_error = std::current_exception();
+        m_failed = true;
+        m_queue.clear();
+        m_not_full.notify_all();
+    }
+}
+
+bool GenWriter::configure_gentool(){
+    m_done = false;
+    m_failed = false;
+    m_error = nullptr;
+    m_written = 0;
+    m_thread = std::thread(&GenWriter::run, this);
+    return true;
 }
 
 bool GenWriter::finish(){
-    writer->finish();
-    std::cout<<"Saved root "<<m_output_name<<std::endl;
+    if (!m_thread.joinable()) return true;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_done = true;
+    }
+    m_not_empty.notify_all();
+    m_thread.join();
+    if (m_error) {
+        try {
+            std::rethrow_exception(m_error);
+        }
+        catch (const std::exception& e) {
+            std::cout << "GenWriter: failed to write " << m_output_name.value() << ": " << e.what() << std::endl;
+        }
+        catch (...) {
+            std::cout << "GenWriter: failed to write " << m_output_name.value() << std::endl;
+        }
+        return false;
+    }
+    std::cout << "Saved root " << m_output_name.value() << " with " << m_written << " events" << std::endl;
     return true;
 }
+
+StatusCode
+GenWriter::initialize() {
+    StatusCode sc;
+    if (m_queue_size.value() == 0) {
+        error() << "QueueSize should be at least 1." << endmsg;
+        return StatusCode::FAILURE;
+    }
+    // the output is written on another thread than the one of the event loop,
+    // ROOT has to know it before the writer creates any of its objects
+    ROOT::EnableThreadSafety();
+    if (not configure_gentool()) {
+        error() << "failed to initialize." << endmsg;
+        return StatusCode::FAILURE;
+    }
+
+    return sc;
+}
+
+StatusCode
+GenWriter::finalize() {
+    StatusCode sc;
+    if (not finish()) {
+        error() << "Failed to finalize." << endmsg;
+        return StatusCode::FAILURE;
+    }
+    return sc;
+}
@@ -1,34 +1,64 @@
 #ifndef GenWriter_h
 #define GenWriter_h 1
 
+/*
+ * GenWriter writes the generated events to an edm4hep ROOT file, with the
+ * collections "EventHeader" and "MCParticle". mutate only copies the event
+ * into a bounded queue; a writer thread owns the podio store and writer, so
+ * the event loop does not wait for the file unless the queue is full.
+ * A failure of the writer thread makes the next mutate throw a GaudiException.
+ */
+
+#include "GaudiKernel/AlgTool.h"
+
 #include "GenEvent.h"
+#include "GenEventRecord.h"
 #include "IGenTool.h"
 
-#include "podio/EventStore.h" //podio
-#include "podio/ROOTWriter.h"
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
 
+class GenWriter: public extends<AlgTool, IGenTool> {
 
-#include "plcio/MCParticleCollection.h"//plico
-#include "plcio/EventHeaderCollection.h"
+    public:
+        using extends::extends;
+        ~GenWriter();
 
+        StatusCode initialize() override;
+        StatusCode finalize() override;
 
+        bool configure_gentool() override;
+        bool mutate(MyHepMC::GenEvent& event) override;
+        bool finish() override;
+    private:
+        struct QueuedEvent {
+            long id;
+            long run;
+            long time;
+            MyHepMC::GenEventRecord record;
+        };
 
-using namespace std;
+        // the writer thread
+        void run();
 
-class GenWriter: public IGenTool{
+        std::thread m_thread;
+        std::mutex m_mutex;
+        std::condition_variable m_not_full;
+        std::condition_variable m_not_empty;
+        std::deque<QueuedEvent> m_queue;
+        bool m_done{false};
+        bool m_failed{false};
+        std::exception_ptr m_error;
+        long m_written{0};
 
-    public:
-        GenWriter(string name);
-        ~GenWriter();
-        bool configure() override;               
-        bool mutate(MyHepMC::GenEvent& event) override;    
-        bool finish() override;
-    private:
-        string m_output_name;
-        podio::EventStore* store ;
-        podio::ROOTWriter* writer;
-        plcio::EventHeaderCollection*  ehc  ;
-        plcio::MCParticleCollection*   mcc  ;
+        // output file name
+        Gaudi::Property<std::string> m_output_name{this, "Output", "gen.root"};
+        // number of events waiting for the writer before mutate blocks
+        Gaudi::Property<unsigned int> m_queue_size{this, "QueueSize", 16};
 
 };
 
@@ -20,6 +20,11 @@ GtGunTool::initialize() {
         error() << "Mismatched energies and particles." << endmsg;
         return StatusCode::FAILURE;
     }
+    if (m_energymaxs.value().size()
+        && m_energymaxs.value().size() != m_particles.value().size()) {
+        error() << "Mismatched energymaxs and particles." << endmsg;
+        return StatusCode::FAILURE;
+    }
     
     // others should be empty or specify
     if (m_thetamins.value().size()
@@ -44,6 +49,11 @@ GtGunTool::initialize() {
         return StatusCode::FAILURE;
     }
 
+    if (not configure_gentool()) {
+        error() << "failed to initialize." << endmsg;
+        return StatusCode::FAILURE;
+    }
+
     return sc;
 }
 
@@ -56,39 +66,27 @@ GtGunTool::finalize() {
 bool
 GtGunTool::mutate(MyHepMC::GenEvent& event) {
 
-    TDatabasePDG* db_pdg = TDatabasePDG::Instance();
-
     // The default unit here is GeV.
     // but we don't add the unit, because in geant4 it is multiplied.
 
-    for (int i = 0; i < m_particles.value().size(); ++i) {
-        const std::string& particle_name = m_particles.value()[i];
-        int pdgcode = 0;
-        double mass = 0;
+    // energy, theta and phi of all the particles in one call
+    CLHEP::RandFlat::shootArray(m_random.size(), m_random.data());
 
-        TParticlePDG* particle = db_pdg->GetParticle(particle_name.c_str());
-        if (particle) {
-            pdgcode = particle->PdgCode();
-            mass = particle->Mass(); // GeV
-        } else {
-            // guess it is pdg code
-            pdgcode = atol(particle_name.c_str());
-            if (!pdgcode) {
-                error() << "Unsupported particle name/pdgcode " << particle_name << endmsg;
-                return false;
-            }
-        }
+    const bool debug_on = msgLevel(MSG::DEBUG);
+    for (std::size_t i = 0; i < m_guns.size(); ++i) {
+        const GunParticle& gun = m_guns[i];
+        const double* u = &m_random[3*i];
 
-        double energy = m_energymins.value()[i]==m_energymaxs.value()[i] ? m_energymins.value()[i] : CLHEP::RandFlat::shoot(m_energymins.value()[i], m_energymaxs.value()[i]);
+        double energy = gun.energy_min + (gun.energy_max - gun.energy_min) * u[0];
 
         // create the MC particle
         edm4hep::MCParticle mcp = event.m_mc_vec.create();
-        mcp.setPDG(pdgcode);
+        mcp.setPDG(gun.pdg);
         mcp.setGeneratorStatus(1);
         mcp.setSimulatorStatus(1);
-        // mcp.setCharge();
+        mcp.setCharge(gun.charge);
         mcp.setTime(0.0);
-        mcp.setMass(mass);
+        mcp.setMass(gun.mass);
         // mcp.setVertex(); 
         // mcp.setEndpoint();
 
@@ -97,15 +95,17 @@ GtGunTool::mutate(MyHepMC::GenEvent& event) {
         
         // direction
         // by default, randomize the direction
-        double theta = m_thetamins.value()[i]==m_thetamaxs.value()[i] ? m_thetamins.value()[i] : CLHEP::RandFlat::shoot(m_thetamins.value()[i], m_thetamaxs.value()[i]);
-        double phi =   m_phimins  .value()[i]==m_phimaxs  .value()[i] ? m_phimins  .value()[i] : CLHEP::RandFlat::shoot(m_phimins  .value()[i], m_phimaxs  .value()[i]);
-        double costheta = cos(theta*acos(-1)/180);
-        double phi_  = phi*acos(-1)/180;
-        double sintheta = sqrt(1.-costheta*costheta);
-        double px = p*sintheta*cos(phi_);
-        double py = p*sintheta*sin(phi_);
+        double theta = gun.theta_min + (gun.theta_max - gun.theta_min) * u[1];
+        double phi   = gun.phi_min   + (gun.phi_max   - gun.phi_min  ) * u[2];
+        double costheta = cos(theta);
+        double sintheta = sin(theta);
+        double px = p*sintheta*cos(phi);
+        double py = p*sintheta*sin(phi);
         double pz = p*costheta;
-        std::cout<<"GenGt p="<<p<<", px="<<px<<",py="<<py<<",pz="<<pz<<",theta="<<theta<<",phi="<<phi<<std::endl;
+        if (debug_on) {
+            debug() << "GenGt p=" << p << ", px=" << px << ",py=" << py << ",pz=" << pz
+                    << ",theta=" << theta/CLHEP::deg << ",phi=" << phi/CLHEP::deg << endmsg;
+        }
         mcp.setMomentum(edm4hep::Vector3f(px,py,pz));
         // mcp.setMomentumAtEndpoint();
         // mcp.setSpin();
@@ -126,6 +126,46 @@ GtGunTool::finish() {
 bool
 GtGunTool::configure_gentool() {
 
+    TDatabasePDG* db_pdg = TDatabasePDG::Instance();
+
+    m_guns.clear();
+    for (std::size_t i = 0; i < m_particles.value().size(); ++i) {
+        const std::string& particle_name = m_particles.value()[i];
+        GunParticle gun;
+
+        TParticlePDG* particle = db_pdg->GetParticle(particle_name.c_str());
+        if (!particle) {
+            // guess it is pdg code
+            gun.pdg = atol(particle_name.c_str());
+            if (!gun.pdg) {
+                error() << "Unsupported particle name/pdgcode " << particle_name << endmsg;
+                return false;
+            }
+            particle = db_pdg->GetParticle(gun.pdg);
+        }
+        if (particle) {
+            gun.pdg = particle->PdgCode();
+            gun.mass = particle->Mass(); // GeV
+            gun.charge = particle->Charge()/3.; // in e, Charge() is in units of |e|/3
+        } else {
+            gun.mass = 0;
+            gun.charge = 0;
+        }
+
+        // a fixed value is a range of zero width, a missing direction range is the full solid angle
+        gun.energy_min = m_energymins.value()[i];
+        gun.energy_max = m_energymaxs.value().size() ? m_energymaxs.value()[i] : gun.energy_min;
+        gun.theta_min = (m_thetamins.value().size() ? m_thetamins.value()[i] : 0.) * CLHEP::deg;
+        gun.theta_max = (m_thetamaxs.value().size() ? m_thetamaxs.value()[i] : 180.) * CLHEP::deg;
+        gun.phi_min = (m_phimins.value().size() ? m_phimins.value()[i] : 0.) * CLHEP::deg;
+        gun.phi_max = (m_phimaxs.value().size() ? m_phimaxs.value()[i] : 360.) * CLHEP::deg;
+
+        info() << "Particle " << particle_name << ": pdg " << gun.pdg << ", mass " << gun.mass
+               << " GeV, charge " << gun.charge << endmsg;
+        m_guns.push_back(gun);
+    }
+    m_random.resize(3*m_guns.size());
+
     return true;
 }
 
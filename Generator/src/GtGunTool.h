@@ -15,6 +15,7 @@
 #include <GaudiKernel/Property.h>
 #include "IGenTool.h"
 
+#include <string>
 #include <vector>
 
 class GtGunTool: public extends<AlgTool, IGenTool> {
@@ -31,6 +32,19 @@ public:
     bool configure_gentool() override;
 
 private:
+    // one gun particle, resolved from the properties in configure_gentool
+    struct GunParticle {
+        int pdg;
+        double mass;     // GeV
+        float charge;    // e
+        double energy_min, energy_max;
+        double theta_min, theta_max;  // rad
+        double phi_min, phi_max;      // rad
+    };
+
+    std::vector<GunParticle> m_guns;
+    // the uniform randoms of one event, three per particle
+    std::vector<double> m_random;
 
     Gaudi::Property<std::vector<std::string>> m_particles{this, "Particles"};
 
@@ -1,5 +1,6 @@
 #include "HepMCRdr.h"
 #include "GenEvent.h"
+#include "GenEventRecord.h"
 
 #include "HepMC/IO_GenEvent.h"//HepMC
 #include "HepMC/GenEvent.h"
@@ -17,6 +18,8 @@
 #include <iostream>
 #include <vector>
 #include <fstream>
+#include <unordered_map>
+#include <functional>
 
 
 using namespace edm4hep;
@@ -25,69 +28,98 @@ using namespace std;
 DECLARE_COMPONENT(HepMCRdr)
 
 HepMCRdr::~HepMCRdr(){
+m_read_ahead.stop();
 delete ascii_in;
 }
 
 bool HepMCRdr::mutate(MyHepMC::GenEvent& event){
 
+    if(m_last_event >= 0 && m_processed_event >= m_last_event) return false;
+    MyHepMC::GenEventRecord record;
+    if(!m_read_ahead.next(record)) return false;
+    m_processed_event ++;
+    record.fillEvent(event);
+    event.SetEventHeader( m_processed_event, -99, 9999, "Generator");
+    //std::cout<<"end event :"<< m_processed_event <<std::endl;
+    return true;
+}
+
+bool HepMCRdr::readRecord(MyHepMC::GenEventRecord& record){
+
     HepMC::GenEvent* evt = ascii_in->read_next_event();
     if(!evt) return false;
-    m_processed_event ++;
     int n_mc = evt->particles_size();
-    //std::cout<<"Read event :"<< m_processed_event <<", mc size :"<< n_mc <<std::endl;
-    std::map<int, int> pmcid_lmcid;
-    int index = 0 ;
+    //std::cout<<"Read event, mc size :"<< n_mc <<std::endl;
+    record.clear();
+    record.reserve(n_mc);
+    // barcodes of the particles are dense in practice, so they are indexed by offset to the smallest one
+    int barcode_min = 0;
+    int barcode_max = -1;
     for ( HepMC::GenEvent::particle_iterator p = evt->particles_begin(); p != evt->particles_end(); ++p ) {
-        //std::cout<<"start mc "<<index<<std::endl;
-        edm4hep::MCParticle mcp = event.m_mc_vec.create();
-        pmcid_lmcid.insert(std::pair<int, int>((*p)->barcode(),index));
-        index++;
-        //std::cout<<"map<id,i>:"<<mc->id()<<","<< i <<std::endl;
+        const int barcode = (*p)->barcode();
+        if (barcode_max < barcode_min) barcode_min = barcode_max = barcode;
+        else if (barcode < barcode_min) barcode_min = barcode;
+        else if (barcode > barcode_max) barcode_max = barcode;
+    }
+    const bool dense = (barcode_max - barcode_min) < 4 * n_mc + 1024;
+    std::vector<int> barcode_index;
+    std::unordered_map<int, int> barcode_map;
+    if (dense) barcode_index.assign(barcode_max - barcode_min + 1, -1);
+    else barcode_map.reserve(n_mc);
+
+    std::vector<const HepMC::GenParticle*> particles;
+    particles.reserve(n_mc);
+    for ( HepMC::GenEvent::particle_iterator p = evt->particles_begin(); p != evt->particles_end(); ++p ) {
+        //std::cout<<"start mc "<<particles.size()<<std::endl;
+        MyHepMC::GenParticleRecord& mcp = record.addParticle();
+        if (dense) barcode_index[(*p)->barcode() - barcode_min] = particles.size();
+        else barcode_map[(*p)->barcode()] = particles.size();
+        particles.push_back(*p);
                                  
-        mcp.setPDG                ((*p)->pdg_id());  
-        mcp.setGeneratorStatus    ((*p)->status());
-        mcp.setSimulatorStatus    (999);
-        mcp.setCharge             (999);
-        mcp.setTime               (999);
-        mcp.setMass               ((*p)->generated_mass());
+        mcp.pdg                = (*p)->pdg_id();
+        mcp.generatorStatus    = (*p)->status();
+        mcp.simulatorStatus    = 999;
+        mcp.charge             = 999;
+        mcp.time               = 999;
+        mcp.mass               = (*p)->generated_mass();
         if ( (*p)->production_vertex() ){
-            HepMC::GenVertex* vertex_pro =  (*p)->production_vertex();
+            const HepMC::GenVertex* vertex_pro =  (*p)->production_vertex();
             double three[3] = {vertex_pro->point3d().x(), vertex_pro->point3d().y(), vertex_pro->point3d().z()};
-            mcp.setVertex             (edm4hep::Vector3d (three)); 
+            mcp.vertex             = edm4hep::Vector3d (three);
         }
-        else mcp.setVertex(edm4hep::Vector3d()); 
+        else mcp.vertex = edm4hep::Vector3d();
         if ( (*p)->end_vertex() ){
-            HepMC::GenVertex* vertex_end =  (*p)->end_vertex();
+            const HepMC::GenVertex* vertex_end =  (*p)->end_vertex();
             double three[3] = {vertex_end->point3d().x(), vertex_end->point3d().y(), vertex_end->point3d().z()};
-            mcp.setEndpoint           (edm4hep::Vector3d (three));
+            mcp.endpoint           = edm4hep::Vector3d (three);
         } 
-        else mcp.setEndpoint (edm4hep::Vector3d());
-        mcp.setMomentum           (edm4hep::Vector3f(float((*p)->momentum().px()), float((*p)->momentum().py()), float((*p)->momentum().pz()) ));
-        mcp.setMomentumAtEndpoint (edm4hep::Vector3f(float((*p)->momentum().px()), float((*p)->momentum().py()), float((*p)->momentum().pz()) ));
+        else mcp.endpoint = edm4hep::Vector3d();
+        mcp.momentum           = edm4hep::Vector3f(float((*p)->momentum().px()), float((*p)->momentum().py()), float((*p)->momentum().pz()) );
+        mcp.momentumAtEndpoint = edm4hep::Vector3f(float((*p)->momentum().px()), float((*p)->momentum().py()), float((*p)->momentum().pz()) );
         const HepMC::Polarization & polar = (*p)->polarization();
-        mcp.setSpin               (edm4hep::Vector3f(polar.normal3d().x(), polar.normal3d().y(), polar.normal3d().z()) );
+        mcp.spin               = edm4hep::Vector3f(polar.normal3d().x(), polar.normal3d().y(), polar.normal3d().z());
         int two[2] = {1, (*p)->flow(1)};
-        mcp.setColorFlow          (edm4hep::Vector2i (two) );
+        mcp.colorFlow          = edm4hep::Vector2i (two);
     }
-    // second loop for setting parents and daughters
-    index = 0 ;
-    for ( HepMC::GenEvent::particle_iterator p = evt->particles_begin(); p != evt->particles_end(); ++p ) {
-        edm4hep::MCParticle pmc = event.m_mc_vec.at(index);
-        index++;
-        if ( (*p)->production_vertex() ) {
-            for ( HepMC::GenVertex::particle_iterator mother = (*p)->production_vertex()-> particles_begin(HepMC::parents); mother != (*p)->production_vertex()-> particles_end(HepMC::parents); ++mother ) {
-                pmc.addToParents( event.m_mc_vec.at( pmcid_lmcid.at((*mother)->barcode()) ) );
+    // second loop for setting parents and daughters, one generation only:
+    // the incoming particles of the production vertex and the outgoing ones of the end vertex
+    for ( int i = 0; i < n_mc; i++ ) {
+        const HepMC::GenVertex* vertex_pro = particles[i]->production_vertex();
+        if ( vertex_pro ) {
+            for ( HepMC::GenVertex::particles_in_const_iterator mother = vertex_pro->particles_in_const_begin(); mother != vertex_pro->particles_in_const_end(); ++mother ) {
+                const int barcode = (*mother)->barcode();
+                record.addParent( i, dense ? barcode_index[barcode - barcode_min] : barcode_map.at(barcode) );
             }
         }
-        if ( (*p)->end_vertex() ) {
-            for ( HepMC::GenVertex::particle_iterator des =(*p)->end_vertex()-> particles_begin(HepMC::descendants); des != (*p)->end_vertex()-> particles_end(HepMC::descendants); ++des ) {
-                pmc.addToDaughters( event.m_mc_vec.at( pmcid_lmcid.at((*des)->barcode()) ) );
-                }
+        const HepMC::GenVertex* vertex_end = particles[i]->end_vertex();
+        if ( vertex_end ) {
+            for ( HepMC::GenVertex::particles_out_const_iterator des = vertex_end->particles_out_const_begin(); des != vertex_end->particles_out_const_end(); ++des ) {
+                const int barcode = (*des)->barcode();
+                record.addDaughter( i, dense ? barcode_index[barcode - barcode_min] : barcode_map.at(barcode) );
+            }
         }   
     }
     
-    event.SetEventHeader( m_processed_event, -99, 9999, "Generator");
-    //std::cout<<"end event :"<< m_processed_event <<std::endl;
     delete evt;
     return true;
 }
@@ -96,14 +128,45 @@ bool HepMCRdr::isEnd(){
 return false;
 }
 
+long HepMCRdr::numEvents(){
+    if(!m_index.open(m_filename.value(), GenEventIndex::HepMC)) return -1;
+    return m_index.size();
+}
+
+bool HepMCRdr::setEventRange(long first, long count){
+    if(m_processed_event != 0 || first < 0) return false;
+    if(first > 0){
+        if(numEvents() < first) return false;
+        // an empty range
+        if(first == m_index.size()) count = 0;
+        else {
+            // the first event is read to pass the file header, then the stream jumps to the first event of the range
+            HepMC::GenEvent* evt = ascii_in->read_next_event();
+            if(!evt) return false;
+            delete evt;
+            m_input.clear();
+            if(!m_input.seekg(m_index.offset(first))) return false;
+        }
+    }
+    m_processed_event = first;
+    m_last_event = count < 0 ? -1 : first + count;
+    return true;
+}
+
 bool HepMCRdr::configure_gentool(){
-    ascii_in = new HepMC::IO_GenEvent(m_filename.value().c_str(),std::ios::in);
+    if(!m_input_buf.open(m_filename.value())) {
+        std::cout << "HepMCRdr, can not open " << m_filename.value() << std::endl;
+        return false;
+    }
+    ascii_in = new HepMC::IO_GenEvent(m_input);
 
     m_processed_event=0;
+    m_read_ahead.start(std::bind(&HepMCRdr::readRecord, this, std::placeholders::_1), m_read_ahead_depth.value());
     return true;
 }
 
 bool HepMCRdr::finish(){
+    m_read_ahead.stop();
     return true;
 }
 
@@ -5,10 +5,15 @@
 
 #include "GenReader.h"
 #include "GenEvent.h"
+#include "GenEventRecord.h"
+#include "GenReadAhead.h"
+#include "GenEventIndex.h"
+#include "GenInputStream.h"
 
 #include "HepMC/IO_GenEvent.h"//HepMC
 #include "HepMC/GenEvent.h"
 
+#include <istream>
 
 class HepMCRdr: public extends<AlgTool, GenReader> {
 
@@ -23,13 +28,27 @@ class HepMCRdr: public extends<AlgTool, GenReader> {
         bool mutate(MyHepMC::GenEvent& event);    
         bool finish();
         bool isEnd();
+        long numEvents();
+        bool setEventRange(long first, long count);
     private:
+        // decode the next event, called by the read-ahead thread if there is one
+        bool readRecord(MyHepMC::GenEventRecord& record);
+
+        // plain or compressed input file
+        GenInputStreamBuf m_input_buf;
+        std::istream m_input{&m_input_buf};
         HepMC::IO_GenEvent *ascii_in{nullptr};
+        GenEventIndex m_index;
         long m_total_event{-1};
         long m_processed_event{-1};
+        // end of the event range, -1 for the end of the file
+        long m_last_event{-1};
+        GenReadAhead m_read_ahead;
 
         // input file name
         Gaudi::Property<std::string> m_filename{this, "Input"};
+        // number of events decoded in advance by a background thread, 0 to read in mutate
+        Gaudi::Property<unsigned int> m_read_ahead_depth{this, "ReadAhead", 0};
 
 };
 
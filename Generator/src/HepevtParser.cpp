@@ -0,0 +1,78 @@
+#include "HepevtParser.h"
+
+#include <iostream>
+
+bool HepevtParser::open(const std::string& filename){
+    return m_input.open(filename);
+}
+
+bool HepevtParser::seek(long long offset){
+    return m_input.seek(offset);
+}
+
+long long HepevtParser::tell(){
+    return m_input.tell();
+}
+
+bool HepevtParser::failed() const{
+    return m_input.failed();
+}
+
+bool HepevtParser::readEvent(std::vector<HepevtParticle>& particles){
+    particles.clear();
+
+    int NHEP;      // number of entries
+    int NOUT;      // number of outgoing particles
+    int BRE;       // beam remnants
+    double WEIGHT; // weight
+    if (m_input.atEnd()) return false;
+    if (!(m_input.next(NHEP) && m_input.next(NOUT) && m_input.next(BRE) && m_input.next(WEIGHT)) || NHEP < 0) {
+        std::cout << "HepevtParser: bad event header" << std::endl;
+        return false;
+    }
+
+    particles.resize(NHEP);
+    for (int IHEP=0; IHEP<NHEP; IHEP++) {
+        HepevtParticle& p = particles[IHEP];
+        bool ok = m_input.next(p.ISTHEP) && m_input.next(p.IDHEP)
+               && m_input.next(p.JMOHEP1) && m_input.next(p.JMOHEP2)
+               && m_input.next(p.JDAHEP1) && m_input.next(p.JDAHEP2);
+        for (int k=0; ok && k<5; k++) ok = m_input.next(p.PHEP[k]);
+        for (int k=0; ok && k<4; k++) ok = m_input.next(p.VHEP[k]);
+        if (!ok) {
+            std::cout << "HepevtParser: truncated or malformed particle " << IHEP << " of " << NHEP << std::endl;
+            particles.clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+void HepevtParser::daughters(const std::vector<HepevtParticle>& particles, int i, std::vector<int>& indices){
+    indices.clear();
+    const int n = particles.size();
+    const int fd = particles[i].JDAHEP1 - 1;
+    const int ld = particles[i].JDAHEP2 - 1;
+    int first = -1;
+    int last = -1;
+    //
+    //  Look for range, 2 discreet or 1 discreet daughter.
+    //
+    if ( (fd > -1) && (ld > -1) ) {
+        if (ld >= fd) { first = fd; last = ld; }
+        else          { indices.push_back(fd); indices.push_back(ld); }
+    }
+    else if (fd > -1) indices.push_back(fd);
+    else if (ld > -1) indices.push_back(ld);
+
+    if (first > -1) {
+        for (int id=first; id<=last && id<n; id++) indices.push_back(id);
+        if (last >= n) std::cout << "HepevtParser: daughters of particle " << i+1 << " go beyond the event" << std::endl;
+        return;
+    }
+    for (std::vector<int>::iterator it = indices.begin(); it != indices.end(); ) {
+        if (*it < n) { ++it; continue; }
+        std::cout << "HepevtParser: daughter " << *it+1 << " of particle " << i+1 << " is not in the event" << std::endl;
+        it = indices.erase(it);
+    }
+}
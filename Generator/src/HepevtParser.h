@@ -0,0 +1,46 @@
+#ifndef HepevtParser_h
+#define HepevtParser_h 1
+
+/*
+ * HepevtParser reads the events of an ASCII HEPEvt/hepevt file: a header
+ * line NHEP NOUT BRE WEIGHT, then one line per particle with the HEPEVT
+ * common block entries. Used by LCAscHepRdr and HepevtRdr.
+ */
+
+#include "GenAsciiInput.h"
+
+#include <string>
+#include <vector>
+
+struct HepevtParticle {
+    int    ISTHEP;   // status code
+    int    IDHEP;    // PDG code
+    int    JMOHEP1;  // first mother
+    int    JMOHEP2;  // last mother
+    int    JDAHEP1;  // first daughter
+    int    JDAHEP2;  // last daughter
+    double PHEP[5];  // px, py, pz, energy in GeV and mass in GeV/c**2
+    double VHEP[4];  // vertex position and production time in mm, mm/c
+};
+
+class HepevtParser {
+    public:
+        bool open(const std::string& filename);
+        // continue at the event starting at a byte offset, see GenEventIndex
+        bool seek(long long offset);
+        // the byte offset of the next event, -1 at the end of the file
+        long long tell();
+        // true if a compressed file turned out to be corrupt or truncated
+        bool failed() const;
+
+        // read the next event, false at the end of the file or on a truncated or malformed event
+        bool readEvent(std::vector<HepevtParticle>& particles);
+
+        // the indices (0-based) of the daughters of particle i: a range, two discrete ones or a single one
+        static void daughters(const std::vector<HepevtParticle>& particles, int i, std::vector<int>& indices);
+
+    private:
+        GenAsciiInput m_input;
+};
+
+#endif
@@ -1,99 +1,67 @@
 #include "HepevtRdr.h"
 #include "GenEvent.h"
+#include "GenEventRecord.h"
 
-#include "lcio.h"  //LCIO
-#include "EVENT/LCIO.h"
-#include "LCAscHepRdr.h"
-#include "IMPL/MCParticleImpl.h"
+#include "HepevtParser.h"
 
 
-#include "plcio/MCParticle.h" //plcio
-#include "plcio/MCParticleObj.h"
-#include "plcio/MCParticleCollection.h"
-#include "plcio/DoubleThree.h"
-#include "plcio/FloatThree.h"
-#include "plcio/EventHeaderCollection.h"
+#include "edm4hep/MCParticle.h" //edm4hep
+#include "edm4hep/MCParticleObj.h"
+#include "edm4hep/MCParticleCollection.h"
+#include "edm4hep/EventHeaderCollection.h"
 
 
 
 #include <iostream>
 #include <vector>
 #include <fstream>
+#include <functional>
 
 
-using namespace lcio;
-using namespace IMPL;
-using namespace plcio;
+using namespace edm4hep;
 using namespace std;
 
-typedef enum HEPFILEFORMATS
-{
-  stdhep = 0,
-  HEPEvt,
-  hepevt,
-  slcio
-}  HEPFILEFORMAT;
-
-
-HepevtRdr::HepevtRdr(string name){
-
-m_hepevt_rdr = new UTIL::LCAscHepRdr(name.c_str(), hepevt);
-m_processed_event=0;
-std::cout<<"initial hepevt_rdr"<<std::endl;
-}
+DECLARE_COMPONENT(HepevtRdr)
 
 HepevtRdr::~HepevtRdr(){
-delete m_hepevt_rdr;
+m_read_ahead.stop();
 }
 
 bool HepevtRdr::mutate(MyHepMC::GenEvent& event){
-    LCCollectionVec* mc_vec = m_hepevt_rdr->readEvent();
-    if(mc_vec==nullptr) return false;
+    if(m_last_event >= 0 && m_processed_event >= m_last_event) return false;
+    MyHepMC::GenEventRecord record;
+    if(!m_read_ahead.next(record)) return false;
     m_processed_event ++;
-    int n_mc = mc_vec->getNumberOfElements();
-    std::cout<<"Read event :"<< m_processed_event <<", mc size :"<< n_mc <<std::endl;
-    std::map<int, int> pmcid_lmcid;
+    if(msgLevel(MSG::DEBUG)) debug()<<"Read event :"<< m_processed_event <<", mc size :"<< record.m_particles.size() <<endmsg;
+    record.fillEvent(event);
+    event.SetEventHeader( m_processed_event, -99, 9999, "Generator");
+    //std::cout<<"end event :"<< m_processed_event <<std::endl;
+    return true;
+}
+
+bool HepevtRdr::readRecord(MyHepMC::GenEventRecord& record){
+    if(!m_hepevt_rdr.readEvent(m_hepevt_particles)) return false;
+    const int n_mc = m_hepevt_particles.size();
+    record.clear();
+    record.reserve(n_mc);
+    // same content as the MCParticles of LCAscHepRdr: no vertex, time or charge in HEPEvt files
     for (int i=0; i < n_mc; i++){
-        MCParticleImpl* mc = (MCParticleImpl*) mc_vec->getElementAt(i);
-        //std::cout<<"At mc :"<< i <<std::endl;
-        plcio::MCParticle mcp = event.m_mc_vec.create();
-        pmcid_lmcid.insert(std::pair<int, int>(mc->id(),i));
-        //std::cout<<"map<id,i>:"<<mc->id()<<","<< i <<std::endl;
-                                 
-        mcp.setPDG                (mc->getPDG());  
-        mcp.setGeneratorStatus    (mc->getGeneratorStatus());
-        mcp.setSimulatorStatus    (mc->getSimulatorStatus());
-        mcp.setCharge             (mc->getCharge());
-        mcp.setTime               (mc->getTime());
-        mcp.setMass               (mc->getMass());
-        mcp.setVertex             (mc->getVertex()); 
-        mcp.setEndpoint           (mc->getEndpoint());
-        mcp.setMomentum           (FloatThree(float(mc->getMomentum()[0]), float(mc->getMomentum()[1]), float(mc->getMomentum()[2]) ));
-        mcp.setMomentumAtEndpoint (FloatThree(float(mc->getMomentumAtEndpoint()[0]), float(mc->getMomentumAtEndpoint()[1]), float(mc->getMomentumAtEndpoint()[2]) ));
-        mcp.setSpin               (mc->getSpin());
-        mcp.setColorFlow          (mc->getColorFlow());
+        const HepevtParticle& hep = m_hepevt_particles[i];
+        MyHepMC::GenParticleRecord& mcp = record.addParticle();
+        mcp.pdg                = hep.IDHEP;
+        mcp.generatorStatus    = hep.ISTHEP;
+        mcp.simulatorStatus    = 0;
+        mcp.mass               = float(hep.PHEP[4]);
+        mcp.momentum           = Vector3f(float(hep.PHEP[0]), float(hep.PHEP[1]), float(hep.PHEP[2]));
     }
-    // second loop for setting parents and daughters
-    
+    // second loop: all daughters listed are daughters, and their parents follow from them
     for (int i=0; i < n_mc; i++){
-        MCParticleImpl* mc = (MCParticleImpl*) mc_vec->getElementAt(i);
-        const MCParticleVec & mc_parents = mc->getParents();
-        const MCParticleVec & mc_daughters = mc->getDaughters();
-        plcio::MCParticle pmc = event.m_mc_vec.at(i);
-        //std::cout<<"mc at "<< i<<", parent size "<<mc_parents.size() <<std::endl;
-        for(unsigned int j=0; j< mc_parents.size(); j++){int p_id = mc_parents.at(j)->id();
-                                                 //std::cout<<"parent id "<<p_id<<std::endl;
-                                                 pmc.addParent( event.m_mc_vec.at( pmcid_lmcid.at(p_id) ) );
-                                                }
-        //std::cout<<"mc at "<< i<<", daughter size "<<mc_daughters.size() <<std::endl;
-        for(unsigned int j=0; j< mc_daughters.size(); j++){int d_id = mc_daughters.at(j)->id();
-                                                 //std::cout<<"daughter id "<<d_id<<std::endl;
-                                                 pmc.addDaughter( event.m_mc_vec.at( pmcid_lmcid.at(d_id) ) );
-                                                }
+        HepevtParser::daughters(m_hepevt_particles, i, m_hepevt_daughters);
+        for (unsigned int j=0; j < m_hepevt_daughters.size(); j++){
+            record.addParent(m_hepevt_daughters[j], i);
+            record.addDaughter(i, m_hepevt_daughters[j]);
+        }
     }
-     
-    event.SetEventHeader( m_processed_event, -99, 9999, "Generator");
-    //std::cout<<"end event :"<< m_processed_event <<std::endl;
     return true;
 }
 
@@ -101,10 +69,57 @@ bool HepevtRdr::isEnd(){
 return false;
 }
 
-bool HepevtRdr::configure(){
-return true;
+long HepevtRdr::numEvents(){
+    if(!m_index.open(m_filename.value(), GenEventIndex::Hepevt)) return -1;
+    return m_index.size();
+}
+
+bool HepevtRdr::setEventRange(long first, long count){
+    if(m_processed_event != 0 || first < 0) return false;
+    if(first > 0){
+        if(numEvents() < first) return false;
+        if(first < m_index.size() && !m_hepevt_rdr.seek(m_index.offset(first))) return false;
+        // an empty range
+        if(first == m_index.size()) count = 0;
+    }
+    m_processed_event = first;
+    m_last_event = count < 0 ? -1 : first + count;
+    return true;
+}
+
+bool HepevtRdr::configure_gentool(){
+    if (!m_hepevt_rdr.open(m_filename.value())) {
+        std::cout << "HepevtRdr, no ascii Hep file found: " << m_filename.value() << std::endl;
+        return false;
+    }
+    m_processed_event=0;
+    m_read_ahead.start(std::bind(&HepevtRdr::readRecord, this, std::placeholders::_1), m_read_ahead_depth.value());
+    std::cout<<"initial hepevt_rdr"<<std::endl;
+    return true;
 }
 
 bool HepevtRdr::finish(){
-return true;
+    m_read_ahead.stop();
+    return true;
+}
+
+StatusCode
+HepevtRdr::initialize() {
+    StatusCode sc;
+    if (not configure_gentool()) {
+        error() << "failed to initialize." << endmsg;
+        return StatusCode::FAILURE;
+    }
+
+    return sc;
+}
+
+StatusCode
+HepevtRdr::finalize() {
+    StatusCode sc;
+    if (not finish()) {
+        error() << "Failed to finalize." << endmsg;
+        return StatusCode::FAILURE;
+    }
+    return sc;
 }
@@ -1,27 +1,52 @@
 #ifndef HepevtRdr_h
 #define HepevtRdr_h 1
 
+#include "GaudiKernel/AlgTool.h"
+
 #include "GenReader.h"
 #include "GenEvent.h"
+#include "GenEventRecord.h"
+#include "GenReadAhead.h"
+#include "GenEventIndex.h"
+
+#include "HepevtParser.h"
 
-#include "lcio.h"
-#include "EVENT/LCIO.h"
-#include "LCAscHepRdr.h"
+#include <vector>
 
-class HepevtRdr: public GenReader{
+class HepevtRdr: public extends<AlgTool, GenReader> {
 
     public:
-        HepevtRdr(string name);
+        using extends::extends;
         ~HepevtRdr();
-        bool configure();               
-        bool mutate(MyHepMC::GenEvent& event);    
-        bool finish();
-        bool isEnd();
+
+        // Overriding initialize and finalize
+        StatusCode initialize() override;
+        StatusCode finalize() override;    
+
+        bool configure_gentool() override;               
+        bool mutate(MyHepMC::GenEvent& event) override;    
+        bool finish() override;
+        bool isEnd() override;
+        long numEvents() override;
+        bool setEventRange(long first, long count) override;
     private:
-        UTIL::LCAscHepRdr* m_hepevt_rdr;
-        long m_total_event;
-        long m_processed_event;
+        // decode the next event, called by the read-ahead thread if there is one
+        bool readRecord(MyHepMC::GenEventRecord& record);
+
+        HepevtParser m_hepevt_rdr;
+        std::vector<HepevtParticle> m_hepevt_particles;
+        std::vector<int> m_hepevt_daughters;
+        long m_total_event{-1};
+        long m_processed_event{-1};
+        // end of the event range, -1 for the end of the file
+        long m_last_event{-1};
+        GenEventIndex m_index;
+        GenReadAhead m_read_ahead;
+
+        // input file name
+        Gaudi::Property<std::string> m_filename{this, "Input"};
+        // number of events decoded in advance by a background thread, 0 to read in mutate
+        Gaudi::Property<unsigned int> m_read_ahead_depth{this, "ReadAhead", 0};
 };
 
 #endif
-
@@ -28,8 +28,7 @@ namespace UTIL{
       {
       case HEPEvt :
       case hepevt :
-	inputFile.open(evfile);
-	if (!inputFile) 
+	if (!theParser.open(evfile)) 
 	  {
 	    std::stringstream description ; 
 	    description << "LCAscHepRdr, no ascii Hep file found: " << evfile << std::ends ;
@@ -56,19 +55,15 @@ namespace UTIL{
     //
     //  Read the event, check for errors
     //
-    int NHEP;  // number of entries
-    int NOUT ;   // number of outgoing particles
-    int BRE ;   // beam remnants
-    double WEIGHT ;   // weight
-    inputFile >> NHEP >> NOUT >> BRE >> WEIGHT; 
-    if( inputFile.eof() ) 
+    if( !theParser.readEvent(theParticles) ) 
       {
 	//
-	// End of File :: ??? Exception ???
+	// End of File (or a truncated event, reported by the parser)
 	//   -> FG:   EOF is not an exception as it happens for every file at the end !
 	//
 	return mcVec;
       }
+    int NHEP = theParticles.size();  // number of entries
     
     //
     //  Create a Collection Vector
@@ -80,42 +75,9 @@ namespace UTIL{
     //
     //  Loop over particles
     //
-    int ISTHEP;   // status code
-    int IDHEP;    // PDG code
-    int JMOHEP1;  // first mother
-    int JMOHEP2;  // last mother
-    int JDAHEP1;  // first daughter
-    int JDAHEP2;  // last daughter
-    double PHEP1; // px in GeV/c
-    double PHEP2; // py in GeV/c
-    double PHEP3; // pz in GeV/c
-    double PHEP4; // energy in GeV
-    double PHEP5; // mass in GeV/c**2
-    double VHEP1; // x vertex position in mm
-    double VHEP2; // y vertex position in mm
-    double VHEP3; // z vertex position in mm
-    double VHEP4; // production time in mm/c
-
-    std::vector<int> *daughter1 = new std::vector<int> ();
-    std::vector<int> *daughter2 =  new std::vector<int> ();
-
     for( int IHEP=0; IHEP<NHEP; IHEP++ )
       {
-	//if ( theFileFormat == HEPEvt)
-	if ( false)
-	  inputFile >> ISTHEP >> IDHEP >> JDAHEP1 >> JDAHEP2
-		  >> PHEP1 >> PHEP2 >> PHEP3 >> PHEP5;
-	else
-	  inputFile >> ISTHEP >> IDHEP 
-		    >> JMOHEP1 >> JMOHEP2
-		    >> JDAHEP1 >> JDAHEP2
-		    >> PHEP1 >> PHEP2 >> PHEP3 
-		    >> PHEP4 >> PHEP5
-		    >> VHEP1 >> VHEP2 >> VHEP3
-		    >> VHEP4;
-
-	if(inputFile.eof())
-		return nullptr;	
+	const HepevtParticle& hep = theParticles[IHEP];
 	//
 	//  Create a MCParticle and fill it from stdhep info
 	//
@@ -123,16 +85,16 @@ namespace UTIL{
 	//
 	//  PDGID
 	//
-	mcp->setPDG(IDHEP);
+	mcp->setPDG(hep.IDHEP);
 	//
 	//  Momentum vector
 	//
-	float p0[3] = {PHEP1,PHEP2,PHEP3};
+	float p0[3] = {float(hep.PHEP[0]),float(hep.PHEP[1]),float(hep.PHEP[2])};
 	mcp->setMomentum(p0);
 	//
 	//  Mass
 	//
-	mcp->setMass(PHEP5);
+	mcp->setMass(hep.PHEP[4]);
 	//
 	//  Vertex 
 	// (missing information in HEPEvt files)
@@ -141,7 +103,7 @@ namespace UTIL{
 	//
 	//  Generator status
 	//
-	mcp->setGeneratorStatus(ISTHEP);
+	mcp->setGeneratorStatus(hep.ISTHEP);
 	//
 	//  Simulator status 0 until simulator acts on it
 	//
@@ -154,63 +116,8 @@ namespace UTIL{
 	//  Add the particle to the collection vector
 	//
 	mcVec->push_back(mcp);
-	//
-	// Keep daughters information for later
-	//
-	daughter1->push_back(JDAHEP1);
-	daughter2->push_back(JDAHEP2);
-
-	   // fg: comment out the  mother relationships altogether ....
 
-// //
-// // Add the parent information. The implicit assumption here is that
-// // no particle is read in before its parents.
-// //
-// 	   int fp = _reader->mother1(IHEP) - 1;
-// 	   int lp = _reader->mother2(IHEP) - 1;
-// //
-// //  If both first parent and second parent > 0, and second parent >
-// //     first parent, assume a range
-// //
-// 	   if( (fp > -1) && (lp > -1) )
-// 	   {
-// 	     if(lp >= fp)
-// 		 {
-// 		   for(int ip=fp;ip<lp+1;ip++)
-// 		   {
-// 			 p = dynamic_cast<MCParticleImpl*>
-// 				 (mcVec->getElementAt(ip));
-// 			 mcp->addParent(p);
-// 		   }
-// 		 }
-// //
-// //  If first parent < second parent, assume 2 discreet parents
-// //
-// 		 else
-// 		 {
-// 		   p = dynamic_cast<MCParticleImpl*>
-// 			 (mcVec->getElementAt(fp));
-// 		   mcp->addParent(p);
-// 		   p = dynamic_cast<MCParticleImpl*>
-// 			 (mcVec->getElementAt(lp));
-// 		   mcp->addParent(p);
-// 		 }
-// 	   }
-// //
-// //  Only 1 parent > 0, set it
-// //
-// 	   else if(fp > -1)
-// 	   {
-// 		 p = dynamic_cast<MCParticleImpl*>
-// 		   (mcVec->getElementAt(fp));
-// 		 mcp->addParent(p);
-// 	   }
-// 	   else if(lp > -1)
-// 	   {
-// 		 p = dynamic_cast<MCParticleImpl*>
-// 		   (mcVec->getElementAt(lp));
-// 		 mcp->addParent(p);
-// 	   }
+	   // fg: the mother relationships are left out altogether, the daughters are used below
 
 	 }// End loop over particles
 //
@@ -228,90 +135,19 @@ namespace UTIL{
 	  dynamic_cast<MCParticleImpl*>
 	  (mcVec->getElementAt(IHEP));
 	//
-	//  Get the daughter information, discarding extra information
-	//  sometimes stored in daughter variables.
+	//  Get the daughter information (range, 2 discreet or 1 discreet
+	//  daughter), discarding extra information sometimes stored in
+	//  daughter variables.
 	//
-
-	int fd = daughter1->operator[](IHEP) - 1;
-	int ld = daughter2->operator[](IHEP) - 1;
-
-	//
-	//  As with the parents, look for range, 2 discreet or 1 discreet 
-	//  daughter.
-	//
-	if( (fd > -1) && (ld > -1) )
+	HepevtParser::daughters(theParticles, IHEP, theDaughters);
+	for(unsigned int id=0; id<theDaughters.size(); id++)
 	  {
-	    if(ld >= fd)
-	      {
-		for(int id=fd;id<ld+1;id++)
-		  {
-		    //
-		    //  Get the daughter, and see if it already lists this particle as
-		    //    a parent.
-		    //
-		    d = dynamic_cast<MCParticleImpl*>
-		      (mcVec->getElementAt(id));
-		    int np = d->getParents().size();
-		    bool gotit = false;
-		    for(int ip=0;ip < np;ip++)
-		      {
-			p = dynamic_cast<MCParticleImpl*>
-			  (d->getParents()[ip]);
-			if(p == mcp)gotit = true;
-		      }
-		    //
-		    //  If not already listed, add this particle as a parent
-		    //
-		    if(!gotit)d->addParent(mcp);
-		  }
-	      }
 	    //
-	    //  Same logic, discreet cases
+	    //  Get the daughter, and see if it already lists this particle as
+	    //    a parent.
 	    //
-	    else
-	      {
-		d = dynamic_cast<MCParticleImpl*>
-		  (mcVec->getElementAt(fd));
-		int np = d->getParents().size();
-		bool gotit = false;
-		for(int ip=0;ip < np;ip++)
-		  {
-		    p = dynamic_cast<MCParticleImpl*>
-		      (d->getParents()[ip]);
-		    if(p == mcp)gotit = true;
-		  }
-		if(!gotit)d->addParent(mcp);
-		d = dynamic_cast<MCParticleImpl*>
-		  (mcVec->getElementAt(ld));
-		np = d->getParents().size();
-		gotit = false;
-		for(int ip=0;ip < np;ip++)
-		  {
-		    p = dynamic_cast<MCParticleImpl*>
-		      (d->getParents()[ip]);
-		    if(p == mcp)gotit = true;
-		  }
-		if(!gotit)d->addParent(mcp);
-	      }
-	  }
-	else if(fd > -1)
-	  {
 	    d = dynamic_cast<MCParticleImpl*>
-	      (mcVec->getElementAt(fd));
-	    int np = d->getParents().size();
-	    bool gotit = false;
-	    for(int ip=0;ip < np;ip++)
-	      {
-		p = dynamic_cast<MCParticleImpl*>
-		  (d->getParents()[ip]);
-		if(p == mcp)gotit = true;
-	      }
-	    if(!gotit)d->addParent(mcp);
-	  }
-	else if(ld > -1)
-	  {
-	    d = dynamic_cast<MCParticleImpl*>
-	      (mcVec->getElementAt(ld));
+	      (mcVec->getElementAt(theDaughters[id]));
 	    int np = d->getParents().size();
 	    bool gotit = false;
 	    for(int ip=0;ip < np;ip++)
@@ -320,6 +156,9 @@ namespace UTIL{
 		  (d->getParents()[ip]);
 		if(p == mcp)gotit = true;
 	      }
+	    //
+	    //  If not already listed, add this particle as a parent
+	    //
 	    if(!gotit)d->addParent(mcp);
 	  }
       }// End second loop over particles
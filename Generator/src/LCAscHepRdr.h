@@ -2,7 +2,8 @@
 #define UTIL_LCAscHepRdr_H 1
 
 #include "IMPL/LCCollectionVec.h"
-#include <fstream>
+#include "HepevtParser.h"
+#include <vector>
 
 namespace UTIL{
   
@@ -30,7 +31,9 @@ namespace UTIL{
     IMPL::LCCollectionVec * readEvent() ;
 
   private:
-    std::ifstream inputFile;
+    HepevtParser theParser;
+    std::vector<HepevtParticle> theParticles;
+    std::vector<int> theDaughters;
     int theFileFormat;
     
   }; // class
@@ -1,5 +1,7 @@
 #include "StdHepRdr.h"
 #include "GenEvent.h"
+#include "GenEventRecord.h"
+#include "GenLCIOConverter.h"
 
 #include "lcio.h"  //LCIO
 #include "EVENT/LCIO.h"
@@ -17,6 +19,7 @@
 #include <iostream>
 #include <vector>
 #include <fstream>
+#include <functional>
 
 
 using namespace lcio;
@@ -27,57 +30,29 @@ using namespace std;
 DECLARE_COMPONENT(StdHepRdr)
 
 StdHepRdr::~StdHepRdr(){
+    m_read_ahead.stop();
     delete m_stdhep_rdr;
 }
 
 bool StdHepRdr::mutate(MyHepMC::GenEvent& event){
     if(isEnd()) return false;
-    LCCollectionVec* mc_vec = m_stdhep_rdr->readEvent();
+    if(m_last_event >= 0 && m_processed_event >= m_last_event) return false;
+    MyHepMC::GenEventRecord record;
+    if(!m_read_ahead.next(record)) return false;
     m_processed_event ++;
-    int n_mc = mc_vec->getNumberOfElements();
-    //std::cout<<"Debug: Read event :"<< m_processed_event <<", mc size :"<< n_mc <<std::endl;
-    std::map<int, int> pmcid_lmcid;
-    for (int i=0; i < n_mc; i++){
-        MCParticleImpl* mc = (MCParticleImpl*) mc_vec->getElementAt(i);
-        //std::cout<<"At mc :"<< i <<std::endl;
-        edm4hep::MCParticle mcp = event.m_mc_vec.create();
-        pmcid_lmcid.insert(std::pair<int, int>(mc->id(),i));
-        //std::cout<<"map<id,i>:"<<mc->id()<<","<< i <<std::endl;
-                                 
-        mcp.setPDG                (mc->getPDG());  
-        mcp.setGeneratorStatus    (mc->getGeneratorStatus());
-        mcp.setSimulatorStatus    (mc->getSimulatorStatus());
-        mcp.setCharge             (mc->getCharge());
-        mcp.setTime               (mc->getTime());
-        mcp.setMass               (mc->getMass());
-        mcp.setVertex             (mc->getVertex()); 
-        mcp.setEndpoint           (mc->getEndpoint());
-        mcp.setMomentum           (Vector3f(float(mc->getMomentum()[0]), float(mc->getMomentum()[1]), float(mc->getMomentum()[2]) ));
-        mcp.setMomentumAtEndpoint (Vector3f(float(mc->getMomentumAtEndpoint()[0]), float(mc->getMomentumAtEndpoint()[1]), float(mc->getMomentumAtEndpoint()[2]) ));
-        mcp.setSpin               (mc->getSpin());
-        mcp.setColorFlow          (mc->getColorFlow());
-    }
-    // second loop for setting parents and daughters
-    
-    for (int i=0; i < n_mc; i++){
-        MCParticleImpl* mc = (MCParticleImpl*) mc_vec->getElementAt(i);
-        const MCParticleVec & mc_parents = mc->getParents();
-        const MCParticleVec & mc_daughters = mc->getDaughters();
-        edm4hep::MCParticle pmc = event.m_mc_vec.at(i);
-        //std::cout<<"mc at "<< i<<", parent size "<<mc_parents.size() <<std::endl;
-        for(unsigned int j=0; j< mc_parents.size(); j++){int p_id = mc_parents.at(j)->id();
-                                                 //std::cout<<"parent id "<<p_id<<std::endl;
-                                                 pmc.addToParents( event.m_mc_vec.at( pmcid_lmcid.at(p_id) ) );
-                                                }
-        //std::cout<<"mc at "<< i<<", daughter size "<<mc_daughters.size() <<std::endl;
-        for(unsigned int j=0; j< mc_daughters.size(); j++){int d_id = mc_daughters.at(j)->id();
-                                                 //std::cout<<"daughter id "<<d_id<<std::endl;
-                                                 pmc.addToDaughters( event.m_mc_vec.at( pmcid_lmcid.at(d_id) ) );
-                                                }
-    }
-     
+    record.fillEvent(event);
     event.SetEventHeader( m_processed_event, -99, 9999, "Generator");
     //std::cout<<"end event :"<< m_processed_event <<std::endl;
+    return true;
+}
+
+bool StdHepRdr::readRecord(MyHepMC::GenEventRecord& record){
+    if(m_read_event == m_total_event) return false;
+    LCCollectionVec* mc_vec = m_stdhep_rdr->readEvent();
+    if(mc_vec==nullptr) return false;
+    m_read_event ++;
+    MyHepMC::convertLCIO(mc_vec, record);
+    //std::cout<<"Debug: Read event, mc size :"<< record.m_particles.size() <<std::endl;
 
     delete mc_vec;
 
@@ -89,6 +64,24 @@ if(m_processed_event == m_total_event) {std::cout<<"Have read all events, end no
 else return false;
 }
 
+long StdHepRdr::numEvents(){
+    return m_total_event;
+}
+
+bool StdHepRdr::setEventRange(long first, long count){
+    if(m_processed_event != 0 || first < 0 || first > m_total_event) return false;
+    // stdhep files have no event index: the events before the range are decoded and dropped,
+    // without the conversion and the event loop
+    for(; m_read_event < first; m_read_event++){
+        LCCollectionVec* mc_vec = m_stdhep_rdr->readEvent();
+        if(mc_vec==nullptr) return false;
+        delete mc_vec;
+    }
+    m_processed_event = first;
+    m_last_event = count < 0 ? -1 : first + count;
+    return true;
+}
+
 bool StdHepRdr::configure_gentool(){
     m_stdhep_rdr = new LCStdHepRdrNew(m_filename.value().c_str());
     m_stdhep_rdr->printHeader();
@@ -98,11 +91,14 @@ bool StdHepRdr::configure_gentool(){
 
     m_total_event = m_stdhep_rdr->getNumberOfEvents() - 1 ;
     m_processed_event=0;
+    m_read_event=0;
+    m_read_ahead.start(std::bind(&StdHepRdr::readRecord, this, std::placeholders::_1), m_read_ahead_depth.value());
 
     return true;
 }
 
 bool StdHepRdr::finish(){
+    m_read_ahead.stop();
     return true;
 }
 
@@ -5,6 +5,8 @@
 
 #include "GenReader.h"
 #include "GenEvent.h"
+#include "GenEventRecord.h"
+#include "GenReadAhead.h"
 
 #include "lcio.h"
 #include "EVENT/LCIO.h"
@@ -27,13 +29,24 @@ public:
     bool mutate(MyHepMC::GenEvent& event) override;    
     bool finish() override;
     bool isEnd() override;
+    long numEvents() override;
+    bool setEventRange(long first, long count) override;
 private:
+    // decode the next event, called by the read-ahead thread if there is one
+    bool readRecord(MyHepMC::GenEventRecord& record);
+
     lcio::LCStdHepRdrNew* m_stdhep_rdr{nullptr};
     long m_total_event{-1};
     long m_processed_event{-1};
+    long m_read_event{-1};
+    // end of the event range, -1 for the end of the file
+    long m_last_event{-1};
+    GenReadAhead m_read_ahead;
 
     // input file name
     Gaudi::Property<std::string> m_filename{this, "Input"};
+    // number of events decoded in advance by a background thread, 0 to read in mutate
+    Gaudi::Property<unsigned int> m_read_ahead_depth{this, "ReadAhead", 0};
 
 };
 
@@ -0,0 +1,316 @@
+/*
+ * Unit test of the number parsing of GenAsciiInput and of HepevtParser:
+ * the doubles must be the ones of strtod, bit for bit. The HEPEvt event
+ * index must find the events the parser reads.
+ */
+
+#include "GenAsciiInput.h"
+#include "GenEventIndex.h"
+#include "HepevtParser.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(condition) \
+    do { if (!(condition)) { ++failures; std::cout << __FILE__ << ":" << __LINE__ << ": failed: " #condition << std::endl; } } while (0)
+
+std::string temp_file(const std::string& content){
+    const std::string name = "test_GenAsciiInput." + std::to_string(::getpid()) + ".txt";
+    std::FILE* f = std::fopen(name.c_str(), "wb");
+    std::fwrite(content.data(), 1, content.size(), f);
+    std::fclose(f);
+    return name;
+}
+
+bool same_bits(double a, double b){
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+// parse each token of the list as a double and compare with strtod
+void check_doubles(const std::vector<std::string>& tokens){
+    std::string content;
+    for (const std::string& token: tokens) content += token + "\n";
+    const std::string name = temp_file(content);
+    GenAsciiInput input;
+    CHECK(input.open(name));
+    for (const std::string& token: tokens) {
+        double value = 0;
+        const bool ok = input.next(value);
+        const double expected = std::strtod(token.c_str(), nullptr);
+        if (!ok || !same_bits(value, expected)) {
+            ++failures;
+            std::cout << "failed: " << token << " parsed as " << value << ", strtod gives " << expected << std::endl;
+        }
+    }
+    CHECK(input.atEnd());
+    std::remove(name.c_str());
+}
+
+void test_doubles(){
+    check_doubles({
+        // signs, leading '+', exponents
+        "1", "+1.5", "-0.25", "0.0", "-0.0", ".5", "5.", "+.5e1", "-5.E-1",
+        "1e10", "1E-5", "+3.5e+2", "-2.5E-3", "1e0", "1e+022", "1e-22",
+        "0.1", "0.3", "3.141592653589793238462643383279", "100.000000000000000000001",
+        // denormals and the edges of the range
+        "4.9406564584124654e-324", "2.2250738585072009e-308", "2.2250738585072014e-308", "1e-320", "-3e-310",
+        "1.7976931348623157e308", "1e-400", "1e400",
+        // past the exact fast path: mantissa above 2^53, more than 19 digits, exponent above 22
+        "9007199254740993", "9007199254740992", "18446744073709551617", "123456789012345678901234567890",
+        "1e23", "8.589973e9", "2.9e-23", "7.7e22", "0.000000000000000000000000123",
+    });
+
+    // random values printed with all their digits, and short decimal ones
+    std::mt19937_64 rng(42);
+    std::vector<std::string> tokens;
+    char text[64];
+    for (int i = 0; i < 20000; i++) {
+        const std::uint64_t bits = rng();
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        if (std::isnan(value) || std::isinf(value)) continue;
+        std::snprintf(text, sizeof(text), "%.17g", value);
+        tokens.push_back(text);
+        std::snprintf(text, sizeof(text), "%.*e", int(rng() % 12), std::ldexp(double(rng() % 1000000), int(rng() % 80) - 40));
+        tokens.push_back(text);
+    }
+    check_doubles(tokens);
+}
+
+void test_ints(){
+    const std::string name = temp_file("0 +5 -7 2147483647 -2147483648 007\n");
+    GenAsciiInput input;
+    CHECK(input.open(name));
+    const int expected[] = {0, 5, -7, 2147483647, -2147483647 - 1, 7};
+    for (int value: expected) {
+        int parsed = 1;
+        CHECK(input.next(parsed) && parsed == value);
+    }
+    CHECK(input.atEnd());
+    std::remove(name.c_str());
+}
+
+void test_malformed(){
+    const std::vector<std::string> ints = {"1.5", "abc", "2147483648", "-2147483649", "+", "-", "1e3", "12x"};
+    for (const std::string& token: ints) {
+        const std::string name = temp_file(token + " 1\n");
+        GenAsciiInput input;
+        input.open(name);
+        int value = 0;
+        if (input.next(value)) {
+            ++failures;
+            std::cout << "failed: int " << token << " accepted as " << value << std::endl;
+        }
+        std::remove(name.c_str());
+    }
+    const std::vector<std::string> doubles = {"abc", "1e", "1e+", "1.2.3", "--1", "1x", "+-1", "e5", "."};
+    for (const std::string& token: doubles) {
+        const std::string name = temp_file(token + " 1\n");
+        GenAsciiInput input;
+        input.open(name);
+        double value = 0;
+        if (input.next(value)) {
+            ++failures;
+            std::cout << "failed: double " << token << " accepted as " << value << std::endl;
+        }
+        std::remove(name.c_str());
+    }
+    // nothing left
+    const std::string name = temp_file(" \n\t\r\n");
+    GenAsciiInput input;
+    input.open(name);
+    double value = 0;
+    CHECK(input.atEnd());
+    CHECK(!input.next(value));
+    std::remove(name.c_str());
+}
+
+// the last token of the file is not followed by whitespace
+void test_no_final_newline(){
+    std::string name = temp_file("1 -2 3");
+    GenAsciiInput input;
+    CHECK(input.open(name));
+    const int expected[] = {1, -2, 3};
+    for (int value: expected) {
+        int parsed = 0;
+        CHECK(input.next(parsed) && parsed == value);
+    }
+    CHECK(input.atEnd());
+    std::remove(name.c_str());
+
+    name = temp_file("0.5\n-1.25e2");
+    CHECK(input.open(name));
+    double value = 0;
+    CHECK(input.next(value) && value == 0.5);
+    CHECK(input.next(value) && value == -125.0);
+    CHECK(input.atEnd());
+    std::remove(name.c_str());
+
+    // a single event, the last VHEP value ends the file
+    name = temp_file("1 1 0 1.0\n1 22 0 0 0 0 1.5 -2.5 3.5 4.5 0.0 0.1 0.2 0.3 0.4");
+    HepevtParser parser;
+    CHECK(parser.open(name));
+    std::vector<HepevtParticle> particles;
+    CHECK(parser.readEvent(particles));
+    CHECK(particles.size() == 1);
+    if (particles.size() == 1) CHECK(particles[0].VHEP[3] == 0.4);
+    CHECK(!parser.readEvent(particles));
+    std::remove(name.c_str());
+}
+
+// a long file, so that tokens go across the refills of the buffer
+void test_buffer_boundaries(){
+    std::string content;
+    long long sum = 0;
+    for (long long i = 0; i < 300000; i++) {
+        content += std::to_string(i * 7919 % 1000003) + ((i % 3) ? " " : "\r\n");
+        sum += i * 7919 % 1000003;
+    }
+    const std::string name = temp_file(content);
+    GenAsciiInput input;
+    CHECK(input.open(name));
+    long long parsed_sum = 0;
+    int value = 0;
+    int n = 0;
+    while (input.next(value)) { parsed_sum += value; n++; }
+    CHECK(n == 300000);
+    CHECK(parsed_sum == sum);
+    std::remove(name.c_str());
+
+    // the same without the whitespace at the end, the last token is cut by the end of the file
+    content.erase(content.find_last_not_of(" \r\n") + 1);
+    const std::string cut = temp_file(content);
+    CHECK(input.open(cut));
+    parsed_sum = 0;
+    n = 0;
+    while (input.next(value)) { parsed_sum += value; n++; }
+    CHECK(n == 300000);
+    CHECK(parsed_sum == sum);
+    std::remove(cut.c_str());
+}
+
+void test_hepevt(){
+    // CRLF line ends, blank lines and trailing spaces between and inside events
+    const std::string content =
+        "2 2 0 1.0\r\n"
+        "1 11 0 0 2 2 0.0 0.0 125.0 125.0 0.000511 0 0 0 0\r\n"
+        "\r\n"
+        "1 -11 1 1 0 0 +0.0 -0.0 -1.25e2 1.25E+2 5.11e-4 \r\n"
+        "1e-3 -2E-3 +3.0 0 \r\n"
+        "\r\n"
+        "   \r\n"
+        "1 1 0 1.0\r\n"
+        "1 22 0 0 0 0 1.5 -2.5 3.5 4.9406564584124654e-324 0.0 0 0 0 0\r\n"
+        "\r\n";
+    const std::string name = temp_file(content);
+    HepevtParser parser;
+    CHECK(parser.open(name));
+    std::vector<HepevtParticle> particles;
+    CHECK(parser.readEvent(particles));
+    CHECK(particles.size() == 2);
+    if (particles.size() == 2) {
+        CHECK(particles[0].IDHEP == 11 && particles[0].JDAHEP1 == 2 && particles[0].PHEP[4] == 0.000511);
+        CHECK(particles[1].IDHEP == -11 && particles[1].JMOHEP1 == 1 && particles[1].PHEP[2] == -125.0);
+        CHECK(std::signbit(particles[1].PHEP[1]));
+        CHECK(particles[1].VHEP[0] == 1e-3 && particles[1].VHEP[1] == -2e-3 && particles[1].VHEP[2] == 3.0);
+    }
+    CHECK(parser.readEvent(particles));
+    CHECK(particles.size() == 1);
+    if (particles.size() == 1) {
+        CHECK(particles[0].IDHEP == 22 && particles[0].PHEP[0] == 1.5 && particles[0].PHEP[1] == -2.5);
+        CHECK(same_bits(particles[0].PHEP[3], std::strtod("4.9406564584124654e-324", nullptr)));
+    }
+    CHECK(!parser.readEvent(particles));
+    std::remove(name.c_str());
+
+    // a truncated particle is an error, not an event
+    const std::string truncated = temp_file("2 2 0 1.0\n1 11 0 0 0 0 0 0 1 1 0 0 0 0 0\n1 -11 0 0\n");
+    CHECK(parser.open(truncated));
+    CHECK(!parser.readEvent(particles));
+    CHECK(particles.empty());
+    std::remove(truncated.c_str());
+}
+
+
+bool same_particles(const std::vector<HepevtParticle>& a, const std::vector<HepevtParticle>& b){
+    if (a.size() != b.size()) return false;
+    for (std::size_t i = 0; i < a.size(); i++) {
+        if (a[i].ISTHEP != b[i].ISTHEP || a[i].IDHEP != b[i].IDHEP
+         || a[i].JMOHEP1 != b[i].JMOHEP1 || a[i].JMOHEP2 != b[i].JMOHEP2
+         || a[i].JDAHEP1 != b[i].JDAHEP1 || a[i].JDAHEP2 != b[i].JDAHEP2) return false;
+        for (int k = 0; k < 5; k++) if (!same_bits(a[i].PHEP[k], b[i].PHEP[k])) return false;
+        for (int k = 0; k < 4; k++) if (!same_bits(a[i].VHEP[k], b[i].VHEP[k])) return false;
+    }
+    return true;
+}
+
+// the index must start every event where the parser does, with blank lines and wrapped particles
+void test_hepevt_index(){
+    const std::string content =
+        "\r\n"
+        "2 2 0 1.0\r\n"
+        "1 11 0 0 2 2 0.0 0.0 125.0 125.0 0.000511 0 0 0 0\r\n"
+        "\r\n"
+        "1 -11 1 1 0 0 +0.0 -0.0 -1.25e2 1.25E+2 5.11e-4 \r\n"
+        "1e-3 -2E-3 +3.0 0 \r\n"
+        "\r\n"
+        "   \r\n"
+        "1 1 0 1.0\r\n"
+        "1 22 0 0 0 0 1.5 -2.5 3.5 4.9406564584124654e-324 0.0 0 0 0 0\r\n"
+        "\r\n"
+        "3 3 0 0.5 1 211 0 0 0 0 0.1 0.2 0.3 0.4 0.139 0 0 0 0\n"
+        "1 -211 0 0 0 0\n-0.1 -0.2 -0.3 0.4 0.139\n0 0 0 0\n"
+        "1 22 0 0 0 0 0 0 1 1 0\n\n1 2 3 4";
+    const std::string name = temp_file(content);
+
+    std::vector<std::vector<HepevtParticle> > events;
+    HepevtParser parser;
+    CHECK(parser.open(name));
+    std::vector<HepevtParticle> particles;
+    while (parser.readEvent(particles)) events.push_back(particles);
+    CHECK(events.size() == 3);
+
+    GenEventIndex index;
+    CHECK(index.open(name, GenEventIndex::Hepevt));
+    CHECK(index.size() == long(events.size()));
+    for (long i = 0; i < index.size() && i < long(events.size()); i++) {
+        CHECK(parser.seek(index.offset(i)));
+        CHECK(parser.readEvent(particles) && same_particles(particles, events[i]));
+    }
+
+    // the same offsets from the saved index
+    GenEventIndex loaded;
+    CHECK(loaded.open(name, GenEventIndex::Hepevt));
+    CHECK(loaded.size() == index.size());
+    for (long i = 0; i < loaded.size() && i < index.size(); i++) CHECK(loaded.offset(i) == index.offset(i));
+
+    std::remove((name + ".idx").c_str());
+    std::remove(name.c_str());
+}
+
+}
+
+int main(){
+    test_doubles();
+    test_ints();
+    test_malformed();
+    test_no_final_newline();
+    test_buffer_boundaries();
+    test_hepevt();
+    test_hepevt_index();
+    if (failures) std::cout << failures << " failures" << std::endl;
+    else std::cout << "all tests passed" << std::endl;
+    return failures ? 1 : 0;
+}
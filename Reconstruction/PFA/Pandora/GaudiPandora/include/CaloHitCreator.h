@@ -15,13 +15,14 @@
 
 #include "Api/PandoraApi.h"
 
-#include <string>
+#include "PandoraCommon/CollectionMaps.h"
 
-typedef std::vector<edm4hep::CalorimeterHit *> CalorimeterHitVector;
+#include <map>
+#include <string>
+#include <vector>
 
 namespace gear { class GearMgr; }
 
-class CollectionMaps;
 /**
  *  @brief  CaloHitCreator class
  */
@@ -123,6 +124,171 @@ public:
     void Reset();
 
 private:
+    typedef std::vector<double> DoubleVector;
+    typedef std::vector<float> FloatVector;
+    typedef std::vector<pandora::CartesianVector> CartesianVectorList;
+
+    /**
+     *  @brief  CellIDField class, a cell id field bound once to its position in the encoding
+     */
+    class CellIDField
+    {
+    public:
+        /**
+         *  @brief  Default constructor
+         */
+        CellIDField();
+
+        /**
+         *  @brief  Constructor
+         * 
+         *  @param  encodingString the cell id encoding string
+         *  @param  fieldName the name of the field in the encoding string
+         */
+        CellIDField(const std::string &encodingString, const std::string &fieldName);
+
+        /**
+         *  @brief  Decode the field from the cell id of a calo hit
+         * 
+         *  @param  pCaloHit address of the calo hit
+         * 
+         *  @return the field value
+         */
+        long long Decode(const edm4hep::CalorimeterHit *const pCaloHit) const;
+
+    private:
+        unsigned long long              m_mask;                             ///< The mask of the field in the cell id
+        unsigned int                    m_offset;                           ///< The position of the lowest bit of the field
+        unsigned int                    m_width;                            ///< The number of bits of the field
+        bool                            m_isSigned;                         ///< Whether the field holds signed values
+    };
+
+    /**
+     *  @brief  LayerLayoutCache class, the per layer gear quantities read once at initialisation
+     */
+    class LayerLayoutCache
+    {
+    public:
+        /**
+         *  @brief  Default constructor
+         */
+        LayerLayoutCache();
+
+        /**
+         *  @brief  Constructor
+         * 
+         *  @param  layerLayout the gear layer layout
+         */
+        LayerLayoutCache(const gear::LayerLayout &layerLayout);
+
+        int                             m_nLayers;                          ///< The number of layers
+        DoubleVector                    m_cellSize0;                        ///< The cell size 0, per layer
+        DoubleVector                    m_cellSize1;                        ///< The cell size 1, per layer
+        DoubleVector                    m_thickness;                        ///< The layer thickness, per layer
+        DoubleVector                    m_absorberThickness;                ///< The absorber thickness, per layer
+        float                           m_firstAbsorberThickness;           ///< The absorber thickness of the first layer with an absorber, zero if none
+    };
+
+    /**
+     *  @brief  SymmetryPolygon class, the side directions of a polygonal detector structure
+     */
+    class SymmetryPolygon
+    {
+    public:
+        /**
+         *  @brief  Default constructor
+         */
+        SymmetryPolygon();
+
+        /**
+         *  @brief  Constructor
+         * 
+         *  @param  symmetryOrder the symmetry order of the polygon
+         *  @param  phi0 the phi coordinate of the first side
+         */
+        SymmetryPolygon(const unsigned int symmetryOrder, const float phi0);
+
+        unsigned int                    m_symmetryOrder;                    ///< The symmetry order
+        FloatVector                     m_cosPhi;                           ///< The cosine of the phi coordinate of each side
+        FloatVector                     m_sinPhi;                           ///< The sine of the phi coordinate of each side
+    };
+
+    /**
+     *  @brief  CaloDescriptor class, the description of one calorimeter compiled at initialisation
+     */
+    class CaloDescriptor
+    {
+    public:
+        /**
+         *  @brief  Default constructor
+         */
+        CaloDescriptor();
+
+        bool                            m_isValid;                          ///< Whether the encoding and geometry of the calorimeter are available
+        bool                            m_hasStaveField;                    ///< Whether the encoding has a stave field, needed by barrel hits only
+        pandora::HitType                m_hitType;                          ///< The hit type of the calorimeter hits
+        float                           m_radiationLength;                  ///< The absorber radiation length
+        float                           m_interactionLength;                ///< The absorber interaction length
+        CellIDField                     m_layerField;                       ///< The layer field of the cell id
+        CellIDField                     m_staveField;                       ///< The stave field of the cell id, if m_hasStaveField
+        LayerLayoutCache                m_barrelLayout;                     ///< The barrel layer layout
+        LayerLayoutCache                m_endCapLayout;                     ///< The endcap layer layout
+        LayerLayoutCache                m_plugLayout;                       ///< The plug layer layout
+        unsigned int                    m_barrelSymmetryOrder;              ///< The barrel symmetry order
+        float                           m_barrelPhi0;                       ///< The barrel phi0 coordinate
+        CartesianVectorList             m_barrelNormals;                    ///< The barrel cell normal vectors, indexed by stave number
+    };
+
+    /**
+     *  @brief  ECalCalibration class, the calibration constants of one ecal collection
+     */
+    class ECalCalibration
+    {
+    public:
+        float                           m_eCalToMip;                        ///< The calibration from deposited energy to mip
+        float                           m_eCalMipThreshold;                 ///< Threshold for creating calo hits, units mip
+        float                           m_eCalToEMGeV;                      ///< The calibration from deposited energy to EM energy
+        float                           m_eCalToHadGeVBarrel;               ///< The calibration from deposited barrel energy to hadronic energy
+        float                           m_eCalToHadGeVEndCap;               ///< The calibration from deposited endcap energy to hadronic energy
+    };
+
+    typedef std::map<std::string, ECalCalibration> ECalCalibrationMap;
+
+    /**
+     *  @brief  Compile the cell id fields of a calorimeter description
+     * 
+     *  @param  encodingString the cell id encoding string
+     *  @param  decodeStave whether the calorimeter has a barrel, whose hits need the stave field (optional in the encoding)
+     *  @param  descriptor to receive the cell id fields
+     */
+    void CompileCellIDFields(const std::string &encodingString, const bool decodeStave, CaloDescriptor &descriptor) const;
+
+    /**
+     *  @brief  Report a calorimeter whose description could not be compiled
+     * 
+     *  @param  detectorName the name of the calorimeter
+     *  @param  message the message of the exception
+     */
+    void ReportUnavailableCalorimeter(const std::string &detectorName, const char *const message) const;
+
+    /**
+     *  @brief  Compile the barrel symmetry of a calorimeter description, with the cell normal vector of each stave
+     * 
+     *  @param  barrelSymmetryOrder the barrel symmetry order
+     *  @param  barrelPhi0 the barrel phi0 coordinate
+     *  @param  descriptor to receive the barrel symmetry
+     */
+    void CompileBarrelSymmetry(const unsigned int barrelSymmetryOrder, const float barrelPhi0, CaloDescriptor &descriptor) const;
+
+    /**
+     *  @brief  Get the calibration constants of an ecal collection, choosing the Si or Sc constants for a hybrid ecal
+     * 
+     *  @param  collectionName the ecal collection name
+     * 
+     *  @return the calibration constants
+     */
+    ECalCalibration GetECalCalibration(const std::string &collectionName) const;
+
     /**
      *  @brief  Create ecal calo hits
      * 
@@ -163,16 +329,21 @@ private:
      *  @brief  Get end cap specific calo hit properties: cell size, absorber radiation and interaction lengths, normal vector
      * 
      */
-    void GetEndCapCaloHitProperties(const edm4hep::CalorimeterHit *const pCaloHit, const gear::LayerLayout &layerLayout,
-        PandoraApi::CaloHit::Parameters &caloHitParameters, float &absorberCorrection) const;
+    void GetEndCapCaloHitProperties(const edm4hep::CalorimeterHit *const pCaloHit, const CaloDescriptor &descriptor,
+        const LayerLayoutCache &layerLayout, PandoraApi::CaloHit::Parameters &caloHitParameters, float &absorberCorrection) const;
 
     /**
      *  @brief  Get barrel specific calo hit properties: cell size, absorber radiation and interaction lengths, normal vector
      * 
      */
-    void GetBarrelCaloHitProperties(const edm4hep::CalorimeterHit *const pCaloHit, const gear::LayerLayout &layerLayout,
-        unsigned int barrelSymmetryOrder, float barrelPhi0, unsigned int staveNumber, PandoraApi::CaloHit::Parameters &caloHitParameters,
-        float &absorberCorrection) const;
+    void GetBarrelCaloHitProperties(const edm4hep::CalorimeterHit *const pCaloHit, const CaloDescriptor &descriptor,
+        unsigned int staveNumber, PandoraApi::CaloHit::Parameters &caloHitParameters, float &absorberCorrection) const;
+
+    /**
+     *  @brief  Get the cell normal vector of a barrel stave
+     * 
+     */
+    pandora::CartesianVector GetBarrelNormalVector(unsigned int barrelSymmetryOrder, float barrelPhi0, unsigned int staveNumber) const;
 
     /**
      *  @brief  Get number of active layers from position of a calo hit to the edge of the detector
@@ -184,7 +355,7 @@ private:
      *  @brief  Get the maximum radius of a calo hit in a polygonal detector structure
      * 
      */
-    float GetMaximumRadius(const edm4hep::CalorimeterHit *const pCaloHit, const unsigned int symmetryOrder, const float phi0) const;
+    float GetMaximumRadius(const edm4hep::CalorimeterHit *const pCaloHit, const SymmetryPolygon &symmetryPolygon) const;
 
     /**
      *  @brief  Get the layer coding string from the provided cell id encoding string
@@ -229,6 +400,16 @@ private:
     float                               m_hCalBarrelLayerThickness;         ///< HCal barrel layer thickness
     float                               m_hCalEndCapLayerThickness;         ///< HCal endcap layer thickness
 
+    SymmetryPolygon                     m_hCalBarrelOuterPolygon;           ///< HCal barrel outer polygon
+    SymmetryPolygon                     m_hCalEndCapInnerPolygon;           ///< HCal endcap inner polygon
+
+    CaloDescriptor                      m_eCalDescriptor;                   ///< The ecal description
+    CaloDescriptor                      m_hCalDescriptor;                   ///< The hcal description
+    CaloDescriptor                      m_muonDescriptor;                   ///< The muon description
+    CaloDescriptor                      m_lCalDescriptor;                   ///< The lcal description
+    CaloDescriptor                      m_lHCalDescriptor;                  ///< The lhcal description
+    ECalCalibrationMap                  m_eCalCalibrationMap;               ///< The calibration constants of each ecal collection
+
     CalorimeterHitVector                m_calorimeterHitVector;             ///< The calorimeter hit vector
     std::string                         m_encoder_str;
     std::string                         m_encoder_str_MUON ; 
@@ -251,4 +432,16 @@ inline void CaloHitCreator::Reset()
     m_calorimeterHitVector.clear();
 }
 
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+inline long long CaloHitCreator::CellIDField::Decode(const edm4hep::CalorimeterHit *const pCaloHit) const
+{
+    const long long value((pCaloHit->getCellID() & m_mask) >> m_offset);
+
+    if (m_isSigned && (value & (1LL << (m_width - 1))))
+        return value - (1LL << m_width);
+
+    return value;
+}
+
 #endif // #ifndef CALO_HIT_CREATOR_H
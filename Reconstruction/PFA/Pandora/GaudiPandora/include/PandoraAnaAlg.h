@@ -0,0 +1,75 @@
+#ifndef PandoraAnaAlg_H
+#define PandoraAnaAlg_H
+
+#include "FWCore/DataHandle.h"
+#include "GaudiAlg/GaudiAlgorithm.h"
+#include "edm4hep/ReconstructedParticleCollection.h"
+#include "edm4hep/MCParticleCollection.h"
+#include "edm4hep/MCRecoParticleAssociationCollection.h"
+
+#include "TFile.h"
+#include "TTree.h"
+
+#include <string>
+#include <vector>
+
+
+/**
+ *  @brief  Analysis summary of the pandora output, one tree entry per event.
+ *
+ *  The reconstructed particles and the mc particles are written as columns, and the pfo-mc associations as three match
+ *  columns (reco index, mc index, weight) built in a single pass over the association collection.
+ *  It runs only when added to the algorithm sequence after PandoraPFAlg, so jobs which only need the edm4hep output
+ *  pay nothing for it.
+ */
+class PandoraAnaAlg : public GaudiAlgorithm
+{
+
+public:
+
+  PandoraAnaAlg(const std::string& name, ISvcLocator* svcLoc);
+
+  virtual StatusCode initialize() ;
+
+  virtual StatusCode execute() ;
+
+  virtual StatusCode finalize() ;
+
+protected:
+
+  void Reset();
+
+  int _nEvt ;
+
+  Gaudi::Property< std::string >              m_AnaOutput{ this, "AnaOutput", "Ana.root" };
+
+  TFile* m_fout;
+  TTree* m_tree;
+  std::vector<int  > m_pReco_PID;
+  std::vector<float> m_pReco_mass;
+  std::vector<float> m_pReco_energy;
+  std::vector<float> m_pReco_px;
+  std::vector<float> m_pReco_py;
+  std::vector<float> m_pReco_pz;
+  std::vector<float> m_pReco_charge;
+
+  std::vector<int>   m_mc_p_size;
+  std::vector<int>   m_mc_pid   ;
+  std::vector<float> m_mc_mass  ;
+  std::vector<float> m_mc_px    ;
+  std::vector<float> m_mc_py    ;
+  std::vector<float> m_mc_pz    ;
+  std::vector<float> m_mc_charge;
+  int m_hasConversion;
+
+  std::vector<int>   m_match_reco;    ///< Index of the reconstructed particle of each association
+  std::vector<int>   m_match_mc;      ///< Index of the mc particle of each association, -1 if not in the mc particle collection
+  std::vector<float> m_match_weight;  ///< Weight of each association
+
+  DataHandle<edm4hep::MCParticleCollection>                 m_mcParCol_r  {"MCParticle", Gaudi::DataHandle::Reader, this};
+  DataHandle<edm4hep::ReconstructedParticleCollection>      m_ReconstructedParticleCollection_r {"PandoraPFOs", Gaudi::DataHandle::Reader, this};
+  DataHandle<edm4hep::MCRecoParticleAssociationCollection>  m_MCRecoParticleAssociation_r {"pfoMCRecoParticleAssociation", Gaudi::DataHandle::Reader, this};
+
+};
+
+#endif
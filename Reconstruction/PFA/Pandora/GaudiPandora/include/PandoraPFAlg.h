@@ -35,13 +35,11 @@
 
 #include "CaloHitCreator.h"
 #include "GeometryCreator.h"
-#include "MCParticleCreator.h"
-#include "PfoCreator.h"
 #include "TrackCreator.h"
-
-#include "TROOT.h"
-#include "TTree.h"
-#include "TFile.h"
+#include "PandoraCommon/CollectionMaps.h"
+#include "PandoraCommon/CollectionReader.h"
+#include "PandoraCommon/MCParticleCreator.h"
+#include "PandoraCommon/PfoCreator.h"
 
 
 /* PandoraPFAlg ========== <br>
@@ -50,20 +48,6 @@
 namespace pandora {class Pandora;}
 
 
-class CollectionMaps
-{
-public:
-    CollectionMaps();
-    void clear();
-    std::map<std::string, std::vector<edm4hep::MCParticle> >     collectionMap_MC;
-    std::map<std::string, std::vector<edm4hep::CalorimeterHit> > collectionMap_CaloHit;
-    std::map<std::string, std::vector<edm4hep::Vertex> >         collectionMap_Vertex;
-    std::map<std::string, std::vector<edm4hep::Track> >          collectionMap_Track;
-    std::map<std::string, std::vector<edm4hep::MCRecoCaloAssociation> > collectionMap_CaloRel;
-    std::map<std::string, std::vector<edm4hep::MCRecoTrackerAssociation> > collectionMap_TrkRel;
-};
-
-
 
 class PandoraPFAlg : public GaudiAlgorithm
 {
@@ -117,8 +101,6 @@ public:
      *  @return address of the pandora instance
      */
     const pandora::Pandora *GetPandora() const;
-    StatusCode updateMap();
-    StatusCode Ana();
     StatusCode CreateMCRecoParticleAssociation();
 protected:
  
@@ -235,7 +217,7 @@ protected:
   Gaudi::Property<FloatVector>                m_OutputEnergyCorrectionPoints { this, "OutputEnergyCorrectionPoints", {} };
 
 
-  static pandora::Pandora        *m_pPandora;
+  pandora::Pandora               *m_pPandora;                    ///< The pandora instance owned by this algorithm
   GeometryCreator                *m_pGeometryCreator;             ///< The geometry creator
   CaloHitCreator                 *m_pCaloHitCreator;              ///< The calo hit creator
   TrackCreator                   *m_pTrackCreator;                ///< The track creator
@@ -243,7 +225,8 @@ protected:
   PfoCreator                     *m_pPfoCreator;                  ///< The pfo creator
  
   Settings                        m_settings;                     ///< The settings for the pandora pfa new algo
-  CollectionMaps                  *m_CollectionMaps;               ///< The settings for the pandora pfa new algo
+  CollectionMaps                  *m_CollectionMaps;               ///< The collection maps filled by this algorithm
+  const CollectionMaps            *m_pInput;                      ///< The input of the current event, own or shared
   GeometryCreator::Settings       m_geometryCreatorSettings;      ///< The geometry creator settings
   TrackCreator::Settings          m_trackCreatorSettings;         ///< The track creator settings
   CaloHitCreator::Settings        m_caloHitCreatorSettings;       ///< The calo hit creator settings
@@ -253,32 +236,10 @@ protected:
   std::string                     m_detectorName;                 ///< The detector name
   unsigned int                    m_nRun;                         ///< The run number
   unsigned int                    m_nEvent;                       ///< The event number
-  //### For Ana #################
-  TFile* m_fout;
-  TTree* m_tree;
-  std::vector<int  > m_pReco_PID;    
-  std::vector<float> m_pReco_mass;
-  std::vector<float> m_pReco_energy;
-  std::vector<float> m_pReco_px;
-  std::vector<float> m_pReco_py;
-  std::vector<float> m_pReco_pz;
-  std::vector<float> m_pReco_charge;
-
-  std::vector<int>   m_mc_p_size;
-  std::vector<int>   m_mc_pid   ;
-  std::vector<float> m_mc_mass  ;
-  std::vector<float> m_mc_px    ;
-  std::vector<float> m_mc_py    ;
-  std::vector<float> m_mc_pz    ;
-  std::vector<float> m_mc_charge;
-  int m_hasConversion;
-
-  Gaudi::Property< std::string >              m_AnaOutput{ this, "AnaOutput", "/junofs/users/wxfang/MyGit/CEPCSW/Reconstruction/PFA/Pandora/GaudiPandora/Ana.root" };
-  //######################
-  std::map< std::string, std::string > m_collections;
   Gaudi::Property<std::vector<std::string>> m_readCols{this, "collections", {}, "Places of collections to read"};
- //the map of collection name to its corresponding DataHandle
-  std::map<std::string, DataObjectHandleBase*> m_dataHandles;
+  Gaudi::Property<bool>                     m_UseSharedInput{this, "UseSharedInput", false, "Read the collection maps prepared by PandoraInputAlg instead of the collections"};
+  Gaudi::Property<std::string>              m_SharedInputLocation{this, "ReadCollectionMaps", "PandoraInputMaps", "Event store location of the input collection maps prepared by PandoraInputAlg"};
+  CollectionReader                m_collectionReader;             ///< The reader of the configured collections
   
   DataHandle<edm4hep::MCParticleCollection>     m_mcParCol_r  {"MCParticle", Gaudi::DataHandle::Reader, this};
 
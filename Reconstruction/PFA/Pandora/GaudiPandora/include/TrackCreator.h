@@ -20,13 +20,15 @@
 #include "Api/PandoraApi.h"
 #include "Objects/Helix.h"
 
-namespace gear { class GearMgr; }
+#include "PandoraCommon/CollectionMaps.h"
+
+#include <unordered_map>
 
-class CollectionMaps;
+namespace gear { class GearMgr; }
 
-typedef std::vector<const edm4hep::Track *> TrackVector;
 typedef std::set<unsigned int> TrackList;
 typedef std::map<edm4hep::ConstTrack, int> TrackToPidMap;
+typedef std::unordered_map<unsigned int, const edm4hep::Track *> TrackIdToAddressMap;
 /*
 inline LCCollectionVec *newTrkCol(const std::string &name, LCEvent *evt , bool isSubset)
 {
@@ -50,6 +52,7 @@ class TrackCreator
 {
 public:
     typedef std::vector<double> DoubleVector;
+    typedef std::vector<float> FloatVector;
     typedef std::vector<std::string> StringVector;
 
     /**
@@ -123,7 +126,11 @@ public:
      */
     pandora::StatusCode CreateTrackAssociations(const CollectionMaps& collectionMaps);
 
-    const edm4hep::Track* GetTrackAddress(const CollectionMaps& collectionMaps, const edm4hep::ConstTrack& pTrack );
+    /**
+     *  @brief  Get the address of the stored track corresponding to a track, NULL if it is not in the track collections
+     * 
+     */
+    const edm4hep::Track* GetTrackAddress(const edm4hep::ConstTrack& pTrack ) const;
     /**
      *  @brief  Create tracks, insert user code here
      * 
@@ -143,6 +150,31 @@ public:
     void Reset();
 
 private:
+    /**
+     *  @brief  TrackHitSummary class, the tracker hit positions of a track reduced in a single pass over its hits
+     */
+    class TrackHitSummary
+    {
+    public:
+        /**
+         *  @brief  Default constructor
+         */
+        TrackHitSummary();
+
+        float           m_hitZMin;                              ///< The minimum hit z coordinate
+        float           m_hitZMax;                              ///< The maximum hit z coordinate
+        float           m_hitOuterR;                            ///< The maximum hit radius
+        float           m_hitInnerR;                            ///< The minimum hit radius
+        float           m_hitAbsZMin;                           ///< The minimum hit |z|
+        int             m_maxOccupiedFtdLayer;                  ///< The outermost ftd layer with a hit outside the tpc volume
+    };
+
+    /**
+     *  @brief  Fill the map from track id to the address of the stored track, once per event
+     * 
+     */
+    void FillTrackIdToAddressMap(const CollectionMaps& collectionMaps);
+
     /**
      *  @brief  Extract kink information from specified lcio collections
      * 
@@ -214,7 +246,19 @@ private:
      *  @brief  Decide whether track reaches the ecal surface
      * 
      */
-    void TrackReachesECAL(const edm4hep::Track *const pTrack, PandoraApi::Track::Parameters &trackParameters) const;
+    void TrackReachesECAL(const edm4hep::Track *const pTrack, const TrackHitSummary &hitSummary, PandoraApi::Track::Parameters &trackParameters) const;
+
+    /**
+     *  @brief  Reduce the tracker hits of a track to the extremal positions used by the ecal and pfo usage decisions
+     * 
+     */
+    void SummariseTrackHits(const edm4hep::Track *const pTrack, TrackHitSummary &hitSummary) const;
+
+    /**
+     *  @brief  Get the number of ftd layers crossed by a track of given |tan lambda|
+     * 
+     */
+    int GetNExpectedFtdHits(const float tanLambda) const;
 
     /**
      *  @brief  Determine whether a track can be used to form a pfo under the following conditions:
@@ -222,7 +266,7 @@ private:
      *          2) if the track proves to have no cluster associations
      * 
      */
-    void DefineTrackPfoUsage(const edm4hep::Track *const pTrack, PandoraApi::Track::Parameters &trackParameters) const;
+    void DefineTrackPfoUsage(const edm4hep::Track *const pTrack, const TrackHitSummary &hitSummary, PandoraApi::Track::Parameters &trackParameters) const;
 
     /**
      *  @brief  Whether track passes the quality cuts required in order to be used to form a pfo
@@ -260,12 +304,19 @@ private:
     DoubleVector            m_ftdZPositions;                ///< List of ftd z positions
     unsigned int            m_nFtdLayers;                   ///< Number of ftd layers
     float                   m_tanLambdaFtd;                 ///< Tan lambda for first ftd layer
+    DoubleVector            m_ftdTanLambdaMin;              ///< List of ftd tan lambda at the outer radius, per layer
+    DoubleVector            m_ftdTanLambdaMax;              ///< List of ftd tan lambda at the inner radius, per layer
 
     int               m_eCalBarrelInnerSymmetry;      ///< ECal barrel inner symmetry order
     float             m_eCalBarrelInnerPhi0;          ///< ECal barrel inner phi 0
     float             m_eCalBarrelInnerR;             ///< ECal barrel inner radius
     float             m_eCalEndCapInnerZ;             ///< ECal endcap inner z
 
+    FloatVector       m_eCalBarrelFaceX;              ///< ECal barrel inner face, x coordinate of the face point
+    FloatVector       m_eCalBarrelFaceY;              ///< ECal barrel inner face, y coordinate of the face point
+    FloatVector       m_eCalBarrelFaceDirX;           ///< ECal barrel inner face, x component of the in-plane direction
+    FloatVector       m_eCalBarrelFaceDirY;           ///< ECal barrel inner face, y component of the in-plane direction
+
     float                   m_minEtdZPosition;              ///< Min etd z position
     float                   m_minSetRadius;                 ///< Min set radius
 
@@ -274,6 +325,7 @@ private:
     TrackList               m_parentTrackList;              ///< The list of parent tracks
     TrackList               m_daughterTrackList;            ///< The list of daughter tracks
     TrackToPidMap           m_trackToPidMap;                ///< The map from track addresses to particle ids, where set by kinks/V0s
+    TrackIdToAddressMap     m_trackIdToAddressMap;          ///< The map from track ids to the addresses of the stored tracks
     gear::GearMgr* _GEAR;
 };
 
@@ -293,6 +345,7 @@ inline void TrackCreator::Reset()
     m_parentTrackList.clear();
     m_daughterTrackList.clear();
     m_trackToPidMap.clear();
+    m_trackIdToAddressMap.clear();
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -83,7 +83,114 @@ CaloHitCreator::CaloHitCreator(const Settings &settings, const pandora::Pandora
     if ((m_hCalEndCapLayerThickness < std::numeric_limits<float>::epsilon()) || (m_hCalBarrelLayerThickness < std::numeric_limits<float>::epsilon()))
         throw pandora::StatusCodeException(pandora::STATUS_CODE_INVALID_PARAMETER);
 
+    m_hCalBarrelOuterPolygon = SymmetryPolygon(m_hCalBarrelOuterSymmetry, m_hCalBarrelOuterPhi0);
+    m_hCalEndCapInnerPolygon = SymmetryPolygon(m_settings.m_hCalEndCapInnerSymmetryOrder, m_settings.m_hCalEndCapInnerPhiCoordinate);
 
+    // Compile each calorimeter once, so that hit creation needs no string or gear lookups. A calorimeter missing from the
+    // encoding or the geometry is reported here and stays invalid; its collections are then reported as failures when hits
+    // are created.
+    try
+    {
+        m_eCalDescriptor.m_hitType = pandora::ECAL;
+        m_eCalDescriptor.m_radiationLength = m_settings.m_absorberRadLengthECal;
+        m_eCalDescriptor.m_interactionLength = m_settings.m_absorberIntLengthECal;
+        this->CompileCellIDFields(m_encoder_str, true, m_eCalDescriptor);
+        m_eCalDescriptor.m_endCapLayout = LayerLayoutCache(_GEAR->getEcalEndcapParameters().getLayerLayout());
+        m_eCalDescriptor.m_barrelLayout = LayerLayoutCache(_GEAR->getEcalBarrelParameters().getLayerLayout());
+        this->CompileBarrelSymmetry(m_eCalBarrelInnerSymmetry, m_eCalBarrelInnerPhi0, m_eCalDescriptor);
+        m_eCalDescriptor.m_isValid = true;
+    }
+    catch (gear::Exception &exception)
+    {
+        this->ReportUnavailableCalorimeter("ECal", exception.what());
+    }
+    catch (lcio::Exception &exception)
+    {
+        this->ReportUnavailableCalorimeter("ECal", exception.what());
+    }
+
+    try
+    {
+        m_hCalDescriptor.m_hitType = pandora::HCAL;
+        m_hCalDescriptor.m_radiationLength = m_settings.m_absorberRadLengthHCal;
+        m_hCalDescriptor.m_interactionLength = m_settings.m_absorberIntLengthHCal;
+        this->CompileCellIDFields(m_encoder_str, true, m_hCalDescriptor);
+        m_hCalDescriptor.m_endCapLayout = LayerLayoutCache(hCalEndCapLayerLayout);
+        m_hCalDescriptor.m_barrelLayout = LayerLayoutCache(hCalBarrelLayerLayout);
+        this->CompileBarrelSymmetry(m_hCalBarrelInnerSymmetry, m_hCalBarrelInnerPhi0, m_hCalDescriptor);
+        m_hCalDescriptor.m_isValid = true;
+    }
+    catch (gear::Exception &exception)
+    {
+        this->ReportUnavailableCalorimeter("HCal", exception.what());
+    }
+    catch (lcio::Exception &exception)
+    {
+        this->ReportUnavailableCalorimeter("HCal", exception.what());
+    }
+
+    try
+    {
+        m_muonDescriptor.m_hitType = pandora::MUON;
+        m_muonDescriptor.m_radiationLength = m_settings.m_absorberRadLengthOther;
+        m_muonDescriptor.m_interactionLength = m_settings.m_absorberIntLengthOther;
+        this->CompileCellIDFields(m_encoder_str_MUON, true, m_muonDescriptor);
+        m_muonDescriptor.m_endCapLayout = LayerLayoutCache(_GEAR->getYokeEndcapParameters().getLayerLayout());
+        m_muonDescriptor.m_barrelLayout = LayerLayoutCache(_GEAR->getYokeBarrelParameters().getLayerLayout());
+        m_muonDescriptor.m_plugLayout = LayerLayoutCache(_GEAR->getYokePlugParameters().getLayerLayout());
+        this->CompileBarrelSymmetry(m_muonBarrelInnerSymmetry, m_muonBarrelInnerPhi0, m_muonDescriptor);
+        m_muonDescriptor.m_isValid = true;
+    }
+    catch (gear::Exception &exception)
+    {
+        this->ReportUnavailableCalorimeter("Muon", exception.what());
+    }
+    catch (lcio::Exception &exception)
+    {
+        this->ReportUnavailableCalorimeter("Muon", exception.what());
+    }
+
+    try
+    {
+        m_lCalDescriptor.m_hitType = pandora::ECAL;
+        m_lCalDescriptor.m_radiationLength = m_settings.m_absorberRadLengthECal;
+        m_lCalDescriptor.m_interactionLength = m_settings.m_absorberIntLengthECal;
+        this->CompileCellIDFields(m_encoder_str_LCal, false, m_lCalDescriptor);
+        m_lCalDescriptor.m_endCapLayout = LayerLayoutCache(_GEAR->getLcalParameters().getLayerLayout());
+        m_lCalDescriptor.m_isValid = true;
+    }
+    catch (gear::Exception &exception)
+    {
+        this->ReportUnavailableCalorimeter("LCal", exception.what());
+    }
+    catch (lcio::Exception &exception)
+    {
+        this->ReportUnavailableCalorimeter("LCal", exception.what());
+    }
+
+    try
+    {
+        m_lHCalDescriptor.m_hitType = pandora::HCAL;
+        m_lHCalDescriptor.m_radiationLength = m_settings.m_absorberRadLengthHCal;
+        m_lHCalDescriptor.m_interactionLength = m_settings.m_absorberIntLengthHCal;
+        this->CompileCellIDFields(m_encoder_str_LHCal, false, m_lHCalDescriptor);
+        m_lHCalDescriptor.m_endCapLayout = LayerLayoutCache(_GEAR->getLHcalParameters().getLayerLayout());
+        m_lHCalDescriptor.m_isValid = true;
+    }
+    catch (gear::Exception &exception)
+    {
+        this->ReportUnavailableCalorimeter("LHCal", exception.what());
+    }
+    catch (lcio::Exception &exception)
+    {
+        this->ReportUnavailableCalorimeter("LHCal", exception.what());
+    }
+
+    for (StringVector::const_iterator iter = m_settings.m_eCalCaloHitCollections.begin(), iterEnd = m_settings.m_eCalCaloHitCollections.end();
+        iter != iterEnd; ++iter)
+    {
+        m_eCalCalibrationMap[*iter] = this->GetECalCalibration(*iter);
+    }
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -94,6 +201,85 @@ CaloHitCreator::~CaloHitCreator()
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+void CaloHitCreator::CompileCellIDFields(const std::string &encodingString, const bool decodeStave, CaloDescriptor &descriptor) const
+{
+    descriptor.m_layerField = CellIDField(encodingString, this->GetLayerCoding(encodingString));
+
+    // Only barrel hits need the stave, so an encoding without one still serves the endcaps
+    const std::string staveCoding(this->GetStaveCoding(encodingString));
+    descriptor.m_hasStaveField = decodeStave && ("unknown_stave_encoding" != staveCoding);
+
+    if (descriptor.m_hasStaveField)
+        descriptor.m_staveField = CellIDField(encodingString, staveCoding);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void CaloHitCreator::ReportUnavailableCalorimeter(const std::string &detectorName, const char *const message) const
+{
+    std::cout << "CaloHitCreator: " << detectorName << " encoding or geometry unavailable, no " << detectorName << " hits will be created: "
+              << message << std::endl;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void CaloHitCreator::CompileBarrelSymmetry(const unsigned int barrelSymmetryOrder, const float barrelPhi0, CaloDescriptor &descriptor) const
+{
+    descriptor.m_barrelSymmetryOrder = barrelSymmetryOrder;
+    descriptor.m_barrelPhi0 = barrelPhi0;
+    descriptor.m_barrelNormals.clear();
+
+    if (barrelSymmetryOrder <= 2)
+        return;
+
+    // Stave numbers run up to the symmetry order included (hcal staves are counted backwards from it)
+    for (unsigned int staveNumber = 0; staveNumber <= barrelSymmetryOrder; ++staveNumber)
+        descriptor.m_barrelNormals.push_back(this->GetBarrelNormalVector(barrelSymmetryOrder, barrelPhi0, staveNumber));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+CaloHitCreator::ECalCalibration CaloHitCreator::GetECalCalibration(const std::string &collectionName) const
+{
+    ECalCalibration calibration;
+    calibration.m_eCalToMip = m_settings.m_eCalToMip;
+    calibration.m_eCalMipThreshold = m_settings.m_eCalMipThreshold;
+    calibration.m_eCalToEMGeV = m_settings.m_eCalToEMGeV;
+    calibration.m_eCalToHadGeVBarrel = m_settings.m_eCalToHadGeVBarrel;
+    calibration.m_eCalToHadGeVEndCap = m_settings.m_eCalToHadGeVEndCap;
+
+    // Hybrid ECAL including pure ScECAL.
+    if (m_settings.m_useEcalScLayers)
+    {
+        std::string lowerCaseName(collectionName);
+        std::transform(lowerCaseName.begin(), lowerCaseName.end(), lowerCaseName.begin(), ::tolower);
+
+        if (lowerCaseName.find("ecal", 0) == std::string::npos)
+            std::cout << "WARNING: mismatching hybrid Ecal collection name. " << lowerCaseName << std::endl;
+
+        if (lowerCaseName.find("si", 0) != std::string::npos)
+        {
+             calibration.m_eCalToMip = m_settings.m_eCalSiToMip;
+             calibration.m_eCalMipThreshold = m_settings.m_eCalSiMipThreshold;
+             calibration.m_eCalToEMGeV = m_settings.m_eCalSiToEMGeV;
+             calibration.m_eCalToHadGeVBarrel = m_settings.m_eCalSiToHadGeVBarrel;
+             calibration.m_eCalToHadGeVEndCap = m_settings.m_eCalSiToHadGeVEndCap;
+        }
+        else if (lowerCaseName.find("sc", 0) != std::string::npos)
+        {
+             calibration.m_eCalToMip = m_settings.m_eCalScToMip;
+             calibration.m_eCalMipThreshold = m_settings.m_eCalScMipThreshold;
+             calibration.m_eCalToEMGeV = m_settings.m_eCalScToEMGeV;
+             calibration.m_eCalToHadGeVBarrel = m_settings.m_eCalScToHadGeVBarrel;
+             calibration.m_eCalToHadGeVEndCap = m_settings.m_eCalScToHadGeVEndCap;
+        }
+    }
+
+    return calibration;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 pandora::StatusCode CaloHitCreator::CreateCaloHits(const CollectionMaps& collectionMaps)
 {
     
@@ -122,13 +308,14 @@ pandora::StatusCode CaloHitCreator::CreateECalCaloHits(const CollectionMaps& col
             if (0 == nElements)
                 continue;
 
-            const gear::LayerLayout &endcapLayerLayout(_GEAR->getEcalEndcapParameters().getLayerLayout());
-            const gear::LayerLayout &barrelLayerLayout(_GEAR->getEcalBarrelParameters().getLayerLayout()); 
+            const CaloDescriptor &descriptor(m_eCalDescriptor);
 
-            ID_UTIL::CellIDDecoder<const edm4hep::CalorimeterHit> cellIdDecoder(m_encoder_str);
-            const std::string layerCodingString(m_encoder_str);
-            const std::string layerCoding(this->GetLayerCoding(layerCodingString));
-            const std::string staveCoding(this->GetStaveCoding(layerCodingString));
+            if (!descriptor.m_isValid)
+                throw ("CreateECalCaloHits ecal encoding or geometry unavailable");
+
+            const ECalCalibration &calibration(m_eCalCalibrationMap.find(*iter)->second);
+            const float eCalToMip(calibration.m_eCalToMip), eCalMipThreshold(calibration.m_eCalMipThreshold), eCalToEMGeV(calibration.m_eCalToEMGeV),
+                eCalToHadGeVBarrel(calibration.m_eCalToHadGeVBarrel), eCalToHadGeVEndCap(calibration.m_eCalToHadGeVEndCap);
 
             for (int i = 0; i < nElements; ++i)
             {
@@ -140,40 +327,10 @@ pandora::StatusCode CaloHitCreator::CreateECalCaloHits(const CollectionMaps& col
                     if (NULL == pCaloHit)
                         throw ("CreateECalCaloHits pCaloHit Collection type mismatch");
 
-                    float eCalToMip(m_settings.m_eCalToMip), eCalMipThreshold(m_settings.m_eCalMipThreshold), eCalToEMGeV(m_settings.m_eCalToEMGeV),
-                        eCalToHadGeVBarrel(m_settings.m_eCalToHadGeVBarrel), eCalToHadGeVEndCap(m_settings.m_eCalToHadGeVEndCap);
-
-                    // Hybrid ECAL including pure ScECAL.
-                    if (m_settings.m_useEcalScLayers)
-                    {
-                        std::string collectionName(*iter);
-                        std::transform(collectionName.begin(), collectionName.end(), collectionName.begin(), ::tolower);
-
-                        if (collectionName.find("ecal", 0) == std::string::npos)
-                            std::cout << "WARNING: mismatching hybrid Ecal collection name. " << collectionName << std::endl;
-
-                        if (collectionName.find("si", 0) != std::string::npos)
-                        {
-                             eCalToMip = m_settings.m_eCalSiToMip;
-                             eCalMipThreshold = m_settings.m_eCalSiMipThreshold;
-                             eCalToEMGeV = m_settings.m_eCalSiToEMGeV;
-                             eCalToHadGeVBarrel = m_settings.m_eCalSiToHadGeVBarrel;
-                             eCalToHadGeVEndCap = m_settings.m_eCalSiToHadGeVEndCap;
-                        }
-                        else if (collectionName.find("sc", 0) != std::string::npos)
-                        {
-                             eCalToMip = m_settings.m_eCalScToMip;
-                             eCalMipThreshold = m_settings.m_eCalScMipThreshold;
-                             eCalToEMGeV = m_settings.m_eCalScToEMGeV;
-                             eCalToHadGeVBarrel = m_settings.m_eCalScToHadGeVBarrel;
-                             eCalToHadGeVEndCap = m_settings.m_eCalScToHadGeVEndCap;
-                        }
-                    }
-
                     PandoraApi::CaloHit::Parameters caloHitParameters;
-                    caloHitParameters.m_hitType = pandora::ECAL;
+                    caloHitParameters.m_hitType = descriptor.m_hitType;
                     caloHitParameters.m_isDigital = false;
-                    caloHitParameters.m_layer = cellIdDecoder(pCaloHit)[layerCoding.c_str()] + 1;
+                    caloHitParameters.m_layer = descriptor.m_layerField.Decode(pCaloHit) + 1;
                     caloHitParameters.m_isInOuterSamplingLayer = false;
                     this->GetCommonCaloHitProperties(pCaloHit, caloHitParameters);
 
@@ -181,14 +338,17 @@ pandora::StatusCode CaloHitCreator::CreateECalCaloHits(const CollectionMaps& col
 
                     if (std::fabs(pCaloHit->getPosition()[2]) < m_eCalBarrelOuterZ)
                     {
-                        this->GetBarrelCaloHitProperties(pCaloHit, barrelLayerLayout, m_eCalBarrelInnerSymmetry, m_eCalBarrelInnerPhi0,
-                            cellIdDecoder(pCaloHit)[ staveCoding], caloHitParameters, absorberCorrection);
+                        if (!descriptor.m_hasStaveField)
+                            throw ("CreateECalCaloHits barrel hit without a stave field in the encoding");
+
+                        this->GetBarrelCaloHitProperties(pCaloHit, descriptor, descriptor.m_staveField.Decode(pCaloHit), caloHitParameters,
+                            absorberCorrection);
 
                         caloHitParameters.m_hadronicEnergy = eCalToHadGeVBarrel * pCaloHit->getEnergy();
                     }
                     else
                     {
-                        this->GetEndCapCaloHitProperties(pCaloHit, endcapLayerLayout, caloHitParameters, absorberCorrection);
+                        this->GetEndCapCaloHitProperties(pCaloHit, descriptor, descriptor.m_endCapLayout, caloHitParameters, absorberCorrection);
                         caloHitParameters.m_hadronicEnergy = eCalToHadGeVEndCap * pCaloHit->getEnergy();
                     }
 
@@ -246,13 +406,10 @@ pandora::StatusCode CaloHitCreator::CreateHCalCaloHits(const CollectionMaps& col
             if (0 == nElements)
                 continue;
 
-            const gear::LayerLayout &endcapLayerLayout(_GEAR->getHcalEndcapParameters().getLayerLayout());
-            const gear::LayerLayout &barrelLayerLayout(_GEAR->getHcalBarrelParameters().getLayerLayout());
+            const CaloDescriptor &descriptor(m_hCalDescriptor);
 
-            ID_UTIL::CellIDDecoder<const edm4hep::CalorimeterHit> cellIdDecoder(m_encoder_str);
-            const std::string layerCodingString(m_encoder_str);
-            const std::string layerCoding(this->GetLayerCoding(layerCodingString));
-            const std::string staveCoding(this->GetStaveCoding(layerCodingString));
+            if (!descriptor.m_isValid)
+                throw ("CreateHCalCaloHits hcal encoding or geometry unavailable");
 
             for (int i = 0; i < nElements; ++i)
             {
@@ -265,9 +422,9 @@ pandora::StatusCode CaloHitCreator::CreateHCalCaloHits(const CollectionMaps& col
                         throw ("CreateHCalCaloHits Collection type mismatch");
 
                     PandoraApi::CaloHit::Parameters caloHitParameters;
-                    caloHitParameters.m_hitType = pandora::HCAL;
+                    caloHitParameters.m_hitType = descriptor.m_hitType;
                     caloHitParameters.m_isDigital = false;
-                    caloHitParameters.m_layer = cellIdDecoder(pCaloHit)[layerCoding.c_str()];
+                    caloHitParameters.m_layer = descriptor.m_layerField.Decode(pCaloHit);
                     caloHitParameters.m_isInOuterSamplingLayer = (this->GetNLayersFromEdge(pCaloHit) <= m_settings.m_nOuterSamplingLayers);
                     this->GetCommonCaloHitProperties(pCaloHit, caloHitParameters);
 
@@ -275,12 +432,15 @@ pandora::StatusCode CaloHitCreator::CreateHCalCaloHits(const CollectionMaps& col
 
                     if (std::fabs(pCaloHit->getPosition()[2]) < m_hCalBarrelOuterZ)
                     {
-                        this->GetBarrelCaloHitProperties(pCaloHit, barrelLayerLayout, m_hCalBarrelInnerSymmetry, m_hCalBarrelInnerPhi0,
-                            m_hCalBarrelInnerSymmetry - int(cellIdDecoder(pCaloHit)[ staveCoding] / 2), caloHitParameters, absorberCorrection);
+                        if (!descriptor.m_hasStaveField)
+                            throw ("CreateHCalCaloHits barrel hit without a stave field in the encoding");
+
+                        this->GetBarrelCaloHitProperties(pCaloHit, descriptor, m_hCalBarrelInnerSymmetry - int(descriptor.m_staveField.Decode(pCaloHit) / 2),
+                            caloHitParameters, absorberCorrection);
                     }
                     else
                     {
-                        this->GetEndCapCaloHitProperties(pCaloHit, endcapLayerLayout, caloHitParameters, absorberCorrection);
+                        this->GetEndCapCaloHitProperties(pCaloHit, descriptor, descriptor.m_endCapLayout, caloHitParameters, absorberCorrection);
                     }
 
                     //caloHitParameters.m_mipEquivalentEnergy = pCaloHit->getEnergy() * m_settings.m_hCalToMip * absorberCorrection;
@@ -330,14 +490,10 @@ pandora::StatusCode CaloHitCreator::CreateMuonCaloHits(const CollectionMaps& col
             if (0 == nElements)
                 continue;
 
-            const gear::LayerLayout &endcapLayerLayout(_GEAR->getYokeEndcapParameters().getLayerLayout());
-            const gear::LayerLayout &barrelLayerLayout(_GEAR->getYokeBarrelParameters().getLayerLayout()); 
-            const gear::LayerLayout &plugLayerLayout(_GEAR->getYokePlugParameters().getLayerLayout());
+            const CaloDescriptor &descriptor(m_muonDescriptor);
 
-            ID_UTIL::CellIDDecoder<const edm4hep::CalorimeterHit> cellIdDecoder(m_encoder_str_MUON);
-            const std::string layerCodingString(m_encoder_str_MUON);
-            const std::string layerCoding(this->GetLayerCoding(layerCodingString));
-            const std::string staveCoding(this->GetStaveCoding(layerCodingString));
+            if (!descriptor.m_isValid)
+                throw ("CreateMuonCaloHits muon encoding or geometry unavailable");
 
             for (int i = 0; i < nElements; ++i)
             {
@@ -350,8 +506,8 @@ pandora::StatusCode CaloHitCreator::CreateMuonCaloHits(const CollectionMaps& col
                         throw ("Muon Collection type mismatch");
 
                     PandoraApi::CaloHit::Parameters caloHitParameters;
-                    caloHitParameters.m_hitType = pandora::MUON;
-                    caloHitParameters.m_layer = cellIdDecoder(pCaloHit)[layerCoding.c_str()] + 1;
+                    caloHitParameters.m_hitType = descriptor.m_hitType;
+                    caloHitParameters.m_layer = descriptor.m_layerField.Decode(pCaloHit) + 1;
                     caloHitParameters.m_isInOuterSamplingLayer = true;
                     this->GetCommonCaloHitProperties(pCaloHit, caloHitParameters);
 
@@ -365,16 +521,19 @@ pandora::StatusCode CaloHitCreator::CreateMuonCaloHits(const CollectionMaps& col
 
                     if (isInBarrelRegion && isWithinCoil)
                     {
-                        this->GetEndCapCaloHitProperties(pCaloHit, plugLayerLayout, caloHitParameters, absorberCorrection);
+                        this->GetEndCapCaloHitProperties(pCaloHit, descriptor, descriptor.m_plugLayout, caloHitParameters, absorberCorrection);
                     }
                     else if (isInBarrelRegion)
                     {
-                        this->GetBarrelCaloHitProperties(pCaloHit, barrelLayerLayout, m_muonBarrelInnerSymmetry, m_muonBarrelInnerPhi0,
-                            cellIdDecoder(pCaloHit)[ staveCoding ], caloHitParameters, absorberCorrection);
+                        if (!descriptor.m_hasStaveField)
+                            throw ("CreateMuonCaloHits barrel hit without a stave field in the encoding");
+
+                        this->GetBarrelCaloHitProperties(pCaloHit, descriptor, descriptor.m_staveField.Decode(pCaloHit), caloHitParameters,
+                            absorberCorrection);
                     }
                     else
                     {
-                        this->GetEndCapCaloHitProperties(pCaloHit, endcapLayerLayout, caloHitParameters, absorberCorrection);
+                        this->GetEndCapCaloHitProperties(pCaloHit, descriptor, descriptor.m_endCapLayout, caloHitParameters, absorberCorrection);
                     }
 
                     if (m_settings.m_muonDigitalHits > 0)
@@ -432,11 +591,10 @@ pandora::StatusCode CaloHitCreator::CreateLCalCaloHits(const CollectionMaps& col
             if (0 == nElements)
                 continue;
 
-            const gear::LayerLayout &endcapLayerLayout(_GEAR->getLcalParameters().getLayerLayout()); 
+            const CaloDescriptor &descriptor(m_lCalDescriptor);
 
-            ID_UTIL::CellIDDecoder<const edm4hep::CalorimeterHit> cellIdDecoder(m_encoder_str_LCal);
-            const std::string layerCodingString(m_encoder_str_LCal);
-            const std::string layerCoding(this->GetLayerCoding(layerCodingString));
+            if (!descriptor.m_isValid)
+                throw ("CreateLCalCaloHits lcal encoding or geometry unavailable");
 
             for (int i = 0; i < nElements; ++i)
             {
@@ -449,14 +607,14 @@ pandora::StatusCode CaloHitCreator::CreateLCalCaloHits(const CollectionMaps& col
                         throw ("LCal Collection type mismatch");
 
                     PandoraApi::CaloHit::Parameters caloHitParameters;
-                    caloHitParameters.m_hitType = pandora::ECAL;
+                    caloHitParameters.m_hitType = descriptor.m_hitType;
                     caloHitParameters.m_isDigital = false;
-                    caloHitParameters.m_layer = cellIdDecoder(pCaloHit)[layerCoding.c_str()];
+                    caloHitParameters.m_layer = descriptor.m_layerField.Decode(pCaloHit);
                     caloHitParameters.m_isInOuterSamplingLayer = false;
                     this->GetCommonCaloHitProperties(pCaloHit, caloHitParameters);
 
                     float absorberCorrection(1.);
-                    this->GetEndCapCaloHitProperties(pCaloHit, endcapLayerLayout, caloHitParameters, absorberCorrection);
+                    this->GetEndCapCaloHitProperties(pCaloHit, descriptor, descriptor.m_endCapLayout, caloHitParameters, absorberCorrection);
 
                     //caloHitParameters.m_mipEquivalentEnergy = pCaloHit->getEnergy() * m_settings.m_eCalToMip * absorberCorrection;
                     caloHitParameters.m_mipEquivalentEnergy = pCaloHit->getEnergy() * m_settings.m_eCalToMip;
@@ -505,11 +663,10 @@ pandora::StatusCode CaloHitCreator::CreateLHCalCaloHits(const CollectionMaps& co
             if (0 == nElements)
                 continue;
 
-            const gear::LayerLayout &endcapLayerLayout(_GEAR->getLHcalParameters().getLayerLayout());
+            const CaloDescriptor &descriptor(m_lHCalDescriptor);
 
-            ID_UTIL::CellIDDecoder<const edm4hep::CalorimeterHit> cellIdDecoder(m_encoder_str_LHCal);
-            const std::string layerCodingString(m_encoder_str_LHCal);
-            const std::string layerCoding(this->GetLayerCoding(layerCodingString));
+            if (!descriptor.m_isValid)
+                throw ("CreateLHCalCaloHits lhcal encoding or geometry unavailable");
 
             for (int i = 0; i < nElements; ++i)
             {
@@ -522,14 +679,14 @@ pandora::StatusCode CaloHitCreator::CreateLHCalCaloHits(const CollectionMaps& co
                         throw ("LHCal Collection type mismatch");
 
                     PandoraApi::CaloHit::Parameters caloHitParameters;
-                    caloHitParameters.m_hitType = pandora::HCAL;
+                    caloHitParameters.m_hitType = descriptor.m_hitType;
                     caloHitParameters.m_isDigital = false;
-                    caloHitParameters.m_layer = cellIdDecoder(pCaloHit)[layerCoding.c_str()];
+                    caloHitParameters.m_layer = descriptor.m_layerField.Decode(pCaloHit);
                     caloHitParameters.m_isInOuterSamplingLayer = (this->GetNLayersFromEdge(pCaloHit) <= m_settings.m_nOuterSamplingLayers);
                     this->GetCommonCaloHitProperties(pCaloHit, caloHitParameters);
 
                     float absorberCorrection(1.);
-                    this->GetEndCapCaloHitProperties(pCaloHit, endcapLayerLayout, caloHitParameters, absorberCorrection);
+                    this->GetEndCapCaloHitProperties(pCaloHit, descriptor, descriptor.m_endCapLayout, caloHitParameters, absorberCorrection);
 
                     //caloHitParameters.m_mipEquivalentEnergy = pCaloHit->getEnergy() * m_settings.m_hCalToMip * absorberCorrection;
                     caloHitParameters.m_mipEquivalentEnergy = pCaloHit->getEnergy() * m_settings.m_hCalToMip;
@@ -579,24 +736,19 @@ void CaloHitCreator::GetCommonCaloHitProperties(const edm4hep::CalorimeterHit *c
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-void CaloHitCreator::GetEndCapCaloHitProperties(const edm4hep::CalorimeterHit *const pCaloHit, const gear::LayerLayout &layerLayout,
-    PandoraApi::CaloHit::Parameters &caloHitParameters, float &absorberCorrection) const
+void CaloHitCreator::GetEndCapCaloHitProperties(const edm4hep::CalorimeterHit *const pCaloHit, const CaloDescriptor &descriptor,
+    const LayerLayoutCache &layerLayout, PandoraApi::CaloHit::Parameters &caloHitParameters, float &absorberCorrection) const
 {
     caloHitParameters.m_hitRegion = pandora::ENDCAP;
 
-    const int physicalLayer(std::min(static_cast<int>(caloHitParameters.m_layer.Get()), layerLayout.getNLayers() - 1));
-    caloHitParameters.m_cellSize0 = layerLayout.getCellSize0(physicalLayer);
-    caloHitParameters.m_cellSize1 = layerLayout.getCellSize1(physicalLayer);
-    caloHitParameters.m_cellThickness = layerLayout.getThickness(physicalLayer);
+    const int physicalLayer(std::min(static_cast<int>(caloHitParameters.m_layer.Get()), layerLayout.m_nLayers - 1));
+    caloHitParameters.m_cellSize0 = layerLayout.m_cellSize0.at(physicalLayer);
+    caloHitParameters.m_cellSize1 = layerLayout.m_cellSize1.at(physicalLayer);
+    caloHitParameters.m_cellThickness = layerLayout.m_thickness.at(physicalLayer);
 
-    const float radiationLength((pandora::ECAL == caloHitParameters.m_hitType.Get()) ? m_settings.m_absorberRadLengthECal :
-        (pandora::HCAL == caloHitParameters.m_hitType.Get()) ? m_settings.m_absorberRadLengthHCal : m_settings.m_absorberRadLengthOther);
-    const float interactionLength((pandora::ECAL == caloHitParameters.m_hitType.Get()) ? m_settings.m_absorberIntLengthECal :
-        (pandora::HCAL == caloHitParameters.m_hitType.Get()) ? m_settings.m_absorberIntLengthHCal : m_settings.m_absorberIntLengthOther);
-
-    const float layerAbsorberThickness(layerLayout.getAbsorberThickness(physicalLayer));
-    caloHitParameters.m_nCellRadiationLengths = radiationLength * layerAbsorberThickness;
-    caloHitParameters.m_nCellInteractionLengths = interactionLength * layerAbsorberThickness;
+    const float layerAbsorberThickness(layerLayout.m_absorberThickness.at(physicalLayer));
+    caloHitParameters.m_nCellRadiationLengths = descriptor.m_radiationLength * layerAbsorberThickness;
+    caloHitParameters.m_nCellInteractionLengths = descriptor.m_interactionLength * layerAbsorberThickness;
 
     if (caloHitParameters.m_nCellRadiationLengths.Get() < std::numeric_limits<float>::epsilon() || caloHitParameters.m_nCellInteractionLengths.Get() < std::numeric_limits<float>::epsilon())
     {
@@ -606,18 +758,9 @@ void CaloHitCreator::GetEndCapCaloHitProperties(const edm4hep::CalorimeterHit *c
     }
 
     absorberCorrection = 1.;
-    for (unsigned int i = 0, iMax = layerLayout.getNLayers(); i < iMax; ++i)
-    {
-        const float absorberThickness(layerLayout.getAbsorberThickness(i));
 
-        if (absorberThickness < std::numeric_limits<float>::epsilon())
-            continue;
-
-        if (layerAbsorberThickness > std::numeric_limits<float>::epsilon())
-            absorberCorrection = absorberThickness / layerAbsorberThickness;
-
-        break;
-    }
+    if ((layerLayout.m_firstAbsorberThickness > 0.f) && (layerAbsorberThickness > std::numeric_limits<float>::epsilon()))
+        absorberCorrection = layerLayout.m_firstAbsorberThickness / layerAbsorberThickness;
 
     caloHitParameters.m_cellNormalVector = (pCaloHit->getPosition()[2] > 0) ? pandora::CartesianVector(0, 0, 1) :
         pandora::CartesianVector(0, 0, -1);
@@ -625,25 +768,20 @@ void CaloHitCreator::GetEndCapCaloHitProperties(const edm4hep::CalorimeterHit *c
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-void CaloHitCreator::GetBarrelCaloHitProperties(const edm4hep::CalorimeterHit *const pCaloHit, const gear::LayerLayout &layerLayout,
-    unsigned int barrelSymmetryOrder, float barrelPhi0, unsigned int staveNumber, PandoraApi::CaloHit::Parameters &caloHitParameters,
-    float &absorberCorrection) const
+void CaloHitCreator::GetBarrelCaloHitProperties(const edm4hep::CalorimeterHit *const pCaloHit, const CaloDescriptor &descriptor,
+    unsigned int staveNumber, PandoraApi::CaloHit::Parameters &caloHitParameters, float &absorberCorrection) const
 {
     caloHitParameters.m_hitRegion = pandora::BARREL;
 
-    const int physicalLayer(std::min(static_cast<int>(caloHitParameters.m_layer.Get()), layerLayout.getNLayers() - 1));
-    caloHitParameters.m_cellSize0 = layerLayout.getCellSize0(physicalLayer);
-    caloHitParameters.m_cellSize1 = layerLayout.getCellSize1(physicalLayer);
-    caloHitParameters.m_cellThickness = layerLayout.getThickness(physicalLayer);
+    const LayerLayoutCache &layerLayout(descriptor.m_barrelLayout);
+    const int physicalLayer(std::min(static_cast<int>(caloHitParameters.m_layer.Get()), layerLayout.m_nLayers - 1));
+    caloHitParameters.m_cellSize0 = layerLayout.m_cellSize0.at(physicalLayer);
+    caloHitParameters.m_cellSize1 = layerLayout.m_cellSize1.at(physicalLayer);
+    caloHitParameters.m_cellThickness = layerLayout.m_thickness.at(physicalLayer);
 
-    const float radiationLength((pandora::ECAL == caloHitParameters.m_hitType.Get()) ? m_settings.m_absorberRadLengthECal :
-        (pandora::HCAL == caloHitParameters.m_hitType.Get()) ? m_settings.m_absorberRadLengthHCal : m_settings.m_absorberRadLengthOther);
-    const float interactionLength((pandora::ECAL == caloHitParameters.m_hitType.Get()) ? m_settings.m_absorberIntLengthECal :
-        (pandora::HCAL == caloHitParameters.m_hitType.Get()) ? m_settings.m_absorberIntLengthHCal : m_settings.m_absorberIntLengthOther);
-
-    const float layerAbsorberThickness(layerLayout.getAbsorberThickness(physicalLayer));
-    caloHitParameters.m_nCellRadiationLengths = radiationLength * layerAbsorberThickness;
-    caloHitParameters.m_nCellInteractionLengths = interactionLength * layerAbsorberThickness;
+    const float layerAbsorberThickness(layerLayout.m_absorberThickness.at(physicalLayer));
+    caloHitParameters.m_nCellRadiationLengths = descriptor.m_radiationLength * layerAbsorberThickness;
+    caloHitParameters.m_nCellInteractionLengths = descriptor.m_interactionLength * layerAbsorberThickness;
 
     if (caloHitParameters.m_nCellRadiationLengths.Get() < std::numeric_limits<float>::epsilon() || caloHitParameters.m_nCellInteractionLengths.Get() < std::numeric_limits<float>::epsilon())
     {
@@ -653,23 +791,14 @@ void CaloHitCreator::GetBarrelCaloHitProperties(const edm4hep::CalorimeterHit *c
     }
 
     absorberCorrection = 1.;
-    for (unsigned int i = 0, iMax = layerLayout.getNLayers(); i < iMax; ++i)
-    {
-        const float absorberThickness(layerLayout.getAbsorberThickness(i));
-
-        if (absorberThickness < std::numeric_limits<float>::epsilon())
-            continue;
 
-        if (layerAbsorberThickness > std::numeric_limits<float>::epsilon())
-            absorberCorrection = absorberThickness / layerAbsorberThickness;
+    if ((layerLayout.m_firstAbsorberThickness > 0.f) && (layerAbsorberThickness > std::numeric_limits<float>::epsilon()))
+        absorberCorrection = layerLayout.m_firstAbsorberThickness / layerAbsorberThickness;
 
-        break;
-    }
-
-    if (barrelSymmetryOrder > 2)
+    if (descriptor.m_barrelSymmetryOrder > 2)
     {
-        const float phi = barrelPhi0 + (2. * M_PI * static_cast<float>(staveNumber) / static_cast<float>(barrelSymmetryOrder));
-        caloHitParameters.m_cellNormalVector = pandora::CartesianVector(-std::sin(phi), std::cos(phi), 0);
+        caloHitParameters.m_cellNormalVector = (staveNumber < descriptor.m_barrelNormals.size()) ? descriptor.m_barrelNormals[staveNumber] :
+            this->GetBarrelNormalVector(descriptor.m_barrelSymmetryOrder, descriptor.m_barrelPhi0, staveNumber);
     }
     else
     {
@@ -677,7 +806,7 @@ void CaloHitCreator::GetBarrelCaloHitProperties(const edm4hep::CalorimeterHit *c
 
         if (pCaloHitPosition[1] != 0)
         {
-            const float phi = barrelPhi0 + std::atan(pCaloHitPosition[0] / pCaloHitPosition[1]);
+            const float phi = descriptor.m_barrelPhi0 + std::atan(pCaloHitPosition[0] / pCaloHitPosition[1]);
             caloHitParameters.m_cellNormalVector = pandora::CartesianVector(std::sin(phi), std::cos(phi), 0);
         }
         else
@@ -690,11 +819,19 @@ void CaloHitCreator::GetBarrelCaloHitProperties(const edm4hep::CalorimeterHit *c
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+pandora::CartesianVector CaloHitCreator::GetBarrelNormalVector(unsigned int barrelSymmetryOrder, float barrelPhi0, unsigned int staveNumber) const
+{
+    const float phi = barrelPhi0 + (2. * M_PI * static_cast<float>(staveNumber) / static_cast<float>(barrelSymmetryOrder));
+    return pandora::CartesianVector(-std::sin(phi), std::cos(phi), 0);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 int CaloHitCreator::GetNLayersFromEdge(const edm4hep::CalorimeterHit *const pCaloHit) const
 {
     // Calo hit coordinate calculations
-    const float barrelMaximumRadius(this->GetMaximumRadius(pCaloHit, m_hCalBarrelOuterSymmetry, m_hCalBarrelOuterPhi0));
-    const float endCapMaximumRadius(this->GetMaximumRadius(pCaloHit, m_settings.m_hCalEndCapInnerSymmetryOrder, m_settings.m_hCalEndCapInnerPhiCoordinate));
+    const float barrelMaximumRadius(this->GetMaximumRadius(pCaloHit, m_hCalBarrelOuterPolygon));
+    const float endCapMaximumRadius(this->GetMaximumRadius(pCaloHit, m_hCalEndCapInnerPolygon));
     const float caloHitAbsZ(std::fabs(pCaloHit->getPosition()[2]));
 
     // Distance from radial outer
@@ -732,20 +869,18 @@ int CaloHitCreator::GetNLayersFromEdge(const edm4hep::CalorimeterHit *const pCal
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-float CaloHitCreator::GetMaximumRadius(const edm4hep::CalorimeterHit *const pCaloHit, const unsigned int symmetryOrder, const float phi0) const
+float CaloHitCreator::GetMaximumRadius(const edm4hep::CalorimeterHit *const pCaloHit, const SymmetryPolygon &symmetryPolygon) const
 {
     
     const float pCaloHitPosition[3]={pCaloHit->getPosition()[0], pCaloHit->getPosition()[1], pCaloHit->getPosition()[2]};
-    if (symmetryOrder <= 2)
+    if (symmetryPolygon.m_symmetryOrder <= 2)
         return std::sqrt((pCaloHitPosition[0] * pCaloHitPosition[0]) + (pCaloHitPosition[1] * pCaloHitPosition[1]));
 
     float maximumRadius(0.f);
-    const float twoPi(2.f * M_PI);
 
-    for (unsigned int i = 0; i < symmetryOrder; ++i)
+    for (unsigned int i = 0; i < symmetryPolygon.m_symmetryOrder; ++i)
     {
-        const float phi = phi0 + i * twoPi / static_cast<float>(symmetryOrder);
-        float radius = pCaloHitPosition[0] * std::cos(phi) + pCaloHitPosition[1] * std::sin(phi);
+        float radius = pCaloHitPosition[0] * symmetryPolygon.m_cosPhi[i] + pCaloHitPosition[1] * symmetryPolygon.m_sinPhi[i];
 
         if (radius > maximumRadius)
             maximumRadius = radius;
@@ -786,6 +921,108 @@ std::string CaloHitCreator::GetStaveCoding(const std::string &encodingString) co
 //------------------------------------------------------------------------------------------------------------------------------------------
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+CaloHitCreator::CellIDField::CellIDField() :
+    m_mask(0),
+    m_offset(0),
+    m_width(0),
+    m_isSigned(false)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+CaloHitCreator::CellIDField::CellIDField(const std::string &encodingString, const std::string &fieldName)
+{
+    if (encodingString.empty())
+        throw lcio::Exception("CellIDField : string of length zero provided as encoder string");
+
+    UTIL::BitField64 bitField(encodingString);
+    const UTIL::BitFieldValue &field(bitField[fieldName]);
+
+    m_mask = field.mask();
+    m_offset = field.offset();
+    m_width = field.width();
+    m_isSigned = field.isSigned();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+CaloHitCreator::LayerLayoutCache::LayerLayoutCache() :
+    m_nLayers(0),
+    m_firstAbsorberThickness(0.f)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+CaloHitCreator::LayerLayoutCache::LayerLayoutCache(const gear::LayerLayout &layerLayout) :
+    m_nLayers(layerLayout.getNLayers()),
+    m_firstAbsorberThickness(0.f)
+{
+    for (int i = 0; i < m_nLayers; ++i)
+    {
+        m_cellSize0.push_back(layerLayout.getCellSize0(i));
+        m_cellSize1.push_back(layerLayout.getCellSize1(i));
+        m_thickness.push_back(layerLayout.getThickness(i));
+        m_absorberThickness.push_back(layerLayout.getAbsorberThickness(i));
+    }
+
+    for (int i = 0; i < m_nLayers; ++i)
+    {
+        const float absorberThickness(m_absorberThickness[i]);
+
+        if (absorberThickness < std::numeric_limits<float>::epsilon())
+            continue;
+
+        m_firstAbsorberThickness = absorberThickness;
+        break;
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+CaloHitCreator::SymmetryPolygon::SymmetryPolygon() :
+    m_symmetryOrder(0)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+CaloHitCreator::SymmetryPolygon::SymmetryPolygon(const unsigned int symmetryOrder, const float phi0) :
+    m_symmetryOrder(symmetryOrder)
+{
+    if (symmetryOrder <= 2)
+        return;
+
+    const float twoPi(2.f * M_PI);
+
+    for (unsigned int i = 0; i < symmetryOrder; ++i)
+    {
+        const float phi = phi0 + i * twoPi / static_cast<float>(symmetryOrder);
+        m_cosPhi.push_back(std::cos(phi));
+        m_sinPhi.push_back(std::sin(phi));
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+CaloHitCreator::CaloDescriptor::CaloDescriptor() :
+    m_isValid(false),
+    m_hasStaveField(false),
+    m_hitType(pandora::ECAL),
+    m_radiationLength(1.f),
+    m_interactionLength(1.f),
+    m_barrelSymmetryOrder(0),
+    m_barrelPhi0(0.f)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 CaloHitCreator::Settings::Settings() :
     m_absorberRadLengthECal(1.f),
     m_absorberIntLengthECal(1.f),
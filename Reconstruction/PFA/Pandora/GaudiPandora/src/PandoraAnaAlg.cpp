@@ -0,0 +1,165 @@
+#include "PandoraAnaAlg.h"
+
+#include <unordered_map>
+
+DECLARE_COMPONENT( PandoraAnaAlg )
+
+
+PandoraAnaAlg::PandoraAnaAlg(const std::string& name, ISvcLocator* svcLoc)
+  : GaudiAlgorithm(name, svcLoc),
+    _nEvt(0),
+    m_fout(NULL),
+    m_tree(NULL),
+    m_hasConversion(0)
+{
+ declareProperty("ReadMCParticle"                     , m_mcParCol_r,                        "Handle of the MCParticle                      input collection" );
+ declareProperty("ReadReconstructedParticleCollection", m_ReconstructedParticleCollection_r, "Handle of the ReconstructedParticleCollection input collection" );
+ declareProperty("ReadMCRecoParticleAssociation"      , m_MCRecoParticleAssociation_r,       "Handle of the MCRecoParticleAssociation       input collection" );
+}
+
+StatusCode PandoraAnaAlg::initialize()
+{
+  std::string s_output =m_AnaOutput;
+  m_fout = new TFile(s_output.c_str(),"RECREATE");
+  m_tree = new TTree("evt","tree");
+  m_tree->Branch("m_pReco_PID"   , &m_pReco_PID);
+  m_tree->Branch("m_pReco_mass"  , &m_pReco_mass);
+  m_tree->Branch("m_pReco_energy", &m_pReco_energy);
+  m_tree->Branch("m_pReco_px"    , &m_pReco_px);
+  m_tree->Branch("m_pReco_py"    , &m_pReco_py);
+  m_tree->Branch("m_pReco_pz"    , &m_pReco_pz);
+  m_tree->Branch("m_pReco_charge", &m_pReco_charge);
+
+  m_tree->Branch("m_mc_p_size", &m_mc_p_size);
+  m_tree->Branch("m_mc_pid"   , &m_mc_pid   );
+  m_tree->Branch("m_mc_mass"  , &m_mc_mass  );
+  m_tree->Branch("m_mc_px"    , &m_mc_px    );
+  m_tree->Branch("m_mc_py"    , &m_mc_py    );
+  m_tree->Branch("m_mc_pz"    , &m_mc_pz    );
+  m_tree->Branch("m_mc_charge", &m_mc_charge);
+  m_tree->Branch("m_hasConversion", &m_hasConversion);
+
+  m_tree->Branch("m_match_reco"  , &m_match_reco  );
+  m_tree->Branch("m_match_mc"    , &m_match_mc    );
+  m_tree->Branch("m_match_weight", &m_match_weight);
+
+  return GaudiAlgorithm::initialize();
+}
+
+StatusCode PandoraAnaAlg::execute()
+{
+    this->Reset();
+
+    const edm4hep::ReconstructedParticleCollection* reco_col = m_ReconstructedParticleCollection_r.get();
+    std::unordered_map<unsigned int, int> recoID_index;
+    recoID_index.reserve(reco_col->size());
+    m_pReco_PID   .reserve(reco_col->size());
+    m_pReco_mass  .reserve(reco_col->size());
+    m_pReco_energy.reserve(reco_col->size());
+    m_pReco_px    .reserve(reco_col->size());
+    m_pReco_py    .reserve(reco_col->size());
+    m_pReco_pz    .reserve(reco_col->size());
+    m_pReco_charge.reserve(reco_col->size());
+    for(unsigned int i=0; i<reco_col->size();i++)
+    {
+        const edm4hep::ReconstructedParticle pReco = reco_col->at(i);
+        recoID_index[pReco.id()] = i;
+        m_pReco_PID.push_back(pReco.getType());
+        m_pReco_mass.push_back(pReco.getMass());
+        m_pReco_charge.push_back(pReco.getCharge());
+        m_pReco_energy.push_back(pReco.getEnergy());
+        m_pReco_px.push_back(pReco.getMomentum()[0]);
+        m_pReco_py.push_back(pReco.getMomentum()[1]);
+        m_pReco_pz.push_back(pReco.getMomentum()[2]);
+    }
+
+    const edm4hep::MCParticleCollection* MCParticle = nullptr;
+    try {
+        MCParticle = m_mcParCol_r.get();
+    }
+    catch ( GaudiException &e ) {
+        debug() << "Collection " << m_mcParCol_r.fullKey() << " is unavailable in event " << _nEvt << endmsg;
+    }
+    std::unordered_map<unsigned int, int> mcID_index;
+    if (NULL != MCParticle)
+    {
+        mcID_index.reserve(MCParticle->size());
+        for(unsigned int i=0 ; i< MCParticle->size(); i++)
+        {
+            const edm4hep::ConstMCParticle mc = MCParticle->at(i);
+            mcID_index[mc.id()] = i;
+            m_mc_p_size.push_back(mc.parents_size());
+            m_mc_pid   .push_back(mc.getPDG());
+            m_mc_mass  .push_back(mc.getMass());
+            m_mc_px    .push_back(mc.getMomentum()[0]);
+            m_mc_py    .push_back(mc.getMomentum()[1]);
+            m_mc_pz    .push_back(mc.getMomentum()[2]);
+            m_mc_charge.push_back(mc.getCharge());
+            if (mc.getPDG() != 22) continue;
+            int hasEm = 0;
+            int hasEp = 0;
+            for(unsigned int j =0 ; j< mc.daughters_size(); j++)
+            {
+                if      (mc.getDaughters(j).getPDG() ==  11 ) hasEm=1;
+                else if (mc.getDaughters(j).getPDG() == -11 ) hasEp=1;
+            }
+            if(hasEm && hasEp) m_hasConversion=1;
+        }
+    }
+
+    // one pass over the associations, matched to the columns above by object id
+    const edm4hep::MCRecoParticleAssociationCollection* reco_associa_col = m_MCRecoParticleAssociation_r.get();
+    m_match_reco  .reserve(reco_associa_col->size());
+    m_match_mc    .reserve(reco_associa_col->size());
+    m_match_weight.reserve(reco_associa_col->size());
+    for(unsigned int j=0; j < reco_associa_col->size(); j++)
+    {
+        const edm4hep::ConstMCRecoParticleAssociation association = reco_associa_col->at(j);
+        std::unordered_map<unsigned int, int>::const_iterator it_reco = recoID_index.find(association.getRec().id());
+        if(it_reco == recoID_index.end()) continue;
+        std::unordered_map<unsigned int, int>::const_iterator it_mc = mcID_index.find(association.getSim().id());
+        m_match_reco  .push_back(it_reco->second);
+        m_match_mc    .push_back(it_mc == mcID_index.end() ? -1 : it_mc->second);
+        m_match_weight.push_back(association.getWeight());
+    }
+
+    m_tree->Fill();
+    _nEvt ++ ;
+    return StatusCode::SUCCESS;
+}
+
+StatusCode PandoraAnaAlg::finalize()
+{
+  info() << "Finalized. Processed " << _nEvt << " events " <<",saved tree with entries="<<m_tree->GetEntries()<< endmsg;
+  m_fout->cd();
+  m_tree->Write();
+  m_fout->Close();
+  delete m_fout;
+  m_fout = NULL;
+  m_tree = NULL;
+  return GaudiAlgorithm::finalize();
+}
+
+void PandoraAnaAlg::Reset()
+{
+    m_pReco_PID   .clear();
+    m_pReco_mass  .clear();
+    m_pReco_energy.clear();
+    m_pReco_px    .clear();
+    m_pReco_py    .clear();
+    m_pReco_pz    .clear();
+    m_pReco_charge.clear();
+
+    m_mc_p_size.clear();
+    m_mc_pid   .clear();
+    m_mc_mass  .clear();
+    m_mc_px    .clear();
+    m_mc_py    .clear();
+    m_mc_pz    .clear();
+    m_mc_charge.clear();
+    m_hasConversion = 0;
+
+    m_match_reco  .clear();
+    m_match_mc    .clear();
+    m_match_weight.clear();
+}
@@ -15,8 +15,6 @@
 #include "LCContent.h"
 
 
-pandora::Pandora* PandoraPFAlg::m_pPandora=0;
-
 DECLARE_COMPONENT( PandoraPFAlg )
 
 template<typename T ,typename T1>
@@ -38,10 +36,19 @@ PandoraPFAlg::PandoraPFAlg(const std::string& name, ISvcLocator* svcLoc)
     _nEvt(0)
 {
  m_CollectionMaps = new CollectionMaps();
+ m_pInput = NULL;
+ // Each algorithm instance owns its pandora instance and creators, so several configurations can run in one job
+ m_pPandora = NULL;
+ m_pGeometryCreator = NULL;
+ m_pCaloHitCreator = NULL;
+ m_pTrackCreator = NULL;
+ m_pMCParticleCreator = NULL;
+ m_pPfoCreator = NULL;
   
  declareProperty("WriteClusterCollection"              , m_ClusterCollection_w,               "Handle of the ClusterCollection               output collection" );
  declareProperty("WriteReconstructedParticleCollection", m_ReconstructedParticleCollection_w, "Handle of the ReconstructedParticleCollection output collection" );
  declareProperty("WriteVertexCollection"               , m_VertexCollection_w,                "Handle of the VertexCollection                output collection" );
+ declareProperty("WriteMCRecoParticleAssociation"      , m_MCRecoParticleAssociation_w,       "Handle of the MCRecoParticleAssociation       output collection" );
 
 }
 
@@ -85,58 +92,10 @@ StatusCode PandoraPFAlg::initialize()
 
   std::cout<<"init PandoraPFAlg"<<std::endl;
 
-  std::string s_output =m_AnaOutput; 
-  m_fout = new TFile(s_output.c_str(),"RECREATE"); 
-  m_tree = new TTree("evt","tree");
-  m_tree->Branch("m_pReco_PID"   , &m_pReco_PID);
-  m_tree->Branch("m_pReco_mass"  , &m_pReco_mass);
-  m_tree->Branch("m_pReco_energy", &m_pReco_energy);
-  m_tree->Branch("m_pReco_px"    , &m_pReco_px);
-  m_tree->Branch("m_pReco_py"    , &m_pReco_py);
-  m_tree->Branch("m_pReco_pz"    , &m_pReco_pz);
-  m_tree->Branch("m_pReco_charge", &m_pReco_charge);
-
-  m_tree->Branch("m_mc_p_size", &m_mc_p_size);
-  m_tree->Branch("m_mc_pid"   , &m_mc_pid   );
-  m_tree->Branch("m_mc_mass"  , &m_mc_mass  );
-  m_tree->Branch("m_mc_px"    , &m_mc_px    );
-  m_tree->Branch("m_mc_py"    , &m_mc_py    );
-  m_tree->Branch("m_mc_pz"    , &m_mc_pz    );
-  m_tree->Branch("m_mc_charge", &m_mc_charge);
-  m_tree->Branch("m_hasConversion", &m_hasConversion);
 
   for ( const auto& col : m_readCols ) {
-      auto seperater = col.find(':');
-      std::string colType = col.substr(0, seperater);
-      std::string colName = col.substr(seperater+1);
-      m_collections[colName] = colType;
-
-      if ( colType == "MCParticle" ) {
-          m_dataHandles[colName] =
-              new DataHandle<edm4hep::MCParticleCollection>(colName, Gaudi::DataHandle::Reader, this);
-      }
-      else if ( colType == "Track" ) {
-          m_dataHandles[colName] =
-              new DataHandle<edm4hep::TrackCollection>(colName, Gaudi::DataHandle::Reader, this);
-      }
-      else if ( colType == "CalorimeterHit" ) {
-          m_dataHandles[colName] =
-              new DataHandle<edm4hep::CalorimeterHitCollection>(colName, Gaudi::DataHandle::Reader, this);
-      }
-      else if ( colType == "Vertex" ) {
-          m_dataHandles[colName] =
-              new DataHandle<edm4hep::VertexCollection>(colName, Gaudi::DataHandle::Reader, this);
-      }
-      else if ( colType == "MCRecoTrackerAssociation" ) {
-          m_dataHandles[colName] =
-              new DataHandle<edm4hep::MCRecoTrackerAssociationCollection>(colName, Gaudi::DataHandle::Reader, this);
-      }
-      else if ( colType == "MCRecoCaloAssociation" ) {
-          m_dataHandles[colName] =
-              new DataHandle<edm4hep::MCRecoCaloAssociationCollection>(colName, Gaudi::DataHandle::Reader, this);
-      }
-      else {
-            error() << "invalid collection type: " << colType << endmsg;
+      if ( !m_collectionReader.DeclareCollection(col, this) ) {
+            error() << "invalid collection type: " << col << endmsg;
             return StatusCode::FAILURE;
       }
   }
@@ -318,18 +277,26 @@ StatusCode PandoraPFAlg::execute()
     try
     {
         
-        updateMap();
-        PANDORA_THROW_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, m_pMCParticleCreator->CreateMCParticles(*m_CollectionMaps));
-        PANDORA_THROW_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, m_pCaloHitCreator->CreateCaloHits(*m_CollectionMaps));
-        PANDORA_THROW_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, m_pMCParticleCreator->CreateCaloHitToMCParticleRelationships(*m_CollectionMaps, m_pCaloHitCreator->GetCalorimeterHitVector() ));
-        PANDORA_THROW_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, m_pTrackCreator->CreateTrackAssociations(*m_CollectionMaps));
-        PANDORA_THROW_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, m_pTrackCreator->CreateTracks(*m_CollectionMaps));
-        PANDORA_THROW_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, m_pMCParticleCreator->CreateTrackToMCParticleRelationships(*m_CollectionMaps, m_pTrackCreator->GetTrackVector() ));
+        if (m_UseSharedInput)
+        {
+            m_pInput = &get<CollectionMapsObject>(m_SharedInputLocation)->getData();
+        }
+        else
+        {
+            m_collectionReader.FillCollectionMaps(*m_CollectionMaps);
+            m_pInput = m_CollectionMaps;
+        }
+
+        PANDORA_THROW_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, m_pMCParticleCreator->CreateMCParticles(*m_pInput));
+        PANDORA_THROW_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, m_pCaloHitCreator->CreateCaloHits(*m_pInput));
+        PANDORA_THROW_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, m_pMCParticleCreator->CreateCaloHitToMCParticleRelationships(*m_pInput, m_pCaloHitCreator->GetCalorimeterHitVector() ));
+        PANDORA_THROW_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, m_pTrackCreator->CreateTrackAssociations(*m_pInput));
+        PANDORA_THROW_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, m_pTrackCreator->CreateTracks(*m_pInput));
+        PANDORA_THROW_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, m_pMCParticleCreator->CreateTrackToMCParticleRelationships(*m_pInput, m_pTrackCreator->GetTrackVector() ));
         PANDORA_THROW_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, PandoraApi::ProcessEvent(*m_pPandora));
-        PANDORA_THROW_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, m_pPfoCreator->CreateParticleFlowObjects(*m_CollectionMaps, m_ClusterCollection_w, m_ReconstructedParticleCollection_w, m_VertexCollection_w));
+        PANDORA_THROW_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, m_pPfoCreator->CreateParticleFlowObjects(*m_pInput, m_ClusterCollection_w, m_ReconstructedParticleCollection_w, m_VertexCollection_w));
         
         StatusCode sc0 = CreateMCRecoParticleAssociation();
-        StatusCode sc = Ana();
 
         PANDORA_THROW_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, PandoraApi::Reset(*m_pPandora));
         this->Reset();
@@ -353,16 +320,20 @@ StatusCode PandoraPFAlg::execute()
 
 StatusCode PandoraPFAlg::finalize()
 {
-  info() << "Finalized. Processed " << _nEvt << " events " <<",saved tree with entries="<<m_tree->GetEntries()<< endmsg;
-  m_fout->cd();
-  m_tree->Write();
-  m_fout->Close();
-  delete m_pPandora;
+  info() << "Finalized. Processed " << _nEvt << " events " << endmsg;
+  // The creators refer to the pandora instance, so they go first
   delete m_pGeometryCreator;
   delete m_pCaloHitCreator;
   delete m_pTrackCreator;
   delete m_pMCParticleCreator;
   delete m_pPfoCreator;
+  delete m_pPandora;
+  m_pGeometryCreator = NULL;
+  m_pCaloHitCreator = NULL;
+  m_pTrackCreator = NULL;
+  m_pMCParticleCreator = NULL;
+  m_pPfoCreator = NULL;
+  m_pPandora = NULL;
   return GaudiAlgorithm::finalize();
 }
 
@@ -391,24 +362,8 @@ void PandoraPFAlg::Reset()
     m_pTrackCreator->Reset();
     m_pMCParticleCreator->Reset();
 
-    std::vector<int>()  .swap(m_pReco_PID   );
-    std::vector<float>().swap(m_pReco_mass);
-    std::vector<float>().swap(m_pReco_energy);
-    std::vector<float>().swap(m_pReco_px);
-    std::vector<float>().swap(m_pReco_py);
-    std::vector<float>().swap(m_pReco_pz);
-    std::vector<float>().swap(m_pReco_charge);
-
-    std::vector<int>()  .swap(m_mc_p_size);
-    std::vector<int>()  .swap(m_mc_pid   );
-    std::vector<float>().swap(m_mc_mass  );
-    std::vector<float>().swap(m_mc_px    );
-    std::vector<float>().swap(m_mc_py    );
-    std::vector<float>().swap(m_mc_pz    );
-    std::vector<float>().swap(m_mc_charge);
-    m_hasConversion = 0;
-
     m_CollectionMaps->clear();
+    m_pInput = NULL;
 }
 
 const pandora::Pandora *PandoraPFAlg::GetPandora() const
@@ -424,184 +379,32 @@ PandoraPFAlg::Settings::Settings() :
     m_muonEndCapBField(0.01f)
 {
 }
-CollectionMaps::CollectionMaps()
-{
-}
-void CollectionMaps::clear()
-{
-collectionMap_MC.clear();
-collectionMap_CaloHit.clear();
-collectionMap_Vertex.clear();
-collectionMap_Track.clear();
-collectionMap_CaloRel.clear();
-collectionMap_TrkRel.clear();
-}
-
-
-StatusCode PandoraPFAlg::updateMap()
-{
-    for(auto &v : m_dataHandles){
-        try{
-            if(m_collections[v.first]=="MCParticle"){
-                auto handle = dynamic_cast<DataHandle<edm4hep::MCParticleCollection>*> (v.second);
-                auto po = handle->get();
-                if(po != NULL){
-                    std::vector<edm4hep::MCParticle> v_mc;
-                    m_CollectionMaps->collectionMap_MC [v.first] = v_mc;
-                    for(unsigned int i=0 ; i< po->size(); i++) m_CollectionMaps->collectionMap_MC [v.first].push_back(po->at(i));
-                    std::cout<<"saved col name="<<v.first<<std::endl;
-                }
-                else{
-                std::cout<<"don't find col name="<<v.first<<std::endl;
-                }
-            }
-            else if(m_collections[v.first]=="CalorimeterHit"){
-                auto handle = dynamic_cast<DataHandle<edm4hep::CalorimeterHitCollection>*> (v.second);
-                auto po = handle->get();
-                if(po != NULL){
-                    std::vector<edm4hep::CalorimeterHit> v_cal;
-                    m_CollectionMaps->collectionMap_CaloHit[v.first] = v_cal ;
-                    for(unsigned int i=0 ; i< po->size(); i++) m_CollectionMaps->collectionMap_CaloHit [v.first].push_back(po->at(i));
-                    std::cout<<"saved col name="<<v.first<<std::endl;
-                }
-                else{
-                std::cout<<"don't find col name="<<v.first<<std::endl;
-                }
-            }
-            else if(m_collections[v.first]=="Track"){
-                auto handle = dynamic_cast<DataHandle<edm4hep::TrackCollection>*> (v.second);
-                auto po = handle->get();
-                if(po != NULL){
-                    std::vector<edm4hep::Track> v_cal;
-                    m_CollectionMaps->collectionMap_Track[v.first] = v_cal ;
-                    for(unsigned int i=0 ; i< po->size(); i++) m_CollectionMaps->collectionMap_Track [v.first].push_back(po->at(i));
-                    std::cout<<"saved col name="<<v.first<<std::endl;
-                }
-                else{
-                std::cout<<"don't find col name="<<v.first<<std::endl;
-                }
-            }
-            else if(m_collections[v.first]=="Vertex"){
-                auto handle = dynamic_cast<DataHandle<edm4hep::VertexCollection>*> (v.second);
-                auto po = handle->get();
-                if(po != NULL){
-                    std::vector<edm4hep::Vertex> v_cal;
-                    m_CollectionMaps->collectionMap_Vertex[v.first] = v_cal ;
-                    for(unsigned int i=0 ; i< po->size(); i++) m_CollectionMaps->collectionMap_Vertex [v.first].push_back(po->at(i));
-                    std::cout<<"saved col name="<<v.first<<std::endl;
-                }
-                else{
-                std::cout<<"don't find col name="<<v.first<<std::endl;
-                }
-            }
-            else if(m_collections[v.first]=="MCRecoCaloAssociation"){
-                auto handle = dynamic_cast<DataHandle<edm4hep::MCRecoCaloAssociationCollection>*> (v.second);
-                auto po = handle->get();
-                if(po != NULL){
-                    std::vector<edm4hep::MCRecoCaloAssociation> v_cal;
-                    m_CollectionMaps->collectionMap_CaloRel[v.first] = v_cal ;
-                    for(unsigned int i=0 ; i< po->size(); i++) m_CollectionMaps->collectionMap_CaloRel [v.first].push_back(po->at(i));
-                    std::cout<<"saved col name="<<v.first<<std::endl;
-                }
-                else{
-                std::cout<<"don't find col name="<<v.first<<std::endl;
-                }
-            }
-            else if(m_collections[v.first]=="MCRecoTrackerAssociation"){
-                auto handle = dynamic_cast<DataHandle<edm4hep::MCRecoTrackerAssociationCollection>*> (v.second);
-                auto po = handle->get();
-                if(po != NULL){
-                    std::vector<edm4hep::MCRecoTrackerAssociation> v_cal;
-                    m_CollectionMaps->collectionMap_TrkRel[v.first] = v_cal ;
-                    for(unsigned int i=0 ; i< po->size(); i++) m_CollectionMaps->collectionMap_TrkRel [v.first].push_back(po->at(i));
-                    std::cout<<"saved col name="<<v.first<<std::endl;
-                }
-                else{
-                std::cout<<"don't find col name="<<v.first<<std::endl;
-                }
-            }
-            else{
-            std::cout<<"wrong type name for col :"<<v.first<<std::endl;
-            }
-        }//try
-        catch(...){
-            std::cout<<"don't find "<<v.first<<"in event"<<std::endl;
-            std::cout<<"don't find  col name="<<v.first<<",with type="<<m_collections[v.first]<<" in this event"<<std::endl;
-        }
-    }
-    return StatusCode::SUCCESS;
-}
-
-
 
-StatusCode PandoraPFAlg::Ana()
+// create simple MCRecoParticleAssociation using calorimeter hit only now
+StatusCode PandoraPFAlg::CreateMCRecoParticleAssociation()
 {
-    int n_current = m_tree->GetEntries()+1;
+    edm4hep::MCRecoParticleAssociationCollection* pMCRecoParticleAssociationCollection  = m_MCRecoParticleAssociation_w.createAndPut();
     const edm4hep::ReconstructedParticleCollection* reco_col = m_ReconstructedParticleCollection_w.get();
-    const edm4hep::MCRecoParticleAssociationCollection* reco_associa_col = m_MCRecoParticleAssociation_w.get();
-    for(int i=0; i<reco_col->size();i++)
+
+    // the calo hit associations with their reco hit id indices, built once per event with the collection maps
+    std::vector<std::pair<const edm4hep::MCRecoCaloAssociationCollection*, const RecoIdIndex*> > caloRels;
+    for(std::map<std::string, const edm4hep::MCRecoCaloAssociationCollection* >::const_iterator iter = m_pInput->collectionMap_CaloRel.begin(); iter != m_pInput->collectionMap_CaloRel.end(); iter++)
     {
-        const edm4hep::ReconstructedParticle pReco = reco_col->at(i);
-        const float px = pReco.getMomentum()[0];
-        const float py = pReco.getMomentum()[1];
-        const float pz = pReco.getMomentum()[2];
-        const float energy = pReco.getEnergy();
-        const float mass = pReco.getMass();
-        const float charge = pReco.getCharge();
-        const int type = pReco.getType();
-        m_pReco_PID.push_back(type);
-        m_pReco_mass.push_back(mass);
-        m_pReco_charge.push_back(charge);
-        m_pReco_energy.push_back(energy);
-        m_pReco_px.push_back(px);
-        m_pReco_py.push_back(py);
-        m_pReco_pz.push_back(pz);
-        for(int j=0; j < reco_associa_col->size(); j++)
-        {
-            if(reco_associa_col->at(j).getRec().id() != pReco.id() ) continue;
-            std::cout<<"MC pid ="<<reco_associa_col->at(j).getSim().getPDG()<<",weight="<<reco_associa_col->at(j).getWeight()<<", px="<<reco_associa_col->at(j).getSim().getMomentum()[0]<<", py="<<reco_associa_col->at(j).getSim().getMomentum()[1]<<",pz="<<reco_associa_col->at(j).getSim().getMomentum()[2]<<std::endl;
-        }
-    }
-    const edm4hep::MCParticleCollection*     MCParticle = nullptr;
-    StatusCode sc = StatusCode::SUCCESS;
-    sc =  getCol(m_mcParCol_r  , MCParticle );
-    if (NULL != MCParticle   )  
-    { 
-        for(unsigned int i=0 ; i< MCParticle->size(); i++)
-        {
-            m_mc_p_size.push_back(MCParticle->at(i).parents_size());
-            m_mc_pid   .push_back(MCParticle->at(i).getPDG());
-            m_mc_mass  .push_back(MCParticle->at(i).getMass());
-            m_mc_px    .push_back(MCParticle->at(i).getMomentum()[0]);
-            m_mc_py    .push_back(MCParticle->at(i).getMomentum()[1]);
-            m_mc_pz    .push_back(MCParticle->at(i).getMomentum()[2]);
-            m_mc_charge.push_back(MCParticle->at(i).getCharge());
-            //if(MCParticle->at(i).parents_size()==0) std::cout<<"MYDBUG evt="<<n_current<<", mc i="<<i<<",px="<<MCParticle->at(i).getMomentum()[0]<<",py="<<MCParticle->at(i).getMomentum()[1]<<",pz="<<MCParticle->at(i).getMomentum()[2]<<std::endl;
-            if (MCParticle->at(i).getPDG() != 22) continue;
-            int hasEm = 0;
-            int hasEp = 0;
-            for(unsigned int j =0 ; j< MCParticle->at(i).daughters_size(); j++)
-            {
-                if      (MCParticle->at(i).getDaughters(j).getPDG() ==  11 ) hasEm=1;
-                else if (MCParticle->at(i).getDaughters(j).getPDG() == -11 ) hasEp=1;
-            }
-            if(hasEm && hasEp) m_hasConversion=1;
-        }
+        caloRels.emplace_back(iter->second, &(m_pInput->collectionMap_CaloRelIndex.find(iter->first)->second));
     }
-    m_tree->Fill();
-    return StatusCode::SUCCESS;
-}
 
+    // flat map of mc particle id to (mc particle, deposited energy), reused for all the particles
+    struct MCEnergy
+    {
+        int                      id;
+        edm4hep::ConstMCParticle mc;
+        float                    edep;
+    };
+    std::vector<MCEnergy> mc_edep;
 
-// create simple MCRecoParticleAssociation using calorimeter hit only now
-StatusCode PandoraPFAlg::CreateMCRecoParticleAssociation()
-{
-    edm4hep::MCRecoParticleAssociationCollection* pMCRecoParticleAssociationCollection  = m_MCRecoParticleAssociation_w.createAndPut();
-    const edm4hep::ReconstructedParticleCollection* reco_col = m_ReconstructedParticleCollection_w.get();
     for(int i=0; i<reco_col->size();i++)
     {
-        std::map<int, edm4hep::ConstMCParticle> mc_map;
-        std::map<int, float > id_edep_map;
+        mc_edep.clear();
         float tot_en = 0 ;
         const edm4hep::ReconstructedParticle pReco = reco_col->at(i);
         for(int j=0; j < pReco.clusters_size(); j++)
@@ -610,34 +413,38 @@ StatusCode PandoraPFAlg::CreateMCRecoParticleAssociation()
             for(int k=0; k < cluster.hits_size(); k++)
             {
                 edm4hep::ConstCalorimeterHit hit = cluster.getHits(k);
-                for(std::map<std::string, std::vector<edm4hep::MCRecoCaloAssociation> >::iterator iter = m_CollectionMaps->collectionMap_CaloRel.begin(); iter != m_CollectionMaps->collectionMap_CaloRel.end(); iter++)
+                for(unsigned int ic=0; ic < caloRels.size(); ic++)
                 {
-                    for(std::vector<edm4hep::MCRecoCaloAssociation>::iterator it = iter->second.begin(); it != iter->second.end(); it ++)
+                    const std::pair<RecoIdIndex::const_iterator, RecoIdIndex::const_iterator> range = caloRels[ic].second->Find(hit.id());
+                    for(RecoIdIndex::const_iterator ir = range.first; ir != range.second; ir++)
                     {
-                        if(it->getRec().id() != hit.id()) continue;
-                        for(std::vector<edm4hep::ConstCaloHitContribution>::const_iterator itc = it->getSim().contributions_begin(); itc != it->getSim().contributions_end(); itc++)
+                        const edm4hep::ConstSimCalorimeterHit simHit = caloRels[ic].first->at(*ir).getSim();
+                        for(std::vector<edm4hep::ConstCaloHitContribution>::const_iterator itc = simHit.contributions_begin(); itc != simHit.contributions_end(); itc++)
                         {
-                            if(mc_map.find(itc->getParticle().id()) == mc_map.end()) mc_map[itc->getParticle().id()] = itc->getParticle() ;
-                            if(id_edep_map.find(itc->getParticle().id()) != id_edep_map.end()) id_edep_map[itc->getParticle().id()] = id_edep_map[itc->getParticle().id()] + itc->getEnergy() ;
-                            else                                                               id_edep_map[itc->getParticle().id()] = itc->getEnergy() ;
+                            const int mc_id = itc->getParticle().id();
+                            std::vector<MCEnergy>::iterator it_mc = mc_edep.begin();
+                            while(it_mc != mc_edep.end() && it_mc->id != mc_id) it_mc++;
+                            if(it_mc == mc_edep.end()) mc_edep.push_back(MCEnergy{mc_id, itc->getParticle(), itc->getEnergy()});
+                            else                       it_mc->edep += itc->getEnergy();
                             tot_en += itc->getEnergy() ;
                         }
                     }
                 }
             }
         }
-        for(std::map<int, edm4hep::ConstMCParticle>::iterator it = mc_map.begin(); it != mc_map.end(); it ++)
+        // keep the ordering by mc particle id
+        std::sort(mc_edep.begin(), mc_edep.end(), [](const MCEnergy& a, const MCEnergy& b){ return a.id < b.id; });
+        for(std::vector<MCEnergy>::const_iterator it = mc_edep.begin(); it != mc_edep.end(); it ++)
         {      
             edm4hep::MCRecoParticleAssociation association = pMCRecoParticleAssociationCollection->create();
             association.setRec(pReco);
-            association.setSim(it->second);
+            association.setSim(it->mc);
             if(tot_en==0) 
             {
                 association.setWeight(0);
                 std::cout<<"Found 0 cluster energy"<<std::endl;
             }  
-            else if(id_edep_map.find(it->first) != id_edep_map.end()) association.setWeight(id_edep_map[it->first]/tot_en);
-            else std::cout<<"Error in creating MCRecoParticleAssociation"<<std::endl;
+            else association.setWeight(it->edep/tot_en);
         }
     }
     return StatusCode::SUCCESS;
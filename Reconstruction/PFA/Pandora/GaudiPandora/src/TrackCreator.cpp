@@ -9,6 +9,7 @@
 //#include "UTIL/ILDConf.h"
 
 #include "edm4hep/Vertex.h"
+#include "edm4hep/VertexCollection.h"
 #include "edm4hep/ReconstructedParticle.h"
 
 #include "gear/BField.h"
@@ -106,6 +107,27 @@ TrackCreator::TrackCreator(const Settings &settings, const pandora::Pandora *con
 
     m_tanLambdaFtd = m_ftdZPositions[0] / m_ftdOuterRadii[0];
 
+    for (unsigned int iFtdLayer = 0; iFtdLayer < m_nFtdLayers; ++iFtdLayer)
+    {
+        m_ftdTanLambdaMin.push_back(m_ftdZPositions[iFtdLayer] / m_ftdOuterRadii[iFtdLayer]);
+        m_ftdTanLambdaMax.push_back(m_ftdZPositions[iFtdLayer] / m_ftdInnerRadii[iFtdLayer]);
+    }
+
+    // Ecal barrel inner faces, a point and the in-plane direction of each face, shared by all track projections
+    if (m_eCalBarrelInnerSymmetry > 0)
+    {
+        float twopi_n = 2. * M_PI / (static_cast<float>(m_eCalBarrelInnerSymmetry));
+
+        for (int i = 0; i < m_eCalBarrelInnerSymmetry; ++i)
+        {
+            const float phi(twopi_n * static_cast<float>(i) + m_eCalBarrelInnerPhi0);
+            m_eCalBarrelFaceX.push_back(m_eCalBarrelInnerR * std::cos(phi));
+            m_eCalBarrelFaceY.push_back(m_eCalBarrelInnerR * std::sin(phi));
+            m_eCalBarrelFaceDirX.push_back(std::cos(phi + 0.5 * M_PI));
+            m_eCalBarrelFaceDirY.push_back(std::sin(phi + 0.5 * M_PI));
+        }
+    }
+
     // Calculate etd and set parameters
     // fg: make SET and ETD optional - as they might not be in the model ...
     try
@@ -140,6 +162,8 @@ TrackCreator::~TrackCreator()
 
 pandora::StatusCode TrackCreator::CreateTrackAssociations(const CollectionMaps& collectionMaps)
 {
+    this->FillTrackIdToAddressMap(collectionMaps);
+
     PANDORA_RETURN_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, this->ExtractKinks(collectionMaps));
     PANDORA_RETURN_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, this->ExtractProngsAndSplits(collectionMaps));
     PANDORA_RETURN_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, this->ExtractV0s(collectionMaps));
@@ -157,14 +181,14 @@ pandora::StatusCode TrackCreator::ExtractKinks(const CollectionMaps& collectionM
         if(collectionMaps.collectionMap_Vertex.find(*iter) == collectionMaps.collectionMap_Vertex.end()) { std::cout<<"not find "<<(*iter)<<std::endl; continue;}
         try
         {
-            const std::vector<edm4hep::Vertex>& pKinkCollection = (collectionMaps.collectionMap_Vertex.find(*iter))->second;
+            const edm4hep::VertexCollection& pKinkCollection = *((collectionMaps.collectionMap_Vertex.find(*iter))->second);
 
             for (int i = 0, iMax = pKinkCollection.size(); i < iMax; ++i)
             {
                 try
                 {
-                    const edm4hep::Vertex  pVertex0 = pKinkCollection.at(i);
-                    const edm4hep::Vertex* pVertex  = &(pVertex0);
+                    const edm4hep::ConstVertex  pVertex0 = pKinkCollection.at(i);
+                    const edm4hep::ConstVertex* pVertex  = &(pVertex0);
 
                     if (NULL == pVertex) throw ("Collection type mismatch");
 
@@ -223,7 +247,7 @@ pandora::StatusCode TrackCreator::ExtractKinks(const CollectionMaps& collectionM
                         {
                             for (unsigned int jTrack = iTrack + 1; jTrack < nTracks; ++jTrack)
                             {
-                                PANDORA_RETURN_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, PandoraApi::SetTrackParentDaughterRelationship(*m_pPandora, GetTrackAddress(collectionMaps, pTrack), GetTrackAddress(collectionMaps, pReconstructedParticle.getTracks(jTrack) ) ) );
+                                PANDORA_RETURN_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, PandoraApi::SetTrackParentDaughterRelationship(*m_pPandora, GetTrackAddress(pTrack), GetTrackAddress(pReconstructedParticle.getTracks(jTrack) ) ) );
                             }
                         }
 
@@ -232,7 +256,7 @@ pandora::StatusCode TrackCreator::ExtractKinks(const CollectionMaps& collectionM
                         {
                             for (unsigned int jTrack = iTrack + 1; jTrack < nTracks; ++jTrack)
                             {
-                                PANDORA_RETURN_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, PandoraApi::SetTrackSiblingRelationship(*m_pPandora, GetTrackAddress(collectionMaps, pTrack), GetTrackAddress(collectionMaps, pReconstructedParticle.getTracks(jTrack) ) ) );
+                                PANDORA_RETURN_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, PandoraApi::SetTrackSiblingRelationship(*m_pPandora, GetTrackAddress(pTrack), GetTrackAddress(pReconstructedParticle.getTracks(jTrack) ) ) );
                             }
                         }
                     }
@@ -261,14 +285,14 @@ pandora::StatusCode TrackCreator::ExtractProngsAndSplits(const CollectionMaps& c
         if(collectionMaps.collectionMap_Vertex.find(*iter) == collectionMaps.collectionMap_Vertex.end()) { std::cout<<"not find "<<(*iter)<<std::endl; continue;}
         try
         {
-            const std::vector<edm4hep::Vertex>& pProngOrSplitCollection = (collectionMaps.collectionMap_Vertex.find(*iter))->second;
+            const edm4hep::VertexCollection& pProngOrSplitCollection = *((collectionMaps.collectionMap_Vertex.find(*iter))->second);
 
             for (int i = 0, iMax = pProngOrSplitCollection.size(); i < iMax; ++i)
             {
                 try
                 {
-                    const edm4hep::Vertex  pVertex0 = pProngOrSplitCollection.at(i);
-                    const edm4hep::Vertex* pVertex  = &(pVertex0);
+                    const edm4hep::ConstVertex  pVertex0 = pProngOrSplitCollection.at(i);
+                    const edm4hep::ConstVertex* pVertex  = &(pVertex0);
 
                     if (NULL == pVertex) throw ("Collection type mismatch");
                     const edm4hep::ConstReconstructedParticle pReconstructedParticle = pVertex->getAssociatedParticle();
@@ -288,7 +312,7 @@ pandora::StatusCode TrackCreator::ExtractProngsAndSplits(const CollectionMaps& c
                         {
                             for (unsigned int jTrack = iTrack + 1; jTrack < nTracks; ++jTrack)
                             {
-                                PANDORA_RETURN_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, PandoraApi::SetTrackParentDaughterRelationship(*m_pPandora, GetTrackAddress(collectionMaps, pTrack), GetTrackAddress(collectionMaps, pReconstructedParticle.getTracks(jTrack) ) ) );
+                                PANDORA_RETURN_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, PandoraApi::SetTrackParentDaughterRelationship(*m_pPandora, GetTrackAddress(pTrack), GetTrackAddress(pReconstructedParticle.getTracks(jTrack) ) ) );
                             }
                         }
 
@@ -297,7 +321,7 @@ pandora::StatusCode TrackCreator::ExtractProngsAndSplits(const CollectionMaps& c
                         {
                             for (unsigned int jTrack = iTrack + 1; jTrack < nTracks; ++jTrack)
                             {
-                                PANDORA_RETURN_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, PandoraApi::SetTrackSiblingRelationship(*m_pPandora, GetTrackAddress(collectionMaps, pTrack), GetTrackAddress(collectionMaps, pReconstructedParticle.getTracks(jTrack) ) ) );
+                                PANDORA_RETURN_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, PandoraApi::SetTrackSiblingRelationship(*m_pPandora, GetTrackAddress(pTrack), GetTrackAddress(pReconstructedParticle.getTracks(jTrack) ) ) );
                             }
                         }
                     }
@@ -327,14 +351,14 @@ pandora::StatusCode TrackCreator::ExtractV0s(const CollectionMaps& collectionMap
         if(collectionMaps.collectionMap_Vertex.find(*iter) == collectionMaps.collectionMap_Vertex.end()) { std::cout<<"not find "<<(*iter)<<std::endl; continue;}
         try
         {
-            const std::vector<edm4hep::Vertex>& pV0Collection = (collectionMaps.collectionMap_Vertex.find(*iter))->second;
+            const edm4hep::VertexCollection& pV0Collection = *((collectionMaps.collectionMap_Vertex.find(*iter))->second);
 
             for (int i = 0, iMax = pV0Collection.size(); i < iMax; ++i)
             {
                 try
                 {
-                    const edm4hep::Vertex  pVertex0 = pV0Collection.at(i);
-                    const edm4hep::Vertex* pVertex  = &(pVertex0);
+                    const edm4hep::ConstVertex  pVertex0 = pV0Collection.at(i);
+                    const edm4hep::ConstVertex* pVertex  = &(pVertex0);
 
                     if (NULL == pVertex) throw ("Collection type mismatch");
 
@@ -378,7 +402,7 @@ pandora::StatusCode TrackCreator::ExtractV0s(const CollectionMaps& collectionMap
                         // Make track sibling relationships
                         for (unsigned int jTrack = iTrack + 1; jTrack < nTracks; ++jTrack)
                         {
-                            PANDORA_RETURN_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, PandoraApi::SetTrackSiblingRelationship(*m_pPandora, GetTrackAddress(collectionMaps, pTrack), GetTrackAddress(collectionMaps, pReconstructedParticle.getTracks(jTrack) ) ) );
+                            PANDORA_RETURN_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, PandoraApi::SetTrackSiblingRelationship(*m_pPandora, GetTrackAddress(pTrack), GetTrackAddress(pReconstructedParticle.getTracks(jTrack) ) ) );
                         }
                     }
                 }
@@ -413,19 +437,28 @@ bool TrackCreator::IsConflictingRelationship(const edm4hep::ConstReconstructedPa
     return false;
 }
 
-const edm4hep::Track* TrackCreator::GetTrackAddress(const CollectionMaps& collectionMaps, const edm4hep::ConstTrack& pTrack )
+void TrackCreator::FillTrackIdToAddressMap(const CollectionMaps& collectionMaps)
 {
+    m_trackIdToAddressMap.clear();
     for (StringVector::const_iterator iter = m_settings.m_trackCollections.begin(), iterEnd = m_settings.m_trackCollections.end(); iter != iterEnd; ++iter)
     {
         if(collectionMaps.collectionMap_Track.find(*iter) == collectionMaps.collectionMap_Track.end()) { std::cout<<"not find "<<(*iter)<<std::endl; continue;}
         const std::vector<edm4hep::Track>& pTrackCollection = (collectionMaps.collectionMap_Track.find(*iter))->second;
+        m_trackIdToAddressMap.reserve(m_trackIdToAddressMap.size() + pTrackCollection.size());
         for (int i = 0, iMax = pTrackCollection.size(); i < iMax; ++i)
         {
             const edm4hep::Track& pTrack0 = pTrackCollection.at(i);
-            if (pTrack.id() == pTrack0.id()) return (const edm4hep::Track*) (&pTrack0);
+            m_trackIdToAddressMap.emplace(pTrack0.id(), &pTrack0); // the first collection wins, as in a search in collection order
         }
     }
-    return NULL;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+const edm4hep::Track* TrackCreator::GetTrackAddress(const edm4hep::ConstTrack& pTrack ) const
+{
+    TrackIdToAddressMap::const_iterator iter = m_trackIdToAddressMap.find(pTrack.id());
+    return (m_trackIdToAddressMap.end() != iter) ? iter->second : NULL;
 }
 //------------------------------------------------------------------------------------------------------------------------------------------
 
@@ -453,20 +486,7 @@ pandora::StatusCode TrackCreator::CreateTracks(const CollectionMaps& collectionM
                     const float tanLambda(std::fabs(pTrack->getTrackStates(0).tanLambda));
 
                     if (tanLambda > m_tanLambdaFtd)
-                    {
-                        int expectedFtdHits(0);
-
-                        for (unsigned int iFtdLayer = 0; iFtdLayer < m_nFtdLayers; ++iFtdLayer)
-                        {
-                            if ((tanLambda > m_ftdZPositions[iFtdLayer] / m_ftdOuterRadii[iFtdLayer]) &&
-                                (tanLambda < m_ftdZPositions[iFtdLayer] / m_ftdInnerRadii[iFtdLayer]))
-                            {
-                                expectedFtdHits++;
-                            }
-                        }
-
-                        minTrackHits = std::max(m_settings.m_minFtdTrackHits, expectedFtdHits);
-                    }
+                        minTrackHits = std::max(m_settings.m_minFtdTrackHits, this->GetNExpectedFtdHits(tanLambda));
 
                     const int nTrackHits(static_cast<int>(pTrack->trackerHits_size()));
 
@@ -494,9 +514,12 @@ pandora::StatusCode TrackCreator::CreateTracks(const CollectionMaps& collectionM
                     if (std::numeric_limits<float>::epsilon() < std::fabs(signedCurvature))
                         trackParameters.m_charge = static_cast<int>(signedCurvature / std::fabs(signedCurvature));
 
+                    TrackHitSummary hitSummary;
+                    this->SummariseTrackHits(pTrack, hitSummary);
+
                     this->GetTrackStates(pTrack, trackParameters);
-                    this->TrackReachesECAL(pTrack, trackParameters);
-                    this->DefineTrackPfoUsage(pTrack, trackParameters);
+                    this->TrackReachesECAL(pTrack, hitSummary, trackParameters);
+                    this->DefineTrackPfoUsage(pTrack, hitSummary, trackParameters);
 
                     PANDORA_THROW_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, PandoraApi::Track::Create(*m_pPandora, trackParameters));
                     m_trackVector.push_back(pTrack);
@@ -565,16 +588,13 @@ float TrackCreator::CalculateTrackTimeAtCalorimeter(const edm4hep::Track *const
     pandora::CartesianVector barrelProjection(0.f, 0.f, 0.f);
     if (m_eCalBarrelInnerSymmetry > 0)
     {
-        // Polygon
-        float twopi_n = 2. * M_PI / (static_cast<float>(m_eCalBarrelInnerSymmetry));
-
-        for (int i = 0; i < m_eCalBarrelInnerSymmetry; ++i)
+        // Polygon, faces precomputed in the constructor
+        for (unsigned int i = 0, iMax = m_eCalBarrelFaceX.size(); i < iMax; ++i)
         {
             float genericTime(std::numeric_limits<float>::max());
-            const float phi(twopi_n * static_cast<float>(i) + m_eCalBarrelInnerPhi0);
 
-            const pandora::StatusCode statusCode(helix.GetPointInXY(m_eCalBarrelInnerR * std::cos(phi), m_eCalBarrelInnerR * std::sin(phi),
-                std::cos(phi + 0.5 * M_PI), std::sin(phi + 0.5 * M_PI), referencePoint, barrelProjection, genericTime));
+            const pandora::StatusCode statusCode(helix.GetPointInXY(m_eCalBarrelFaceX[i], m_eCalBarrelFaceY[i],
+                m_eCalBarrelFaceDirX[i], m_eCalBarrelFaceDirY[i], referencePoint, barrelProjection, genericTime));
 
             if ((pandora::STATUS_CODE_SUCCESS == statusCode) && (genericTime < minGenericTime))
             {
@@ -622,48 +642,67 @@ void TrackCreator::CopyTrackState(const edm4hep::TrackState & pTrackState, pando
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-void TrackCreator::TrackReachesECAL(const edm4hep::Track *const pTrack, PandoraApi::Track::Parameters &trackParameters) const
+void TrackCreator::SummariseTrackHits(const edm4hep::Track *const pTrack, TrackHitSummary &hitSummary) const
 {
-    
-    // Calculate hit position information
-    float hitZMin(std::numeric_limits<float>::max());
-    float hitZMax(-std::numeric_limits<float>::max());
-    float hitOuterR(-std::numeric_limits<float>::max());
-
-    int maxOccupiedFtdLayer=0;
-    
-    
-    const unsigned int nTrackHits(pTrack->trackerHits_size());
-    for (unsigned int i = 0; i < nTrackHits; ++i)
+    for (std::vector<edm4hep::ConstTrackerHit>::const_iterator iter = pTrack->trackerHits_begin(), iterEnd = pTrack->trackerHits_end(); iter != iterEnd; ++iter)
     {
-        
-        const edm4hep::ConstTrackerHit Hit ( pTrack->getTrackerHits(i) );
-        const edm4hep::Vector3d pos = Hit.getPosition();
-        
+        const edm4hep::Vector3d pos = (*iter).getPosition();
+
         float x = float(pos[0]);
         float y = float(pos[1]);
         float z = float(pos[2]);
         float r = std::sqrt(x * x + y * y);
+        const float absoluteZ(std::fabs(z));
 
-        if (z > hitZMax) hitZMax = z;
+        if (z > hitSummary.m_hitZMax) hitSummary.m_hitZMax = z;
 
-        if (z < hitZMin) hitZMin = z;
+        if (z < hitSummary.m_hitZMin) hitSummary.m_hitZMin = z;
 
-        if (r > hitOuterR) hitOuterR = r;
+        if (r > hitSummary.m_hitOuterR) hitSummary.m_hitOuterR = r;
 
-        if ((r > m_tpcInnerR) && (r < m_tpcOuterR) && (std::fabs(z) <= m_tpcZmax))  continue;
+        if (r < hitSummary.m_hitInnerR) hitSummary.m_hitInnerR = r;
+
+        if (absoluteZ < hitSummary.m_hitAbsZMin) hitSummary.m_hitAbsZMin = absoluteZ;
+
+        if ((r > m_tpcInnerR) && (r < m_tpcOuterR) && (absoluteZ <= m_tpcZmax))  continue;
 
         for (unsigned int j = 0; j < m_nFtdLayers; ++j)
         {
             if ((r > m_ftdInnerRadii[j]) && (r < m_ftdOuterRadii[j]) &&
-                (std::fabs(z) - m_settings.m_reachesECalFtdZMaxDistance < m_ftdZPositions[j]) &&
-                (std::fabs(z) + m_settings.m_reachesECalFtdZMaxDistance > m_ftdZPositions[j]))
+                (absoluteZ - m_settings.m_reachesECalFtdZMaxDistance < m_ftdZPositions[j]) &&
+                (absoluteZ + m_settings.m_reachesECalFtdZMaxDistance > m_ftdZPositions[j]))
             {
-                if ( j > maxOccupiedFtdLayer) maxOccupiedFtdLayer = j;
+                if (static_cast<int>(j) > hitSummary.m_maxOccupiedFtdLayer) hitSummary.m_maxOccupiedFtdLayer = j;
                 break;
             }
         }
     }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+int TrackCreator::GetNExpectedFtdHits(const float tanLambda) const
+{
+    int expectedFtdHits(0);
+
+    for (unsigned int iFtdLayer = 0; iFtdLayer < m_nFtdLayers; ++iFtdLayer)
+    {
+        if ((tanLambda > m_ftdTanLambdaMin[iFtdLayer]) && (tanLambda < m_ftdTanLambdaMax[iFtdLayer]))
+            expectedFtdHits++;
+    }
+
+    return expectedFtdHits;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void TrackCreator::TrackReachesECAL(const edm4hep::Track *const pTrack, const TrackHitSummary &hitSummary, PandoraApi::Track::Parameters &trackParameters) const
+{
+    const float hitZMin(hitSummary.m_hitZMin);
+    const float hitZMax(hitSummary.m_hitZMax);
+    const float hitOuterR(hitSummary.m_hitOuterR);
+    const int maxOccupiedFtdLayer(hitSummary.m_maxOccupiedFtdLayer);
+
     const int nTpcHits(this->GetNTpcHits(pTrack));
     const int nFtdHits(this->GetNFtdHits(pTrack));
 
@@ -705,7 +744,7 @@ void TrackCreator::TrackReachesECAL(const edm4hep::Track *const pTrack, PandoraA
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-void TrackCreator::DefineTrackPfoUsage(const edm4hep::Track *const pTrack, PandoraApi::Track::Parameters &trackParameters) const
+void TrackCreator::DefineTrackPfoUsage(const edm4hep::Track *const pTrack, const TrackHitSummary &hitSummary, PandoraApi::Track::Parameters &trackParameters) const
 {
     bool canFormPfo(false);
     bool canFormClusterlessPfo(false);
@@ -714,20 +753,7 @@ void TrackCreator::DefineTrackPfoUsage(const edm4hep::Track *const pTrack, Pando
     {
         const float d0(std::fabs(pTrack->getTrackStates(0).D0)), z0(std::fabs(pTrack->getTrackStates(0).Z0));
 
-        float rInner(std::numeric_limits<float>::max()), zMin(std::numeric_limits<float>::max());
-
-        for (std::vector<edm4hep::ConstTrackerHit>::const_iterator iter = pTrack->trackerHits_begin(), iterEnd = pTrack->trackerHits_end(); iter != iterEnd; ++iter)
-        {
-            const edm4hep::Vector3d pPosition = (*iter).getPosition(); 
-            const float x(pPosition[0]), y(pPosition[1]), absoluteZ(std::fabs(pPosition[2]));
-            const float r(std::sqrt(x * x + y * y));
-
-            if (r < rInner)
-                rInner = r;
-
-            if (absoluteZ < zMin)
-                zMin = absoluteZ;
-        }
+        const float rInner(hitSummary.m_hitInnerR), zMin(hitSummary.m_hitAbsZMin);
 
         if (this->PassesQualityCuts(pTrack, trackParameters))
         {
@@ -893,6 +919,18 @@ int TrackCreator::GetNFtdHits(const edm4hep::Track *const pTrack) const
 //------------------------------------------------------------------------------------------------------------------------------------------
 //------------------------------------------------------------------------------------------------------------------------------------------
 
+TrackCreator::TrackHitSummary::TrackHitSummary() :
+    m_hitZMin(std::numeric_limits<float>::max()),
+    m_hitZMax(-std::numeric_limits<float>::max()),
+    m_hitOuterR(-std::numeric_limits<float>::max()),
+    m_hitInnerR(std::numeric_limits<float>::max()),
+    m_hitAbsZMin(std::numeric_limits<float>::max()),
+    m_maxOccupiedFtdLayer(0)
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
 TrackCreator::Settings::Settings() :
     m_shouldFormTrackRelationships(1),
     m_minTrackHits(5),
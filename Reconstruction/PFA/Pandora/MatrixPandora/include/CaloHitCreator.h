@@ -23,14 +23,13 @@
 #include <DDRec/CellIDPositionConverter.h>
 #include "DD4hep/BitFieldCoder.h"
 
+#include "PandoraCommon/CollectionMaps.h"
 
-#include <string>
 
-typedef std::vector<edm4hep::CalorimeterHit *> CalorimeterHitVector;
+#include <string>
 
 namespace gear { class GearMgr; }
 
-class CollectionMaps;
 /**
  *  @brief  CaloHitCreator class
  */
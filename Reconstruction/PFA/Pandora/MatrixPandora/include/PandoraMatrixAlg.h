@@ -35,10 +35,12 @@
 
 #include "CaloHitCreator.h"
 #include "GeometryCreator.h"
-#include "MCParticleCreator.h"
-#include "PfoCreator.h"
 #include "TrackCreator.h"
 
+#include "PandoraCommon/CollectionMaps.h"
+#include "PandoraCommon/MCParticleCreator.h"
+#include "PandoraCommon/PfoCreator.h"
+
 #include "TROOT.h"
 #include "TTree.h"
 #include "TFile.h"
@@ -51,29 +53,6 @@ namespace pandora {class Pandora;}
 
 class IEventSeeder;
 
-class CollectionMaps
-{
-public:
-    /**
-     *  @brief  Default constructor
-     */
-    CollectionMaps();
-    void clear();
-    std::map<std::string, const edm4hep::MCParticleCollection*> CollectionMap_MC;
-    std::map<std::string, const edm4hep::CalorimeterHitCollection*> CollectionMap_CaloHit;
-    std::map<std::string, const edm4hep::VertexCollection*> CollectionMap_Vertex;
-    std::map<std::string, const edm4hep::TrackCollection*> CollectionMap_Track;
-
-    std::map<std::string, std::vector<edm4hep::MCParticle> >     collectionMap_MC;
-    std::map<std::string, std::vector<edm4hep::CalorimeterHit> > collectionMap_CaloHit;
-    std::map<std::string, std::vector<edm4hep::Vertex> >         collectionMap_Vertex;
-    std::map<std::string, std::vector<edm4hep::Track> >          collectionMap_Track;
-    std::map<std::string, std::vector<edm4hep::MCRecoCaloAssociation> > collectionMap_CaloRel;
-    std::map<std::string, std::vector<edm4hep::MCRecoTrackerAssociation> > collectionMap_TrkRel;
-};
-
-
-
 class PandoraMatrixAlg : public GaudiAlgorithm
 {
   //friend class AlgFactory<PandoraMatrixAlg>;//gives error in 97 version
@@ -129,7 +108,6 @@ public:
      */
     const pandora::Pandora *GetPandora() const;
     StatusCode updateMap();
-    StatusCode updateMap(CollectionMaps & tmp_map);
     StatusCode Ana();
     StatusCode CreateMCRecoParticleAssociation();
     //StatusCode Create_MC(); 
@@ -249,7 +227,7 @@ protected:
   Gaudi::Property<FloatVector>                m_OutputEnergyCorrectionPoints { this, "OutputEnergyCorrectionPoints", {} };
 
 
-  static pandora::Pandora        *m_pPandora;
+  pandora::Pandora               *m_pPandora;                    ///< The pandora instance owned by this algorithm
   GeometryCreator                *m_pGeometryCreator;             ///< The geometry creator
   CaloHitCreator                 *m_pCaloHitCreator;              ///< The calo hit creator
   TrackCreator                   *m_pTrackCreator;                ///< The track creator
@@ -258,6 +236,7 @@ protected:
  
   Settings                        m_settings;                     ///< The settings for the pandora pfa new algo
   CollectionMaps                  *m_CollectionMaps;               ///< The settings for the pandora pfa new algo
+  const CollectionMaps            *m_pInput;                      ///< The input of the current event, own or shared
   GeometryCreator::Settings       m_geometryCreatorSettings;      ///< The geometry creator settings
   TrackCreator::Settings          m_trackCreatorSettings;         ///< The track creator settings
   CaloHitCreator::Settings        m_caloHitCreatorSettings;       ///< The calo hit creator settings
@@ -297,6 +276,9 @@ protected:
   Gaudi::Property< std::string >              m_AnaOutput{ this, "AnaOutput", "/junofs/users/wxfang/MyGit/CEPCSW/Reconstruction/PFA/Pandora/GaudiPandora/Ana.root" };
   //######################
   
+  Gaudi::Property<bool>                       m_UseSharedInput{ this, "UseSharedInput", false, "Read the collection maps prepared by PandoraInputAlg instead of the collections" };
+  Gaudi::Property<std::string>                m_SharedInputLocation{ this, "ReadCollectionMaps", "PandoraInputMaps", "Event store location of the input collection maps prepared by PandoraInputAlg" };
+
   DataHandle<edm4hep::MCParticleCollection>     m_mcParCol_r  {"MCParticle", Gaudi::DataHandle::Reader, this};
   DataHandle<edm4hep::CalorimeterHitCollection> m_ECALBarrel_r{"ECALBarrel", Gaudi::DataHandle::Reader, this};
   DataHandle<edm4hep::CalorimeterHitCollection> m_ECALEndcap_r{"ECALEndcap", Gaudi::DataHandle::Reader, this};
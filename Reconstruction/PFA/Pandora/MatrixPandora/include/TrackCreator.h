@@ -22,11 +22,10 @@
 #include "Api/PandoraApi.h"
 #include "Objects/Helix.h"
 
-namespace gear { class GearMgr; }
+#include "PandoraCommon/CollectionMaps.h"
 
-class CollectionMaps;
+namespace gear { class GearMgr; }
 
-typedef std::vector<const edm4hep::Track *> TrackVector;
 //typedef std::set<const edm4hep::Track *> TrackList;
 typedef std::set<unsigned int> TrackList;
 //typedef std::map<edm4hep::Track *, int> TrackToPidMap;
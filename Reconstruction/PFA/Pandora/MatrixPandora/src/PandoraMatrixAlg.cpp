@@ -17,8 +17,6 @@
 
 #include "TInterpreter.h"
 
-pandora::Pandora* PandoraMatrixAlg::m_pPandora=0;
-
 DECLARE_COMPONENT( PandoraMatrixAlg )
 
 template<typename T ,typename T1>
@@ -40,6 +38,14 @@ PandoraMatrixAlg::PandoraMatrixAlg(const std::string& name, ISvcLocator* svcLoc)
     _nEvt(0)
 {
  m_CollectionMaps = new CollectionMaps();
+ m_pInput = NULL;
+ // Each algorithm instance owns its pandora instance and creators, so several configurations can run in one job
+ m_pPandora = NULL;
+ m_pGeometryCreator = NULL;
+ m_pCaloHitCreator = NULL;
+ m_pTrackCreator = NULL;
+ m_pMCParticleCreator = NULL;
+ m_pPfoCreator = NULL;
   
  declareProperty("ReadMCParticle"                      , m_mcParCol_r,                        "Handle of the MCParticle    input collection" );
  declareProperty("ReadECALBarrel"                      , m_ECALBarrel_r,                      "Handle of the ECALBarrel    input collection" );
@@ -62,6 +68,7 @@ PandoraMatrixAlg::PandoraMatrixAlg(const std::string& name, ISvcLocator* svcLoc)
  declareProperty("WriteClusterCollection"              , m_ClusterCollection_w,               "Handle of the ClusterCollection               output collection" );
  declareProperty("WriteReconstructedParticleCollection", m_ReconstructedParticleCollection_w, "Handle of the ReconstructedParticleCollection output collection" );
  declareProperty("WriteVertexCollection"               , m_VertexCollection_w,                "Handle of the VertexCollection                output collection" );
+ declareProperty("WriteMCRecoParticleAssociation"      , m_MCRecoParticleAssociation_w,       "Handle of the MCRecoParticleAssociation       output collection" );
 
 }
 
@@ -316,15 +323,24 @@ StatusCode PandoraMatrixAlg::execute()
     {
         std::cout<<"execute PandoraMatrixAlg"<<std::endl;
         
-        updateMap();
-        PANDORA_THROW_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, m_pMCParticleCreator->CreateMCParticles(*m_CollectionMaps));
-        PANDORA_THROW_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, m_pCaloHitCreator->CreateCaloHits(*m_CollectionMaps));
-        PANDORA_THROW_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, m_pMCParticleCreator->CreateCaloHitToMCParticleRelationships(*m_CollectionMaps, m_pCaloHitCreator->GetCalorimeterHitVector() ));
-        //PANDORA_THROW_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, m_pTrackCreator->CreateTrackAssociations(*m_CollectionMaps));
-        //PANDORA_THROW_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, m_pTrackCreator->CreateTracks(*m_CollectionMaps));
-        //PANDORA_THROW_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, m_pMCParticleCreator->CreateTrackToMCParticleRelationships(*m_CollectionMaps, m_pTrackCreator->GetTrackVector() ));
+        if (m_UseSharedInput)
+        {
+            m_pInput = &get<CollectionMapsObject>(m_SharedInputLocation)->getData();
+        }
+        else
+        {
+            updateMap();
+            m_pInput = m_CollectionMaps;
+        }
+
+        PANDORA_THROW_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, m_pMCParticleCreator->CreateMCParticles(*m_pInput));
+        PANDORA_THROW_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, m_pCaloHitCreator->CreateCaloHits(*m_pInput));
+        PANDORA_THROW_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, m_pMCParticleCreator->CreateCaloHitToMCParticleRelationships(*m_pInput, m_pCaloHitCreator->GetCalorimeterHitVector() ));
+        //PANDORA_THROW_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, m_pTrackCreator->CreateTrackAssociations(*m_pInput));
+        //PANDORA_THROW_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, m_pTrackCreator->CreateTracks(*m_pInput));
+        //PANDORA_THROW_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, m_pMCParticleCreator->CreateTrackToMCParticleRelationships(*m_pInput, m_pTrackCreator->GetTrackVector() ));
         PANDORA_THROW_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, PandoraApi::ProcessEvent(*m_pPandora));
-        PANDORA_THROW_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, m_pPfoCreator->CreateParticleFlowObjects(*m_CollectionMaps, m_ClusterCollection_w, m_ReconstructedParticleCollection_w, m_VertexCollection_w));
+        PANDORA_THROW_RESULT_IF(pandora::STATUS_CODE_SUCCESS, !=, m_pPfoCreator->CreateParticleFlowObjects(*m_pInput, m_ClusterCollection_w, m_ReconstructedParticleCollection_w, m_VertexCollection_w));
         
         StatusCode sc0 = CreateMCRecoParticleAssociation();
         StatusCode sc = Ana();
@@ -355,12 +371,19 @@ StatusCode PandoraMatrixAlg::finalize()
   m_fout->cd();
   m_tree->Write();
   m_fout->Close();
-  delete m_pPandora;
+  // The creators refer to the pandora instance, so they go first
   delete m_pGeometryCreator;
   delete m_pCaloHitCreator;
   delete m_pTrackCreator;
   delete m_pMCParticleCreator;
   delete m_pPfoCreator;
+  delete m_pPandora;
+  m_pGeometryCreator = NULL;
+  m_pCaloHitCreator = NULL;
+  m_pTrackCreator = NULL;
+  m_pMCParticleCreator = NULL;
+  m_pPfoCreator = NULL;
+  m_pPandora = NULL;
   return GaudiAlgorithm::finalize();
 }
 
@@ -419,6 +442,7 @@ void PandoraMatrixAlg::Reset()
     m_hasConversion = 0;
 
     m_CollectionMaps->clear();
+    m_pInput = NULL;
 }
 
 const pandora::Pandora *PandoraMatrixAlg::GetPandora() const
@@ -434,22 +458,6 @@ PandoraMatrixAlg::Settings::Settings() :
     m_muonEndCapBField(0.01f)
 {
 }
-CollectionMaps::CollectionMaps()
-{
-}
-void CollectionMaps::clear()
-{
-CollectionMap_MC.clear();
-CollectionMap_CaloHit.clear();
-CollectionMap_Vertex.clear();
-CollectionMap_Track.clear();
-collectionMap_MC.clear();
-collectionMap_CaloHit.clear();
-collectionMap_Vertex.clear();
-collectionMap_Track.clear();
-collectionMap_CaloRel.clear();
-collectionMap_TrkRel.clear();
-}
 
 StatusCode PandoraMatrixAlg::updateMap()
 {
@@ -491,333 +499,36 @@ StatusCode PandoraMatrixAlg::updateMap()
         sc =  getCol(m_MCRecoCaloAssociation_r , mcRecoCaloAssociation   );        
         sc =  getCol(m_MCRecoTrackerAssociation_r , mcRecoTrackerAssociation);        
 
-        if (NULL != MCParticle   )  
-        {
-            std::vector<edm4hep::MCParticle> v_mc;
-            m_CollectionMaps->CollectionMap_MC ["MCParticle"] = MCParticle ;
-            m_CollectionMaps->collectionMap_MC ["MCParticle"] = v_mc;
-            for(unsigned int i=0 ; i< MCParticle->size(); i++) m_CollectionMaps->collectionMap_MC ["MCParticle"].push_back(MCParticle->at(i));
-        }
-        if (NULL != ECALBarrel   )
-        {
-            std::vector<edm4hep::CalorimeterHit> v_cal;
-            m_CollectionMaps->CollectionMap_CaloHit["ECALBarrel"] = ECALBarrel ;
-            m_CollectionMaps->collectionMap_CaloHit["ECALBarrel"] = v_cal ;
-            for(unsigned int i=0 ; i< ECALBarrel->size(); i++) m_CollectionMaps->collectionMap_CaloHit ["ECALBarrel"].push_back(ECALBarrel->at(i));
-        }
-        if (NULL != ECALEndcap   )
-        {
-            std::vector<edm4hep::CalorimeterHit> v_cal;
-            m_CollectionMaps->CollectionMap_CaloHit["ECALEndcap"] = ECALEndcap ;
-            m_CollectionMaps->collectionMap_CaloHit["ECALEndcap"] = v_cal ;
-            for(unsigned int i=0 ; i< ECALEndcap->size(); i++) m_CollectionMaps->collectionMap_CaloHit ["ECALEndcap"].push_back(ECALEndcap->at(i));
-        }
-        if (NULL != ECALOther   )
-        {
-            std::vector<edm4hep::CalorimeterHit> v_cal;
-            m_CollectionMaps->CollectionMap_CaloHit["ECALOther"] = ECALOther ;
-            m_CollectionMaps->collectionMap_CaloHit["ECALOther"] = v_cal ;
-            for(unsigned int i=0 ; i< ECALOther->size(); i++) m_CollectionMaps->collectionMap_CaloHit ["ECALOther"].push_back(ECALOther->at(i));
-        }
-        if (NULL != HCALBarrel   )
-        {
-            std::vector<edm4hep::CalorimeterHit> v_cal;
-            m_CollectionMaps->CollectionMap_CaloHit["HCALBarrel"] = HCALBarrel ;
-            m_CollectionMaps->collectionMap_CaloHit["HCALBarrel"] = v_cal ;
-            for(unsigned int i=0 ; i< HCALBarrel->size(); i++) m_CollectionMaps->collectionMap_CaloHit ["HCALBarrel"].push_back(HCALBarrel->at(i));
-        }
-        if (NULL != HCALEndcap   )
-        {
-            std::vector<edm4hep::CalorimeterHit> v_cal;
-            m_CollectionMaps->CollectionMap_CaloHit["HCALEndcap"] = HCALEndcap ;
-            m_CollectionMaps->collectionMap_CaloHit["HCALEndcap"] = v_cal ;
-            for(unsigned int i=0 ; i< HCALEndcap->size(); i++) m_CollectionMaps->collectionMap_CaloHit ["HCALEndcap"].push_back(HCALEndcap->at(i));
-        }
-        if (NULL != HCALOther   )
-        {
-            std::vector<edm4hep::CalorimeterHit> v_cal;
-            m_CollectionMaps->CollectionMap_CaloHit["HCALOther"] = HCALOther ;
-            m_CollectionMaps->collectionMap_CaloHit["HCALOther"] = v_cal ;
-            for(unsigned int i=0 ; i< HCALOther->size(); i++) m_CollectionMaps->collectionMap_CaloHit ["HCALOther"].push_back(HCALOther->at(i));
-        }
-        if (NULL != MUON   )
-        {
-            std::vector<edm4hep::CalorimeterHit> v_cal;
-            m_CollectionMaps->CollectionMap_CaloHit["MUON"] = MUON ;
-            m_CollectionMaps->collectionMap_CaloHit["MUON"] = v_cal ;
-            for(unsigned int i=0 ; i< MUON->size(); i++) m_CollectionMaps->collectionMap_CaloHit ["MUON"].push_back(MUON->at(i));
-        }
-        if (NULL != LCAL   )
-        {
-            std::vector<edm4hep::CalorimeterHit> v_cal;
-            m_CollectionMaps->CollectionMap_CaloHit["LCAL"] = LCAL ;
-            m_CollectionMaps->collectionMap_CaloHit["LCAL"] = v_cal ;
-            for(unsigned int i=0 ; i< LCAL->size(); i++) m_CollectionMaps->collectionMap_CaloHit ["LCAL"].push_back(LCAL->at(i));
-        }
-        if (NULL != LHCAL   )
-        {
-            std::vector<edm4hep::CalorimeterHit> v_cal;
-            m_CollectionMaps->CollectionMap_CaloHit["LHCAL"] = LHCAL ;
-            m_CollectionMaps->collectionMap_CaloHit["LHCAL"] = v_cal ;
-            for(unsigned int i=0 ; i< LHCAL->size(); i++) m_CollectionMaps->collectionMap_CaloHit ["LHCAL"].push_back(LHCAL->at(i));
-        }
-        if (NULL != BCAL   )
-        {
-            std::vector<edm4hep::CalorimeterHit> v_cal;
-            m_CollectionMaps->CollectionMap_CaloHit["BCAL"] = BCAL ;
-            m_CollectionMaps->collectionMap_CaloHit["BCAL"] = v_cal ;
-            for(unsigned int i=0 ; i< BCAL->size(); i++) m_CollectionMaps->collectionMap_CaloHit ["BCAL"].push_back(BCAL->at(i));
-        }
-        if (NULL != KinkVertices   )
-        {
-            std::vector<edm4hep::Vertex> v_cal;
-            m_CollectionMaps->CollectionMap_Vertex["KinkVertices"] = KinkVertices ;
-            m_CollectionMaps->collectionMap_Vertex["KinkVertices"] = v_cal ;
-            for(unsigned int i=0 ; i< KinkVertices->size(); i++) m_CollectionMaps->collectionMap_Vertex ["KinkVertices"].push_back(KinkVertices->at(i));
-        }
-        if (NULL != ProngVertices   )
-        {
-            std::vector<edm4hep::Vertex> v_cal;
-            m_CollectionMaps->CollectionMap_Vertex["ProngVertices"] = ProngVertices ;
-            m_CollectionMaps->collectionMap_Vertex["ProngVertices"] = v_cal ;
-            for(unsigned int i=0 ; i< ProngVertices->size(); i++) m_CollectionMaps->collectionMap_Vertex ["ProngVertices"].push_back(ProngVertices->at(i));
-        }
-        if (NULL != SplitVertices   )
-        {
-            std::vector<edm4hep::Vertex> v_cal;
-            m_CollectionMaps->CollectionMap_Vertex["SplitVertices"] = SplitVertices ;
-            m_CollectionMaps->collectionMap_Vertex["SplitVertices"] = v_cal ;
-            for(unsigned int i=0 ; i< SplitVertices->size(); i++) m_CollectionMaps->collectionMap_Vertex ["SplitVertices"].push_back(SplitVertices->at(i));
-        }
-        if (NULL != V0Vertices   )
-        {
-            std::vector<edm4hep::Vertex> v_cal;
-            m_CollectionMaps->CollectionMap_Vertex["V0Vertices"] = V0Vertices ;
-            m_CollectionMaps->collectionMap_Vertex["V0Vertices"] = v_cal ;
-            for(unsigned int i=0 ; i< V0Vertices->size(); i++) m_CollectionMaps->collectionMap_Vertex ["V0Vertices"].push_back(V0Vertices->at(i));
-        }
-        if (NULL != MarlinTrkTracks   )
-        {
-            std::vector<edm4hep::Track> v_cal;
-            m_CollectionMaps->CollectionMap_Track["MarlinTrkTracks"] = MarlinTrkTracks ;
-            m_CollectionMaps->collectionMap_Track["MarlinTrkTracks"] = v_cal ;
-            for(unsigned int i=0 ; i< MarlinTrkTracks->size(); i++) m_CollectionMaps->collectionMap_Track ["MarlinTrkTracks"].push_back(MarlinTrkTracks->at(i));
-        }
-        if (NULL != mcRecoCaloAssociation )
-        {
-            std::vector<edm4hep::MCRecoCaloAssociation> v_cal;
-            m_CollectionMaps->collectionMap_CaloRel["RecoCaloAssociation_ECALBarrel"] = v_cal ;
-            for(unsigned int i=0 ; i< mcRecoCaloAssociation->size(); i++) m_CollectionMaps->collectionMap_CaloRel ["RecoCaloAssociation_ECALBarrel"].push_back(mcRecoCaloAssociation->at(i));
-        }
-        
-        else
-        {
-            if (NULL != MCParticle   )
+        if (NULL != MCParticle   ) m_CollectionMaps->AddMCParticles("MCParticle", MCParticle);
+        if (NULL != ECALBarrel   ) m_CollectionMaps->AddCaloHits   ("ECALBarrel", ECALBarrel);
+        if (NULL != ECALEndcap   ) m_CollectionMaps->AddCaloHits   ("ECALEndcap", ECALEndcap);
+        if (NULL != ECALOther    ) m_CollectionMaps->AddCaloHits   ("ECALOther" , ECALOther );
+        if (NULL != HCALBarrel   ) m_CollectionMaps->AddCaloHits   ("HCALBarrel", HCALBarrel);
+        if (NULL != HCALEndcap   ) m_CollectionMaps->AddCaloHits   ("HCALEndcap", HCALEndcap);
+        if (NULL != HCALOther    ) m_CollectionMaps->AddCaloHits   ("HCALOther" , HCALOther );
+        if (NULL != MUON         ) m_CollectionMaps->AddCaloHits   ("MUON"      , MUON      );
+        if (NULL != LCAL         ) m_CollectionMaps->AddCaloHits   ("LCAL"      , LCAL      );
+        if (NULL != LHCAL        ) m_CollectionMaps->AddCaloHits   ("LHCAL"     , LHCAL     );
+        if (NULL != BCAL         ) m_CollectionMaps->AddCaloHits   ("BCAL"      , BCAL      );
+        if (NULL != KinkVertices ) m_CollectionMaps->AddVertices   ("KinkVertices" , KinkVertices );
+        if (NULL != ProngVertices) m_CollectionMaps->AddVertices   ("ProngVertices", ProngVertices);
+        if (NULL != SplitVertices) m_CollectionMaps->AddVertices   ("SplitVertices", SplitVertices);
+        if (NULL != V0Vertices   ) m_CollectionMaps->AddVertices   ("V0Vertices"   , V0Vertices   );
+        if (NULL != MarlinTrkTracks) m_CollectionMaps->AddTracks   ("MarlinTrkTracks", MarlinTrkTracks);
+
+        if (NULL != mcRecoCaloAssociation ) m_CollectionMaps->AddCaloRelations("RecoCaloAssociation_ECALBarrel", mcRecoCaloAssociation);
+        else if (NULL != MCParticle   )
+        {
+            for(unsigned int i=0 ; i< MCParticle->size(); i++)
             {
-                for(unsigned int i=0 ; i< MCParticle->size(); i++)
-                {
-                    if(MCParticle->at(i).parents_size()==0)
-                    {
-                        std::cout<<"create recoCaloAssociation by hand now"<<std::endl;
-                        for(std::map<std::string, std::vector<edm4hep::CalorimeterHit> >::iterator iter = m_CollectionMaps->collectionMap_CaloHit.begin(); iter != m_CollectionMaps->collectionMap_CaloHit.end(); iter++)
-                        {
-                            std::string prefix = "RecoCaloAssociation_";
-                            std::string key = prefix + iter->first;
-                            std::cout<<"create for "<<key<<std::endl;
-                            std::vector<edm4hep::MCRecoCaloAssociation> v_cal;
-                            m_CollectionMaps->collectionMap_CaloRel[key] = v_cal ;
-                            for(std::vector<edm4hep::CalorimeterHit>::iterator it=iter->second.begin(); it != iter->second.end(); it ++)
-                            {
-                                edm4hep::SimCalorimeterHit sim_hit( it->getCellID(), it->getEnergy(), it->getPosition() );
-                                edm4hep::CaloHitContribution conb ( MCParticle->at(i).getPDG(), it->getEnergy(), 0, it->getPosition() ); 
-                                conb.setParticle( MCParticle->at(i) );
-                                sim_hit.addToContributions(conb);
-                                edm4hep::MCRecoCaloAssociation calo_association;
-                                calo_association.setRec(*it);
-                                calo_association.setSim(sim_hit);
-                                m_CollectionMaps->collectionMap_CaloRel[key].push_back(calo_association); 
-                            }
-                        }
-                        break;
-                    }
-                }
+                if(MCParticle->at(i).parents_size()!=0) continue;
+                std::cout<<"create recoCaloAssociation by hand now"<<std::endl;
+                m_CollectionMaps->CreateCaloRelations(MCParticle->at(i), "RecoCaloAssociation_");
+                break;
             }
         }
-        
-        if (NULL != mcRecoTrackerAssociation )
-        {
-            std::vector<edm4hep::MCRecoTrackerAssociation> v_cal;
-            m_CollectionMaps->collectionMap_TrkRel["RecoTrackerAssociation"] = v_cal ;
-            for(unsigned int i=0 ; i< mcRecoTrackerAssociation->size(); i++) m_CollectionMaps->collectionMap_TrkRel ["RecoTrackerAssociation"].push_back(mcRecoTrackerAssociation->at(i));
-        }
-    return StatusCode::SUCCESS;
-}
-
-
-StatusCode PandoraMatrixAlg::updateMap(CollectionMaps & tmp_map)
-{
-        const edm4hep::MCParticleCollection*     MCParticle = nullptr;
-        const edm4hep::CalorimeterHitCollection* ECALBarrel = nullptr;        
-        const edm4hep::CalorimeterHitCollection* ECALEndcap = nullptr; 
-        const edm4hep::CalorimeterHitCollection* ECALOther  = nullptr; 
-        const edm4hep::CalorimeterHitCollection* HCALBarrel = nullptr; 
-        const edm4hep::CalorimeterHitCollection* HCALEndcap = nullptr; 
-        const edm4hep::CalorimeterHitCollection* HCALOther  = nullptr; 
-        const edm4hep::CalorimeterHitCollection* MUON       = nullptr; 
-        const edm4hep::CalorimeterHitCollection* LCAL       = nullptr; 
-        const edm4hep::CalorimeterHitCollection* LHCAL      = nullptr; 
-        const edm4hep::CalorimeterHitCollection* BCAL       = nullptr; 
-        const edm4hep::VertexCollection* KinkVertices       = nullptr; 
-        const edm4hep::VertexCollection* ProngVertices      = nullptr; 
-        const edm4hep::VertexCollection* SplitVertices      = nullptr; 
-        const edm4hep::VertexCollection* V0Vertices         = nullptr; 
-        const edm4hep::TrackCollection*  MarlinTrkTracks    = nullptr; 
-        const edm4hep::MCRecoCaloAssociationCollection*  mcRecoCaloAssociation    = nullptr; 
-        const edm4hep::MCRecoTrackerAssociationCollection*  mcRecoTrackerAssociation    = nullptr; 
-        StatusCode sc = StatusCode::SUCCESS;
-        sc =  getCol(m_mcParCol_r  , MCParticle );
-        sc =  getCol(m_ECALBarrel_r, ECALBarrel );
-        sc =  getCol(m_ECALEndcap_r, ECALEndcap );
-        sc =  getCol(m_ECALOther_r , ECALOther  );
-        sc =  getCol(m_HCALBarrel_r, HCALBarrel );
-        sc =  getCol(m_HCALEndcap_r, HCALEndcap );
-        sc =  getCol(m_HCALOther_r , HCALOther  );
-        sc =  getCol(m_MUON_r      , MUON       );
-        sc =  getCol(m_LCAL_r      , LCAL       );
-        sc =  getCol(m_LHCAL_r     , LHCAL      );
-        sc =  getCol(m_BCAL_r      , BCAL       );        
-        sc =  getCol(m_KinkVertices_r  , KinkVertices );        
-        sc =  getCol(m_ProngVertices_r , ProngVertices);        
-        sc =  getCol(m_SplitVertices_r , SplitVertices);        
-        sc =  getCol(m_V0Vertices_r    , V0Vertices   );        
-        sc =  getCol(m_MarlinTrkTracks_r , MarlinTrkTracks   );        
-        sc =  getCol(m_MCRecoCaloAssociation_r , mcRecoCaloAssociation   );        
-        sc =  getCol(m_MCRecoTrackerAssociation_r , mcRecoTrackerAssociation  );        
 
-        if (NULL != MCParticle   )  
-        {
-            std::vector<edm4hep::MCParticle> v_mc;
-            tmp_map.CollectionMap_MC ["MCParticle"] = MCParticle ;
-            tmp_map.collectionMap_MC ["MCParticle"] = v_mc;
-            for(unsigned int i=0 ; i< MCParticle->size(); i++) tmp_map.collectionMap_MC ["MCParticle"].push_back(MCParticle->at(i));
-        }
-        if (NULL != ECALBarrel   )
-        {
-            std::vector<edm4hep::CalorimeterHit> v_cal;
-            tmp_map.CollectionMap_CaloHit["ECALBarrel"] = ECALBarrel ;
-            tmp_map.collectionMap_CaloHit["ECALBarrel"] = v_cal ;
-            for(unsigned int i=0 ; i< ECALBarrel->size(); i++) tmp_map.collectionMap_CaloHit ["ECALBarrel"].push_back(ECALBarrel->at(i));
-        }
-        if (NULL != ECALEndcap   )
-        {
-            std::vector<edm4hep::CalorimeterHit> v_cal;
-            tmp_map.CollectionMap_CaloHit["ECALEndcap"] = ECALEndcap ;
-            tmp_map.collectionMap_CaloHit["ECALEndcap"] = v_cal ;
-            for(unsigned int i=0 ; i< ECALEndcap->size(); i++) tmp_map.collectionMap_CaloHit ["ECALEndcap"].push_back(ECALEndcap->at(i));
-        }
-        if (NULL != ECALOther   )
-        {
-            std::vector<edm4hep::CalorimeterHit> v_cal;
-            tmp_map.CollectionMap_CaloHit["ECALOther"] = ECALOther ;
-            tmp_map.collectionMap_CaloHit["ECALOther"] = v_cal ;
-            for(unsigned int i=0 ; i< ECALOther->size(); i++) tmp_map.collectionMap_CaloHit ["ECALOther"].push_back(ECALOther->at(i));
-        }
-        if (NULL != HCALBarrel   )
-        {
-            std::vector<edm4hep::CalorimeterHit> v_cal;
-            tmp_map.CollectionMap_CaloHit["HCALBarrel"] = HCALBarrel ;
-            tmp_map.collectionMap_CaloHit["HCALBarrel"] = v_cal ;
-            for(unsigned int i=0 ; i< HCALBarrel->size(); i++) tmp_map.collectionMap_CaloHit ["HCALBarrel"].push_back(HCALBarrel->at(i));
-        }
-        if (NULL != HCALEndcap   )
-        {
-            std::vector<edm4hep::CalorimeterHit> v_cal;
-            tmp_map.CollectionMap_CaloHit["HCALEndcap"] = HCALEndcap ;
-            tmp_map.collectionMap_CaloHit["HCALEndcap"] = v_cal ;
-            for(unsigned int i=0 ; i< HCALEndcap->size(); i++) tmp_map.collectionMap_CaloHit ["HCALEndcap"].push_back(HCALEndcap->at(i));
-        }
-        if (NULL != HCALOther   )
-        {
-            std::vector<edm4hep::CalorimeterHit> v_cal;
-            tmp_map.CollectionMap_CaloHit["HCALOther"] = HCALOther ;
-            tmp_map.collectionMap_CaloHit["HCALOther"] = v_cal ;
-            for(unsigned int i=0 ; i< HCALOther->size(); i++) tmp_map.collectionMap_CaloHit ["HCALOther"].push_back(HCALOther->at(i));
-        }
-        if (NULL != MUON   )
-        {
-            std::vector<edm4hep::CalorimeterHit> v_cal;
-            tmp_map.CollectionMap_CaloHit["MUON"] = MUON ;
-            tmp_map.collectionMap_CaloHit["MUON"] = v_cal ;
-            for(unsigned int i=0 ; i< MUON->size(); i++) tmp_map.collectionMap_CaloHit ["MUON"].push_back(MUON->at(i));
-        }
-        if (NULL != LCAL   )
-        {
-            std::vector<edm4hep::CalorimeterHit> v_cal;
-            tmp_map.CollectionMap_CaloHit["LCAL"] = LCAL ;
-            tmp_map.collectionMap_CaloHit["LCAL"] = v_cal ;
-            for(unsigned int i=0 ; i< LCAL->size(); i++) tmp_map.collectionMap_CaloHit ["LCAL"].push_back(LCAL->at(i));
-        }
-        if (NULL != LHCAL   )
-        {
-            std::vector<edm4hep::CalorimeterHit> v_cal;
-            tmp_map.CollectionMap_CaloHit["LHCAL"] = LHCAL ;
-            tmp_map.collectionMap_CaloHit["LHCAL"] = v_cal ;
-            for(unsigned int i=0 ; i< LHCAL->size(); i++) tmp_map.collectionMap_CaloHit ["LHCAL"].push_back(LHCAL->at(i));
-        }
-        if (NULL != BCAL   )
-        {
-            std::vector<edm4hep::CalorimeterHit> v_cal;
-            tmp_map.CollectionMap_CaloHit["BCAL"] = BCAL ;
-            tmp_map.collectionMap_CaloHit["BCAL"] = v_cal ;
-            for(unsigned int i=0 ; i< BCAL->size(); i++) tmp_map.collectionMap_CaloHit ["BCAL"].push_back(BCAL->at(i));
-        }
-        if (NULL != KinkVertices   )
-        {
-            std::vector<edm4hep::Vertex> v_cal;
-            tmp_map.CollectionMap_Vertex["KinkVertices"] = KinkVertices ;
-            tmp_map.collectionMap_Vertex["KinkVertices"] = v_cal ;
-            for(unsigned int i=0 ; i< KinkVertices->size(); i++) tmp_map.collectionMap_Vertex ["KinkVertices"].push_back(KinkVertices->at(i));
-        }
-        if (NULL != ProngVertices   )
-        {
-            std::vector<edm4hep::Vertex> v_cal;
-            tmp_map.CollectionMap_Vertex["ProngVertices"] = ProngVertices ;
-            tmp_map.collectionMap_Vertex["ProngVertices"] = v_cal ;
-            for(unsigned int i=0 ; i< ProngVertices->size(); i++) tmp_map.collectionMap_Vertex ["ProngVertices"].push_back(ProngVertices->at(i));
-        }
-        if (NULL != SplitVertices   )
-        {
-            std::vector<edm4hep::Vertex> v_cal;
-            tmp_map.CollectionMap_Vertex["SplitVertices"] = SplitVertices ;
-            tmp_map.collectionMap_Vertex["SplitVertices"] = v_cal ;
-            for(unsigned int i=0 ; i< SplitVertices->size(); i++) tmp_map.collectionMap_Vertex ["SplitVertices"].push_back(SplitVertices->at(i));
-        }
-        if (NULL != V0Vertices   )
-        {
-            std::vector<edm4hep::Vertex> v_cal;
-            tmp_map.CollectionMap_Vertex["V0Vertices"] = V0Vertices ;
-            tmp_map.collectionMap_Vertex["V0Vertices"] = v_cal ;
-            for(unsigned int i=0 ; i< V0Vertices->size(); i++) tmp_map.collectionMap_Vertex ["V0Vertices"].push_back(V0Vertices->at(i));
-        }
-        if (NULL != MarlinTrkTracks   )
-        {
-            std::vector<edm4hep::Track> v_cal;
-            tmp_map.CollectionMap_Track["MarlinTrkTracks"] = MarlinTrkTracks ;
-            tmp_map.collectionMap_Track["MarlinTrkTracks"] = v_cal ;
-            for(unsigned int i=0 ; i< MarlinTrkTracks->size(); i++) tmp_map.collectionMap_Track ["MarlinTrkTracks"].push_back(MarlinTrkTracks->at(i));
-        }
-        if (NULL != mcRecoCaloAssociation )
-        {
-            std::vector<edm4hep::MCRecoCaloAssociation> v_cal;
-            tmp_map.collectionMap_CaloRel["RecoCaloAssociation"] = v_cal ;
-            for(unsigned int i=0 ; i< mcRecoCaloAssociation->size(); i++) tmp_map.collectionMap_CaloRel ["RecoCaloAssociation"].push_back(mcRecoCaloAssociation->at(i));
-        }
-        if (NULL != mcRecoTrackerAssociation )
-        {
-            std::vector<edm4hep::MCRecoTrackerAssociation> v_cal;
-            tmp_map.collectionMap_TrkRel["RecoTrackerAssociation"] = v_cal ;
-            for(unsigned int i=0 ; i< mcRecoTrackerAssociation->size(); i++) tmp_map.collectionMap_TrkRel ["RecoTrackerAssociation"].push_back(mcRecoTrackerAssociation->at(i));
-        }
+        if (NULL != mcRecoTrackerAssociation ) m_CollectionMaps->AddTrackRelations("RecoTrackerAssociation", mcRecoTrackerAssociation);
     return StatusCode::SUCCESS;
 }
 
@@ -923,9 +634,9 @@ StatusCode PandoraMatrixAlg::CreateMCRecoParticleAssociation()
             for(int k=0; k < cluster.hits_size(); k++)
             {
                 edm4hep::ConstCalorimeterHit hit = cluster.getHits(k);
-                for(std::map<std::string, std::vector<edm4hep::MCRecoCaloAssociation> >::iterator iter = m_CollectionMaps->collectionMap_CaloRel.begin(); iter != m_CollectionMaps->collectionMap_CaloRel.end(); iter++)
+                for(std::map<std::string, const edm4hep::MCRecoCaloAssociationCollection* >::const_iterator iter = m_pInput->collectionMap_CaloRel.begin(); iter != m_pInput->collectionMap_CaloRel.end(); iter++)
                 {
-                    for(std::vector<edm4hep::MCRecoCaloAssociation>::iterator it = iter->second.begin(); it != iter->second.end(); it ++)
+                    for(edm4hep::MCRecoCaloAssociationCollection::const_iterator it = iter->second->begin(); it != iter->second->end(); it ++)
                     {
                         if(it->getRec().id() != hit.id()) continue;
                         for(std::vector<edm4hep::ConstCaloHitContribution>::const_iterator itc = it->getSim().contributions_begin(); itc != it->getSim().contributions_end(); itc++)
@@ -0,0 +1,130 @@
+/**
+ *  @brief  Header file for the collection maps class, the pandora input of one event.
+ *
+ *  $Log: $
+ */
+
+#ifndef COLLECTION_MAPS_H
+#define COLLECTION_MAPS_H 1
+
+#include "edm4hep/MCParticle.h"
+#include "edm4hep/MCParticleCollection.h"
+#include "edm4hep/CalorimeterHit.h"
+#include "edm4hep/CalorimeterHitCollection.h"
+#include "edm4hep/Track.h"
+#include "edm4hep/TrackCollection.h"
+#include "edm4hep/VertexCollection.h"
+#include "edm4hep/MCRecoCaloAssociationCollection.h"
+#include "edm4hep/MCRecoTrackerAssociationCollection.h"
+
+#include "GaudiKernel/AnyDataWrapper.h"
+
+#include "PandoraCommon/RecoIdIndex.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+typedef std::vector<edm4hep::CalorimeterHit *> CalorimeterHitVector;
+typedef std::vector<const edm4hep::Track *> TrackVector;
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  The input collections of one event, by collection name.
+ *
+ *  MCParticles, calo hits and tracks are kept as vectors of handles (no data is copied), because the addresses of these
+ *  handles are given to pandora as parent addresses and podio collections only return temporary handles.
+ *  Vertices and associations are only read, so they are non-owning views of the collections in the event store. Each
+ *  association collection is indexed by reco hit id when it is added, so the index is built once per event.
+ *
+ *  The maps are filled once per event, either by the pandora algorithm itself or by PandoraInputAlg, which stores them
+ *  in the event store (as a CollectionMapsObject) so that several pandora algorithms in one job read the same input.
+ */
+class CollectionMaps
+{
+public:
+    /**
+     *  @brief  Default constructor
+     */
+    CollectionMaps();
+
+    /**
+     *  @brief  Move constructor, takes over the handles and the created calo hit relations
+     */
+    CollectionMaps(CollectionMaps &&rhs);
+
+    /**
+     *  @brief  Destructor
+     */
+    ~CollectionMaps();
+
+    /**
+     *  @brief  Clear the maps and delete the calo hit relations created by CreateCaloRelations
+     */
+    void clear();
+
+    /**
+     *  @brief  Add the handles of the mc particles of a collection
+     */
+    void AddMCParticles(const std::string &name, const edm4hep::MCParticleCollection *const pCollection);
+
+    /**
+     *  @brief  Add the handles of the calo hits of a collection
+     */
+    void AddCaloHits(const std::string &name, const edm4hep::CalorimeterHitCollection *const pCollection);
+
+    /**
+     *  @brief  Add the handles of the tracks of a collection
+     */
+    void AddTracks(const std::string &name, const edm4hep::TrackCollection *const pCollection);
+
+    /**
+     *  @brief  Add a view of a vertex collection
+     */
+    void AddVertices(const std::string &name, const edm4hep::VertexCollection *const pCollection);
+
+    /**
+     *  @brief  Add a view of a calo hit association collection, and index it by reco hit id
+     */
+    void AddCaloRelations(const std::string &name, const edm4hep::MCRecoCaloAssociationCollection *const pCollection);
+
+    /**
+     *  @brief  Add a view of a tracker hit association collection, and index it by reco hit id
+     */
+    void AddTrackRelations(const std::string &name, const edm4hep::MCRecoTrackerAssociationCollection *const pCollection);
+
+    /**
+     *  @brief  Associate every calo hit in the maps to one mc particle, for samples without calo hit truth. One relation
+     *          collection, owned by the maps, is made per calo hit collection and named prefix + calo hit collection name
+     *
+     *  @param  mcParticle the mc particle given all the calo hit energy
+     *  @param  prefix the prefix of the relation collection names
+     */
+    void CreateCaloRelations(const edm4hep::ConstMCParticle &mcParticle, const std::string &prefix);
+
+    std::map<std::string, std::vector<edm4hep::MCParticle> >     collectionMap_MC;
+    std::map<std::string, std::vector<edm4hep::CalorimeterHit> > collectionMap_CaloHit;
+    std::map<std::string, const edm4hep::VertexCollection* >     collectionMap_Vertex;
+    std::map<std::string, std::vector<edm4hep::Track> >          collectionMap_Track;
+    std::map<std::string, const edm4hep::MCRecoCaloAssociationCollection* > collectionMap_CaloRel;
+    std::map<std::string, const edm4hep::MCRecoTrackerAssociationCollection* > collectionMap_TrkRel;
+    std::map<std::string, RecoIdIndex >                          collectionMap_CaloRelIndex;
+    std::map<std::string, RecoIdIndex >                          collectionMap_TrkRelIndex;
+
+private:
+    CollectionMaps(const CollectionMaps &);
+    CollectionMaps &operator=(const CollectionMaps &);
+
+    std::vector<edm4hep::MCRecoCaloAssociationCollection *> m_ownedCaloRelations;   ///< The relation collections made by CreateCaloRelations
+};
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  The collection maps as a plain DataObject of the event store. It is not a podio collection, so the podio data
+ *          service neither converts nor writes it
+ */
+typedef AnyDataWrapper<CollectionMaps> CollectionMapsObject;
+
+#endif // #ifndef COLLECTION_MAPS_H
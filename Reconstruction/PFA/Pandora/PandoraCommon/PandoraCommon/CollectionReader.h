@@ -0,0 +1,58 @@
+/**
+ *  @brief  Header file for the collection reader class.
+ *
+ *  $Log: $
+ */
+
+#ifndef COLLECTION_READER_H
+#define COLLECTION_READER_H 1
+
+#include "FWCore/DataHandle.h"
+
+#include "PandoraCommon/CollectionMaps.h"
+
+#include <map>
+#include <string>
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  CollectionReader class, reads the configured input collections of a pandora algorithm into the collection maps
+ */
+class CollectionReader
+{
+public:
+    /**
+     *  @brief  Default constructor
+     */
+    CollectionReader();
+
+    /**
+     *  @brief  Destructor
+     */
+    ~CollectionReader();
+
+    /**
+     *  @brief  Declare a data handle for an input collection
+     *
+     *  @param  typeAndName the collection, given as "Type:Name"
+     *  @param  pOwner the algorithm owning the data handle
+     *
+     *  @return whether the type is a supported pandora input type
+     */
+    bool DeclareCollection(const std::string &typeAndName, IDataHandleHolder *const pOwner);
+
+    /**
+     *  @brief  Fill the collection maps with the declared collections present in the event
+     */
+    void FillCollectionMaps(CollectionMaps &collectionMaps) const;
+
+private:
+    CollectionReader(const CollectionReader &);
+    CollectionReader &operator=(const CollectionReader &);
+
+    std::map<std::string, std::string>              m_collections;  ///< The map from collection name to collection type
+    std::map<std::string, DataObjectHandleBase*>    m_dataHandles;  ///< The map from collection name to its data handle
+};
+
+#endif // #ifndef COLLECTION_READER_H
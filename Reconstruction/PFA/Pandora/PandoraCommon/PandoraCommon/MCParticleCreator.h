@@ -11,14 +11,11 @@
 #include "edm4hep/MCParticle.h"
 #include "Api/PandoraApi.h"
 
-#include "CaloHitCreator.h"
-#include "TrackCreator.h"
+#include "PandoraCommon/CollectionMaps.h"
+
 /**
  *  @brief  MCParticleCreator class
  */
-
-class CollectionMaps;
-
 class MCParticleCreator
 {
 public:
@@ -23,7 +23,7 @@
 #include "DataHelper/ClusterShapes.h"
 #include "Api/PandoraApi.h"
 
-class CollectionMaps;
+#include "PandoraCommon/CollectionMaps.h"
 //------------------------------------------------------------------------------------------------------------------------------------------
 
 /**
@@ -68,11 +68,27 @@ public:
      *  @brief  Create particle flow objects
      * 
      */    
-    pandora::StatusCode CreateParticleFlowObjects(CollectionMaps& collectionMaps, DataHandle<edm4hep::ClusterCollection>& _pClusterCollection, DataHandle<edm4hep::ReconstructedParticleCollection>& _pReconstructedParticleCollection, DataHandle<edm4hep::VertexCollection>& _pStartVertexCollection);
+    pandora::StatusCode CreateParticleFlowObjects(const CollectionMaps& collectionMaps, DataHandle<edm4hep::ClusterCollection>& _pClusterCollection, DataHandle<edm4hep::ReconstructedParticleCollection>& _pReconstructedParticleCollection, DataHandle<edm4hep::VertexCollection>& _pStartVertexCollection);
 
-    CollectionMaps* m_collectionMaps;
+    const CollectionMaps* m_collectionMaps;
 
 private:
+    /**
+     *  @brief  ClusterShape class, the shape quantities of one cluster
+     */
+    class ClusterShape
+    {
+    public:
+        bool                    m_isValid;                          ///< Whether the cluster shape could be calculated
+        float                   m_phi;                              ///< The phi of the main inertia axis
+        float                   m_iTheta;                           ///< The theta of the main inertia axis
+        float                   m_position[3];                      ///< The centre of gravity
+    };
+
+    typedef std::vector<const edm4hep::CalorimeterHit *> CalorimeterHitAddressVector;
+    typedef std::vector<unsigned int> UIntVector;
+    typedef std::vector<ClusterShape> ClusterShapeVector;
+
     /**
      *  @brief  index for the subdetector
      */
@@ -94,19 +110,26 @@ private:
     void InitialiseSubDetectorNames(pandora::StringVector &subDetectorNames) const;
 
     /**
-     *  @brief  Set sub detector energies for a cluster
+     *  @brief  Gather the calo hits of all the clusters of the pfos into the contiguous per event hit arrays
+     * 
+     *  @param  pfoList the list of pandora pfos
+     */
+    void FillClusterHitArrays(const pandora::PfoList &pfoList);
+
+    /**
+     *  @brief  Calculate the shape of each cluster from its slice of the hit arrays
+     */
+    void CalculateClusterShapes();
+
+    /**
+     *  @brief  Add the hits of a cluster and set its sub detector energies
      * 
      *  @param  subDetectorNames the list of sub detector names
+     *  @param  clusterIndex the index of the cluster in the hit arrays
      *  @param  pLcioCluster the address of the cluster to be set sub detector energies
-     *  @param  pandoraCaloHitList the pandora calorimeter hit list
-     *  @param  hitE the vector to receive the energy of hits
-     *  @param  hitX the vector to receive the x position of hits
-     *  @param  hitY the vector to receive the y position of hits
-     *  @param  hitZ the vector to receive the z position of hits
      */
-    void SetClusterSubDetectorEnergies(const pandora::StringVector &subDetectorNames, edm4hep::Cluster *const pLcioCluster,
-        const pandora::CaloHitList &pandoraCaloHitList, pandora::FloatVector &hitE, pandora::FloatVector &hitX, pandora::FloatVector &hitY,
-        pandora::FloatVector &hitZ) const;
+    void SetClusterSubDetectorEnergies(const pandora::StringVector &subDetectorNames, const unsigned int clusterIndex,
+        edm4hep::Cluster *const pLcioCluster) const;
 
     /**
      *  @brief  Set cluster energies and errors
@@ -120,18 +143,13 @@ private:
         edm4hep::Cluster *const pLcioCluster, float &clusterCorrectEnergy) const;
 
     /**
-     *  @brief  Set cluster position, errors and other shape info, by calculating culster shape first
+     *  @brief  Set cluster position, errors and other shape info from the calculated cluster shape
      * 
-     *  @param  nHitsInCluster number of hits in cluster
-     *  @param  hitE the vector of the energy of hits
-     *  @param  hitX the vector of the x position of hits
-     *  @param  hitY the vector of the y position of hits
-     *  @param  hitZ the vector of the z position of hits
+     *  @param  clusterIndex the index of the cluster in the hit arrays
      *  @param  pLcioCluster the cluster to be set positions and errors
      *  @param  clusterPosition a CartesianVector to receive the cluster position
      */
-    void SetClusterPositionAndError(const unsigned int nHitsInCluster, pandora::FloatVector &hitE, pandora::FloatVector &hitX, 
-        pandora::FloatVector &hitY, pandora::FloatVector &hitZ, edm4hep::Cluster *const pLcioCluster, pandora::CartesianVector &clusterPositionVec) const;
+    void SetClusterPositionAndError(const unsigned int clusterIndex, edm4hep::Cluster *const pLcioCluster, pandora::CartesianVector &clusterPositionVec) const;
 
     /**
      *  @brief  Calculate reference point for pfo with tracks
@@ -207,6 +225,14 @@ private:
 
     const Settings              m_settings;                         ///< The pfo creator settings
     const pandora::Pandora      *m_pPandora;                        ///< Address of the pandora object from which to extract the pfos
+
+    CalorimeterHitAddressVector m_hitAddresses;                     ///< The calo hits of all the clusters of the event, cluster after cluster
+    pandora::FloatVector        m_hitE;                             ///< The energy of the hits
+    pandora::FloatVector        m_hitX;                             ///< The x position of the hits
+    pandora::FloatVector        m_hitY;                             ///< The y position of the hits
+    pandora::FloatVector        m_hitZ;                             ///< The z position of the hits
+    UIntVector                  m_clusterHitBegin;                  ///< The first hit of each cluster in the hit arrays, plus the end of the last
+    ClusterShapeVector          m_clusterShapes;                    ///< The shape of each cluster
 };
 
 #endif // #ifndef PFO_CREATOR_H
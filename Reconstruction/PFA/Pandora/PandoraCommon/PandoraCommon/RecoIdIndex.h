@@ -0,0 +1,70 @@
+/**
+ *  @brief  Header file for the reco id index class.
+ *
+ *  $Log: $
+ */
+
+#ifndef RECO_ID_INDEX_H
+#define RECO_ID_INDEX_H 1
+
+#include <algorithm>
+#include <numeric>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+/**
+ *  @brief  Index of an association collection by the id of the reconstructed hit. It is built once per event, together with
+ *          the collection maps, and shared by everything that looks up the associations of a hit.
+ *          The associations of one hit keep the order they have in the collection.
+ */
+class RecoIdIndex
+{
+public:
+    typedef std::vector<unsigned int>::const_iterator const_iterator;
+
+    /**
+     *  @brief  Default constructor, an empty index
+     */
+    RecoIdIndex()
+    {
+    }
+
+    /**
+     *  @brief  Constructor, index an association collection (MCRecoCaloAssociation or MCRecoTrackerAssociation)
+     */
+    template <typename COLLECTION>
+    explicit RecoIdIndex(const COLLECTION &collection)
+    {
+        std::vector<unsigned int> recoIds(collection.size());
+        for (unsigned int i = 0; i < collection.size(); ++i)
+            recoIds[i] = collection.at(i).getRec().id();
+
+        m_indices.resize(collection.size());
+        std::iota(m_indices.begin(), m_indices.end(), 0);
+        std::stable_sort(m_indices.begin(), m_indices.end(), [&recoIds](unsigned int a, unsigned int b){ return recoIds[a] < recoIds[b]; });
+
+        m_ranges.reserve(m_indices.size());
+        for (unsigned int i = 0; i < m_indices.size(); ++i)
+            m_ranges.emplace(recoIds[m_indices[i]], std::make_pair(i, i)).first->second.second = i + 1;
+    }
+
+    /**
+     *  @brief  Get the indices in the collection of the associations of a reconstructed hit
+     */
+    std::pair<const_iterator, const_iterator> Find(const unsigned int recoId) const
+    {
+        std::unordered_map<unsigned int, std::pair<unsigned int, unsigned int> >::const_iterator iter = m_ranges.find(recoId);
+        if (m_ranges.end() == iter)
+            return std::make_pair(m_indices.end(), m_indices.end());
+        return std::make_pair(m_indices.begin() + iter->second.first, m_indices.begin() + iter->second.second);
+    }
+
+private:
+    std::vector<unsigned int>                                                 m_indices;  ///< The association indices, sorted by reco id
+    std::unordered_map<unsigned int, std::pair<unsigned int, unsigned int> >  m_ranges;   ///< The range [begin, end) in m_indices per reco id
+};
+
+#endif // #ifndef RECO_ID_INDEX_H
@@ -0,0 +1,135 @@
+/**
+ *  @brief  Implementation of the collection maps class.
+ *
+ *  $Log: $
+ */
+
+#include "edm4hep/SimCalorimeterHit.h"
+#include "edm4hep/CaloHitContribution.h"
+#include "edm4hep/MCRecoCaloAssociation.h"
+
+#include "PandoraCommon/CollectionMaps.h"
+
+#include <utility>
+
+CollectionMaps::CollectionMaps()
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+CollectionMaps::CollectionMaps(CollectionMaps &&rhs) :
+    collectionMap_MC(std::move(rhs.collectionMap_MC)),
+    collectionMap_CaloHit(std::move(rhs.collectionMap_CaloHit)),
+    collectionMap_Vertex(std::move(rhs.collectionMap_Vertex)),
+    collectionMap_Track(std::move(rhs.collectionMap_Track)),
+    collectionMap_CaloRel(std::move(rhs.collectionMap_CaloRel)),
+    collectionMap_TrkRel(std::move(rhs.collectionMap_TrkRel)),
+    collectionMap_CaloRelIndex(std::move(rhs.collectionMap_CaloRelIndex)),
+    collectionMap_TrkRelIndex(std::move(rhs.collectionMap_TrkRelIndex)),
+    m_ownedCaloRelations(std::move(rhs.m_ownedCaloRelations))
+{
+    // the relations now belong to this object only
+    rhs.m_ownedCaloRelations.clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+CollectionMaps::~CollectionMaps()
+{
+    this->clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void CollectionMaps::clear()
+{
+    collectionMap_MC.clear();
+    collectionMap_CaloHit.clear();
+    collectionMap_Vertex.clear();
+    collectionMap_Track.clear();
+    collectionMap_CaloRel.clear();
+    collectionMap_TrkRel.clear();
+    collectionMap_CaloRelIndex.clear();
+    collectionMap_TrkRelIndex.clear();
+
+    for (std::vector<edm4hep::MCRecoCaloAssociationCollection *>::iterator iter = m_ownedCaloRelations.begin(), iterEnd = m_ownedCaloRelations.end(); iter != iterEnd; ++iter)
+        delete *iter;
+
+    m_ownedCaloRelations.clear();
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void CollectionMaps::AddMCParticles(const std::string &name, const edm4hep::MCParticleCollection *const pCollection)
+{
+    std::vector<edm4hep::MCParticle>& v_col = collectionMap_MC[name];
+    v_col.reserve(pCollection->size());
+    for(unsigned int i=0 ; i< pCollection->size(); i++) v_col.push_back(pCollection->at(i));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void CollectionMaps::AddCaloHits(const std::string &name, const edm4hep::CalorimeterHitCollection *const pCollection)
+{
+    std::vector<edm4hep::CalorimeterHit>& v_col = collectionMap_CaloHit[name];
+    v_col.reserve(pCollection->size());
+    for(unsigned int i=0 ; i< pCollection->size(); i++) v_col.push_back(pCollection->at(i));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void CollectionMaps::AddTracks(const std::string &name, const edm4hep::TrackCollection *const pCollection)
+{
+    std::vector<edm4hep::Track>& v_col = collectionMap_Track[name];
+    v_col.reserve(pCollection->size());
+    for(unsigned int i=0 ; i< pCollection->size(); i++) v_col.push_back(pCollection->at(i));
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void CollectionMaps::AddVertices(const std::string &name, const edm4hep::VertexCollection *const pCollection)
+{
+    collectionMap_Vertex[name] = pCollection;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void CollectionMaps::AddCaloRelations(const std::string &name, const edm4hep::MCRecoCaloAssociationCollection *const pCollection)
+{
+    collectionMap_CaloRel[name] = pCollection;
+    collectionMap_CaloRelIndex[name] = RecoIdIndex(*pCollection);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void CollectionMaps::AddTrackRelations(const std::string &name, const edm4hep::MCRecoTrackerAssociationCollection *const pCollection)
+{
+    collectionMap_TrkRel[name] = pCollection;
+    collectionMap_TrkRelIndex[name] = RecoIdIndex(*pCollection);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void CollectionMaps::CreateCaloRelations(const edm4hep::ConstMCParticle &mcParticle, const std::string &prefix)
+{
+    for(std::map<std::string, std::vector<edm4hep::CalorimeterHit> >::const_iterator iter = collectionMap_CaloHit.begin(); iter != collectionMap_CaloHit.end(); iter++)
+    {
+        edm4hep::MCRecoCaloAssociationCollection *const pRelationCollection = new edm4hep::MCRecoCaloAssociationCollection();
+        m_ownedCaloRelations.push_back(pRelationCollection);
+
+        for(std::vector<edm4hep::CalorimeterHit>::const_iterator it = iter->second.begin(); it != iter->second.end(); it ++)
+        {
+            edm4hep::SimCalorimeterHit sim_hit( it->getCellID(), it->getEnergy(), it->getPosition() );
+            edm4hep::CaloHitContribution conb ( mcParticle.getPDG(), it->getEnergy(), 0, it->getPosition() );
+            conb.setParticle( mcParticle );
+            sim_hit.addToContributions(conb);
+            edm4hep::MCRecoCaloAssociation calo_association;
+            calo_association.setRec(*it);
+            calo_association.setSim(sim_hit);
+            pRelationCollection->push_back(calo_association);
+        }
+
+        this->AddCaloRelations(prefix + iter->first, pRelationCollection);
+    }
+}
@@ -0,0 +1,131 @@
+/**
+ *  @brief  Implementation of the collection reader class.
+ *
+ *  $Log: $
+ */
+
+#include "PandoraCommon/CollectionReader.h"
+
+#include <iostream>
+
+CollectionReader::CollectionReader()
+{
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+CollectionReader::~CollectionReader()
+{
+    for (std::map<std::string, DataObjectHandleBase*>::iterator iter = m_dataHandles.begin(), iterEnd = m_dataHandles.end(); iter != iterEnd; ++iter)
+        delete iter->second;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+bool CollectionReader::DeclareCollection(const std::string &typeAndName, IDataHandleHolder *const pOwner)
+{
+    auto seperater = typeAndName.find(':');
+    std::string colType = typeAndName.substr(0, seperater);
+    std::string colName = typeAndName.substr(seperater+1);
+
+    // The handle is registered with its owner, so a collection given twice keeps its first handle
+    if (m_dataHandles.end() != m_dataHandles.find(colName))
+        return (colType == m_collections[colName]);
+
+    DataObjectHandleBase *pDataHandle = NULL;
+
+    if ( colType == "MCParticle" ) {
+        pDataHandle = new DataHandle<edm4hep::MCParticleCollection>(colName, Gaudi::DataHandle::Reader, pOwner);
+    }
+    else if ( colType == "Track" ) {
+        pDataHandle = new DataHandle<edm4hep::TrackCollection>(colName, Gaudi::DataHandle::Reader, pOwner);
+    }
+    else if ( colType == "CalorimeterHit" ) {
+        pDataHandle = new DataHandle<edm4hep::CalorimeterHitCollection>(colName, Gaudi::DataHandle::Reader, pOwner);
+    }
+    else if ( colType == "Vertex" ) {
+        pDataHandle = new DataHandle<edm4hep::VertexCollection>(colName, Gaudi::DataHandle::Reader, pOwner);
+    }
+    else if ( colType == "MCRecoTrackerAssociation" ) {
+        pDataHandle = new DataHandle<edm4hep::MCRecoTrackerAssociationCollection>(colName, Gaudi::DataHandle::Reader, pOwner);
+    }
+    else if ( colType == "MCRecoCaloAssociation" ) {
+        pDataHandle = new DataHandle<edm4hep::MCRecoCaloAssociationCollection>(colName, Gaudi::DataHandle::Reader, pOwner);
+    }
+    else {
+        return false;
+    }
+
+    m_dataHandles[colName] = pDataHandle;
+    m_collections[colName] = colType;
+    return true;
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void CollectionReader::FillCollectionMaps(CollectionMaps &collectionMaps) const
+{
+    for(auto &v : m_dataHandles){
+        const std::string &colType = m_collections.find(v.first)->second;
+        try{
+            if(colType=="MCParticle"){
+                auto po = dynamic_cast<DataHandle<edm4hep::MCParticleCollection>*> (v.second)->get();
+                if(po != NULL){
+                    collectionMaps.AddMCParticles(v.first, po);
+                }
+                else{
+                std::cout<<"don't find col name="<<v.first<<std::endl;
+                }
+            }
+            else if(colType=="CalorimeterHit"){
+                auto po = dynamic_cast<DataHandle<edm4hep::CalorimeterHitCollection>*> (v.second)->get();
+                if(po != NULL){
+                    collectionMaps.AddCaloHits(v.first, po);
+                }
+                else{
+                std::cout<<"don't find col name="<<v.first<<std::endl;
+                }
+            }
+            else if(colType=="Track"){
+                auto po = dynamic_cast<DataHandle<edm4hep::TrackCollection>*> (v.second)->get();
+                if(po != NULL){
+                    collectionMaps.AddTracks(v.first, po);
+                }
+                else{
+                std::cout<<"don't find col name="<<v.first<<std::endl;
+                }
+            }
+            else if(colType=="Vertex"){
+                auto po = dynamic_cast<DataHandle<edm4hep::VertexCollection>*> (v.second)->get();
+                if(po != NULL){
+                    collectionMaps.AddVertices(v.first, po);
+                }
+                else{
+                std::cout<<"don't find col name="<<v.first<<std::endl;
+                }
+            }
+            else if(colType=="MCRecoCaloAssociation"){
+                auto po = dynamic_cast<DataHandle<edm4hep::MCRecoCaloAssociationCollection>*> (v.second)->get();
+                if(po != NULL){
+                    collectionMaps.AddCaloRelations(v.first, po);
+                }
+                else{
+                std::cout<<"don't find col name="<<v.first<<std::endl;
+                }
+            }
+            else if(colType=="MCRecoTrackerAssociation"){
+                auto po = dynamic_cast<DataHandle<edm4hep::MCRecoTrackerAssociationCollection>*> (v.second)->get();
+                if(po != NULL){
+                    collectionMaps.AddTrackRelations(v.first, po);
+                }
+                else{
+                std::cout<<"don't find col name="<<v.first<<std::endl;
+                }
+            }
+        }//try
+        catch(...){
+            std::cout<<"don't find "<<v.first<<"in event"<<std::endl;
+            std::cout<<"don't find  col name="<<v.first<<",with type="<<colType<<" in this event"<<std::endl;
+        }
+    }
+}
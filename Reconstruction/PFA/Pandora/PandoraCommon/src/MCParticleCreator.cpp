@@ -9,13 +9,14 @@
 #include "edm4hep/MCParticleConst.h"
 #include "edm4hep/MCParticle.h" 
 #include "edm4hep/MCRecoCaloAssociation.h" 
+#include "edm4hep/MCRecoCaloAssociationCollection.h" 
 #include "edm4hep/SimCalorimeterHitConst.h" 
 #include "edm4hep/CaloHitContributionConst.h" 
 #include "edm4hep/Track.h" 
 #include "edm4hep/MCRecoTrackerAssociation.h" 
+#include "edm4hep/MCRecoTrackerAssociationCollection.h" 
 #include "edm4hep/SimTrackerHitConst.h" 
-#include "PandoraPFAlg.h"
-#include "MCParticleCreator.h"
+#include "PandoraCommon/MCParticleCreator.h"
 
 #include <cmath>
 #include <limits>
@@ -117,28 +118,27 @@ pandora::StatusCode MCParticleCreator::CreateCaloHitToMCParticleRelationships(co
         if(collectionMaps.collectionMap_CaloRel.find(*iter) == collectionMaps.collectionMap_CaloRel.end()) continue;
         try
         {
-            const std::vector<edm4hep::MCRecoCaloAssociation>& pMCRecoCaloAssociationCollection = (collectionMaps.collectionMap_CaloRel.find(*iter))->second;
+            const edm4hep::MCRecoCaloAssociationCollection& pMCRecoCaloAssociationCollection = *((collectionMaps.collectionMap_CaloRel.find(*iter))->second);
+            const RecoIdIndex& caloRelIndex = (collectionMaps.collectionMap_CaloRelIndex.find(*iter))->second;
 
             for (unsigned i_calo=0; i_calo < calorimeterHitVector.size(); i_calo++)
             {
                 try
                 {
                     mcParticleToEnergyWeightMap.clear();
-                    for(unsigned ic=0; ic < pMCRecoCaloAssociationCollection.size(); ic++)
+                    const std::pair<RecoIdIndex::const_iterator, RecoIdIndex::const_iterator> range = caloRelIndex.Find((*(calorimeterHitVector.at(i_calo))).id());
+                    for (RecoIdIndex::const_iterator ic = range.first; ic != range.second; ++ic)
                     {
-                        if( pMCRecoCaloAssociationCollection.at(ic).getRec().id() != (*(calorimeterHitVector.at(i_calo))).id() ) continue;
-                        
-                        const edm4hep::ConstSimCalorimeterHit pSimHit = pMCRecoCaloAssociationCollection.at(ic).getSim();
+                        const edm4hep::ConstSimCalorimeterHit pSimHit = pMCRecoCaloAssociationCollection.at(*ic).getSim();
                         for (int iCont = 0, iEnd = pSimHit.contributions_size(); iCont < iEnd; ++iCont)
                         {
                             edm4hep::ConstCaloHitContribution conb = pSimHit.getContributions(iCont);
                             const edm4hep::ConstMCParticle ipa = conb.getParticle();
                             float  ien = conb.getEnergy();
-                            if( m_id_pMC_map->find(ipa.id()) == m_id_pMC_map->end() ) continue;
-                            const edm4hep::MCParticle * p_tmp = (*m_id_pMC_map)[ipa.id()]; 
-                            mcParticleToEnergyWeightMap[p_tmp] += ien;
+                            std::map<unsigned int, const edm4hep::MCParticle*>::const_iterator it_mc = m_id_pMC_map->find(ipa.id());
+                            if( it_mc == m_id_pMC_map->end() ) continue;
+                            mcParticleToEnergyWeightMap[it_mc->second] += ien;
                         }
-                        
                     }
 
                     for (MCParticleToEnergyWeightMap::const_iterator mcParticleIter = mcParticleToEnergyWeightMap.begin(),
@@ -170,6 +170,17 @@ pandora::StatusCode MCParticleCreator::CreateCaloHitToMCParticleRelationships(co
 
 pandora::StatusCode MCParticleCreator::CreateTrackToMCParticleRelationships(const CollectionMaps& collectionMaps, const TrackVector &trackVector) const
 {
+    // the tracker hit associations and their indices, in the order of the relation collections
+    std::vector<const edm4hep::MCRecoTrackerAssociationCollection*> trkRelCollections;
+    std::vector<const RecoIdIndex*> trkRelIndices;
+    for (StringVector::const_iterator iter = m_settings.m_TrackRelationCollections.begin(), iterEnd = m_settings.m_TrackRelationCollections.end(); iter != iterEnd; ++iter)
+    {
+        if(collectionMaps.collectionMap_TrkRel.find(*iter) == collectionMaps.collectionMap_TrkRel.end()) continue;
+        const edm4hep::MCRecoTrackerAssociationCollection* pMCRecoTrackerAssociationCollection = (collectionMaps.collectionMap_TrkRel.find(*iter))->second;
+        trkRelCollections.push_back(pMCRecoTrackerAssociationCollection);
+        trkRelIndices.push_back(&(collectionMaps.collectionMap_TrkRelIndex.find(*iter))->second);
+    }
+
     for (unsigned ik = 0; ik < trackVector.size(); ik++)
     {
         const edm4hep::Track *pTrack = trackVector.at(ik);
@@ -181,23 +192,23 @@ pandora::StatusCode MCParticleCreator::CreateTrackToMCParticleRelationships(cons
         float bestDeltaMomentum(std::numeric_limits<float>::max());
         try
         {
-            for (StringVector::const_iterator iter = m_settings.m_TrackRelationCollections.begin(), iterEnd = m_settings.m_TrackRelationCollections.end(); iter != iterEnd; ++iter)
+            for (unsigned icol = 0; icol < trkRelCollections.size(); icol++)
             {
-                if(collectionMaps.collectionMap_TrkRel.find(*iter) == collectionMaps.collectionMap_TrkRel.end()) continue;
-                const std::vector<edm4hep::MCRecoTrackerAssociation>& pMCRecoTrackerAssociationCollection = (collectionMaps.collectionMap_TrkRel.find(*iter))->second;
+                const edm4hep::MCRecoTrackerAssociationCollection& pMCRecoTrackerAssociationCollection = *(trkRelCollections[icol]);
                 for(unsigned ith=0 ; ith<pTrack->trackerHits_size(); ith++)
                 {
-                    for(unsigned ic=0; ic < pMCRecoTrackerAssociationCollection.size(); ic++)
+                    const std::pair<RecoIdIndex::const_iterator, RecoIdIndex::const_iterator> range = trkRelIndices[icol]->Find(pTrack->getTrackerHits(ith).id());
+                    for (RecoIdIndex::const_iterator ic = range.first; ic != range.second; ++ic)
                     {
-                        if( pMCRecoTrackerAssociationCollection.at(ic).getRec().id() != pTrack->getTrackerHits(ith).id() ) continue;
-                        const edm4hep::ConstSimTrackerHit pSimHit = pMCRecoTrackerAssociationCollection.at(ic).getSim();
+                        const edm4hep::ConstSimTrackerHit pSimHit = pMCRecoTrackerAssociationCollection.at(*ic).getSim();
                         const edm4hep::ConstMCParticle ipa = pSimHit.getMCParticle();
-                        if( m_id_pMC_map->find(ipa.id()) == m_id_pMC_map->end() ) continue;
+                        std::map<unsigned int, const edm4hep::MCParticle*>::const_iterator it_mc = m_id_pMC_map->find(ipa.id());
+                        if( it_mc == m_id_pMC_map->end() ) continue;
                         const float trueMomentum(pandora::CartesianVector(ipa.getMomentum()[0], ipa.getMomentum()[1], ipa.getMomentum()[2]).GetMagnitude());
                         const float deltaMomentum(std::fabs(recoMomentum - trueMomentum));
                         if (deltaMomentum < bestDeltaMomentum)
                         {
-                            pBestMCParticle =const_cast<edm4hep::MCParticle*>((*m_id_pMC_map)[ipa.id()]);
+                            pBestMCParticle =const_cast<edm4hep::MCParticle*>(it_mc->second);
                             bestDeltaMomentum = deltaMomentum;
                         }
                     }
@@ -0,0 +1,55 @@
+#include "PandoraInputAlg.h"
+
+#include <utility>
+
+DECLARE_COMPONENT( PandoraInputAlg )
+
+
+PandoraInputAlg::PandoraInputAlg(const std::string& name, ISvcLocator* svcLoc)
+  : GaudiAlgorithm(name, svcLoc),
+    _nEvt(0)
+{
+}
+
+StatusCode PandoraInputAlg::initialize()
+{
+  for ( const auto& col : m_readCols ) {
+      if ( !m_collectionReader.DeclareCollection(col, this) ) {
+            error() << "invalid collection type: " << col << endmsg;
+            return StatusCode::FAILURE;
+      }
+  }
+
+  return GaudiAlgorithm::initialize();
+}
+
+StatusCode PandoraInputAlg::execute()
+{
+    CollectionMaps collectionMaps;
+    m_collectionReader.FillCollectionMaps(collectionMaps);
+
+    if (m_CreateCaloRelations && collectionMaps.collectionMap_CaloRel.empty())
+    {
+        for (std::map<std::string, std::vector<edm4hep::MCParticle> >::const_iterator iter = collectionMaps.collectionMap_MC.begin(); iter != collectionMaps.collectionMap_MC.end(); iter++)
+        {
+            std::vector<edm4hep::MCParticle>::const_iterator it = iter->second.begin();
+            while (it != iter->second.end() && it->parents_size() != 0) it++;
+            if (it == iter->second.end()) continue;
+
+            debug() << "create calo hit relations by hand, with mc particle " << it->id() << endmsg;
+            collectionMaps.CreateCaloRelations(*it, m_CaloRelationPrefix);
+            break;
+        }
+    }
+
+    put(new CollectionMapsObject(std::move(collectionMaps)), m_CollectionMapsLocation);
+
+    _nEvt ++ ;
+    return StatusCode::SUCCESS;
+}
+
+StatusCode PandoraInputAlg::finalize()
+{
+  info() << "Finalized. Processed " << _nEvt << " events " << endmsg;
+  return GaudiAlgorithm::finalize();
+}
@@ -0,0 +1,47 @@
+#ifndef PandoraInputAlg_H
+#define PandoraInputAlg_H
+
+#include "GaudiAlg/GaudiAlgorithm.h"
+
+#include "PandoraCommon/CollectionMaps.h"
+#include "PandoraCommon/CollectionReader.h"
+
+#include <string>
+#include <vector>
+
+
+/**
+ *  @brief  Prepares the pandora input of an event once, for all pandora algorithms of the job.
+ *
+ *  The configured collections are read into a CollectionMaps object, which is put in the event store as a plain DataObject
+ *  (CollectionMapsObject), not through a podio data handle, so it is never written to the output file. PandoraPFAlg and
+ *  PandoraMatrixAlg read it instead of their own collections when their UseSharedInput property is set, so running both
+ *  reconstructions on one event prepares the input only once.
+ */
+class PandoraInputAlg : public GaudiAlgorithm
+{
+
+public:
+
+  PandoraInputAlg(const std::string& name, ISvcLocator* svcLoc);
+
+  virtual StatusCode initialize() ;
+
+  virtual StatusCode execute() ;
+
+  virtual StatusCode finalize() ;
+
+protected:
+
+  int _nEvt ;
+
+  Gaudi::Property<std::vector<std::string>> m_readCols{this, "collections", {}, "Places of collections to read"};
+  Gaudi::Property<bool>                     m_CreateCaloRelations{this, "CreateCaloRelationsIfMissing", true, "Associate all calo hits to the first primary mc particle if there is no calo hit truth"};
+  Gaudi::Property<std::string>              m_CaloRelationPrefix{this, "CaloRelationPrefix", "RecoCaloAssociation_", "Prefix of the names of the created calo hit relations"};
+  Gaudi::Property<std::string>              m_CollectionMapsLocation{this, "WriteCollectionMaps", "PandoraInputMaps", "Event store location of the pandora input collection maps"};
+
+  CollectionReader                m_collectionReader;             ///< The reader of the configured collections
+
+};
+
+#endif
@@ -12,8 +12,7 @@
 #include "Objects/Track.h"
 
 #include "Pandora/PdgTable.h"
-#include "PfoCreator.h"
-#include "PandoraPFAlg.h"
+#include "PandoraCommon/PfoCreator.h"
 
 #include <algorithm>
 #include <cmath>
@@ -32,7 +31,7 @@ PfoCreator::~PfoCreator()
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-pandora::StatusCode PfoCreator::CreateParticleFlowObjects(CollectionMaps& collectionMaps, DataHandle<edm4hep::ClusterCollection>& _pClusterCollection, DataHandle<edm4hep::ReconstructedParticleCollection>& _pReconstructedParticleCollection, DataHandle<edm4hep::VertexCollection>& _pStartVertexCollection)
+pandora::StatusCode PfoCreator::CreateParticleFlowObjects(const CollectionMaps& collectionMaps, DataHandle<edm4hep::ClusterCollection>& _pClusterCollection, DataHandle<edm4hep::ReconstructedParticleCollection>& _pReconstructedParticleCollection, DataHandle<edm4hep::VertexCollection>& _pStartVertexCollection)
 {
     m_collectionMaps = &collectionMaps;
     edm4hep::ClusterCollection* pClusterCollection                              = _pClusterCollection.createAndPut();
@@ -46,6 +45,12 @@ pandora::StatusCode PfoCreator::CreateParticleFlowObjects(CollectionMaps& collec
     this->InitialiseSubDetectorNames(subDetectorNames);
 
     std::cout<<"pPandoraPfoList size="<<pPandoraPfoList->size()<<std::endl;
+
+    // Gather the hits of all the clusters and calculate all the cluster shapes before any output object is created
+    this->FillClusterHitArrays(*pPandoraPfoList);
+    this->CalculateClusterShapes();
+
+    unsigned int clusterIndex(0);
     for (pandora::PfoList::const_iterator pIter = pPandoraPfoList->begin(), pIterEnd = pPandoraPfoList->end(); pIter != pIterEnd; ++pIter)
     {
         const pandora::ParticleFlowObject *const pPandoraPfo(*pIter);
@@ -60,21 +65,16 @@ pandora::StatusCode PfoCreator::CreateParticleFlowObjects(CollectionMaps& collec
         for (pandora::ClusterList::const_iterator cIter = clusterList.begin(), cIterEnd = clusterList.end(); cIter != cIterEnd; ++cIter)
         {
             const pandora::Cluster *const pPandoraCluster(*cIter);
-            pandora::CaloHitList pandoraCaloHitList;
-            pPandoraCluster->GetOrderedCaloHitList().FillCaloHitList(pandoraCaloHitList);
-            pandoraCaloHitList.insert(pandoraCaloHitList.end(), pPandoraCluster->GetIsolatedCaloHitList().begin(), pPandoraCluster->GetIsolatedCaloHitList().end());
-
-            pandora::FloatVector hitE, hitX, hitY, hitZ;
             edm4hep::Cluster p_Cluster0 = pClusterCollection->create();
             edm4hep::Cluster* p_Cluster = &p_Cluster0;
-            this->SetClusterSubDetectorEnergies(subDetectorNames, p_Cluster, pandoraCaloHitList, hitE, hitX, hitY, hitZ);
+            this->SetClusterSubDetectorEnergies(subDetectorNames, clusterIndex, p_Cluster);
 
             float clusterCorrectEnergy(0.f);
             this->SetClusterEnergyAndError(pPandoraPfo, pPandoraCluster, p_Cluster, clusterCorrectEnergy);
 
             pandora::CartesianVector clusterPosition(0.f, 0.f, 0.f);
-            const unsigned int nHitsInCluster(pandoraCaloHitList.size());
-            this->SetClusterPositionAndError(nHitsInCluster, hitE, hitX, hitY, hitZ, p_Cluster, clusterPosition);
+            this->SetClusterPositionAndError(clusterIndex, p_Cluster, clusterPosition);
+            ++clusterIndex;
 
             if (!hasTrack)
             {
@@ -132,23 +132,105 @@ void PfoCreator::InitialiseSubDetectorNames(pandora::StringVector &subDetectorNa
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-void PfoCreator::SetClusterSubDetectorEnergies(const pandora::StringVector &subDetectorNames, edm4hep::Cluster *const p_Cluster,
-    const pandora::CaloHitList &pandoraCaloHitList, pandora::FloatVector &hitE, pandora::FloatVector &hitX, pandora::FloatVector &hitY,
-    pandora::FloatVector &hitZ) const
+void PfoCreator::FillClusterHitArrays(const pandora::PfoList &pfoList)
+{
+    // Size the arrays once for the whole event
+    unsigned int nClusters(0), nHits(0);
+    for (pandora::PfoList::const_iterator pIter = pfoList.begin(), pIterEnd = pfoList.end(); pIter != pIterEnd; ++pIter)
+    {
+        const pandora::ClusterList &clusterList((*pIter)->GetClusterList());
+        nClusters += clusterList.size();
+
+        for (pandora::ClusterList::const_iterator cIter = clusterList.begin(), cIterEnd = clusterList.end(); cIter != cIterEnd; ++cIter)
+            nHits += (*cIter)->GetNCaloHits() + (*cIter)->GetNIsolatedCaloHits();
+    }
+
+    m_hitAddresses.clear();
+    m_hitE.clear();
+    m_hitX.clear();
+    m_hitY.clear();
+    m_hitZ.clear();
+    m_clusterHitBegin.clear();
+
+    m_hitAddresses.reserve(nHits);
+    m_hitE.reserve(nHits);
+    m_hitX.reserve(nHits);
+    m_hitY.reserve(nHits);
+    m_hitZ.reserve(nHits);
+    m_clusterHitBegin.reserve(nClusters + 1);
+    m_clusterHitBegin.push_back(0);
+
+    pandora::CaloHitList pandoraCaloHitList;
+
+    for (pandora::PfoList::const_iterator pIter = pfoList.begin(), pIterEnd = pfoList.end(); pIter != pIterEnd; ++pIter)
+    {
+        const pandora::ClusterList &clusterList((*pIter)->GetClusterList());
+
+        for (pandora::ClusterList::const_iterator cIter = clusterList.begin(), cIterEnd = clusterList.end(); cIter != cIterEnd; ++cIter)
+        {
+            const pandora::Cluster *const pPandoraCluster(*cIter);
+            pandoraCaloHitList.clear();
+            pPandoraCluster->GetOrderedCaloHitList().FillCaloHitList(pandoraCaloHitList);
+            pandoraCaloHitList.insert(pandoraCaloHitList.end(), pPandoraCluster->GetIsolatedCaloHitList().begin(), pPandoraCluster->GetIsolatedCaloHitList().end());
+
+            for (pandora::CaloHitList::const_iterator hIter = pandoraCaloHitList.begin(), hIterEnd = pandoraCaloHitList.end(); hIter != hIterEnd; ++hIter)
+            {
+                const edm4hep::CalorimeterHit *const pCalorimeterHit = (const edm4hep::CalorimeterHit*)((*hIter)->GetParentAddress());
+                m_hitAddresses.push_back(pCalorimeterHit);
+                m_hitE.push_back(pCalorimeterHit->getEnergy());
+                m_hitX.push_back(pCalorimeterHit->getPosition()[0]);
+                m_hitY.push_back(pCalorimeterHit->getPosition()[1]);
+                m_hitZ.push_back(pCalorimeterHit->getPosition()[2]);
+            }
+
+            m_clusterHitBegin.push_back(m_hitAddresses.size());
+        }
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void PfoCreator::CalculateClusterShapes()
+{
+    const unsigned int nClusters(m_clusterHitBegin.size() - 1);
+    m_clusterShapes.resize(nClusters);
+
+    for (unsigned int clusterIndex = 0; clusterIndex < nClusters; ++clusterIndex)
+    {
+        const unsigned int begin(m_clusterHitBegin[clusterIndex]);
+        const unsigned int nHitsInCluster(m_clusterHitBegin[clusterIndex + 1] - begin);
+        ClusterShape &clusterShape(m_clusterShapes[clusterIndex]);
+        clusterShape.m_isValid = false;
+
+        ClusterShapes clusterShapes(nHitsInCluster, m_hitE.data() + begin, m_hitX.data() + begin, m_hitY.data() + begin, m_hitZ.data() + begin);//this need GSL/1.14 
+
+        try
+        {
+            clusterShape.m_phi = std::atan2(clusterShapes.getEigenVecInertia()[1], clusterShapes.getEigenVecInertia()[0]);
+            clusterShape.m_iTheta = std::acos(clusterShapes.getEigenVecInertia()[2]);
+
+            for (unsigned int i = 0; i < 3; ++i)
+                clusterShape.m_position[i] = clusterShapes.getCentreOfGravity()[i];
+
+            clusterShape.m_isValid = true;
+        }
+        catch (...)
+        {
+            std::cout<<"WARNING PfoCreator::CalculateClusterShapes: unidentified exception caught." << std::endl;
+        }
+    }
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------
+
+void PfoCreator::SetClusterSubDetectorEnergies(const pandora::StringVector &subDetectorNames, const unsigned int clusterIndex,
+    edm4hep::Cluster *const p_Cluster) const
 {
-    for (pandora::CaloHitList::const_iterator hIter = pandoraCaloHitList.begin(), hIterEnd = pandoraCaloHitList.end(); hIter != hIterEnd; ++hIter)
+    for (unsigned int iHit = m_clusterHitBegin[clusterIndex], iHitEnd = m_clusterHitBegin[clusterIndex + 1]; iHit < iHitEnd; ++iHit)
     {
-        const pandora::CaloHit *const pPandoraCaloHit(*hIter);
-        edm4hep::CalorimeterHit *const pCalorimeterHit0 = (edm4hep::CalorimeterHit*)(pPandoraCaloHit->GetParentAddress());
-        const edm4hep::CalorimeterHit pCalorimeterHit = *pCalorimeterHit0;
+        const edm4hep::CalorimeterHit pCalorimeterHit = *(m_hitAddresses[iHit]);
         
         p_Cluster->addToHits(pCalorimeterHit);
-
-        const float caloHitEnergy(pCalorimeterHit.getEnergy());
-        hitE.push_back(caloHitEnergy);
-        hitX.push_back(pCalorimeterHit.getPosition()[0]);
-        hitY.push_back(pCalorimeterHit.getPosition()[1]);
-        hitZ.push_back(pCalorimeterHit.getPosition()[2]);
         /*Can be added later 
         std::vector<float> &subDetectorEnergies = p_Cluster->subdetectorEnergies();
         subDetectorEnergies.resize(subDetectorNames.size());
@@ -188,24 +270,18 @@ void PfoCreator::SetClusterEnergyAndError(const pandora::ParticleFlowObject *con
 
 //------------------------------------------------------------------------------------------------------------------------------------------
 
-void PfoCreator::SetClusterPositionAndError(const unsigned int nHitsInCluster, pandora::FloatVector &hitE, pandora::FloatVector &hitX, 
-    pandora::FloatVector &hitY, pandora::FloatVector &hitZ, edm4hep::Cluster *const p_Cluster, pandora::CartesianVector &clusterPositionVec) const
+void PfoCreator::SetClusterPositionAndError(const unsigned int clusterIndex, edm4hep::Cluster *const p_Cluster,
+    pandora::CartesianVector &clusterPositionVec) const
 {
-    ClusterShapes *const pClusterShapes(new ClusterShapes(nHitsInCluster, hitE.data(), hitX.data(), hitY.data(), hitZ.data()));//this need GSL/1.14 
+    const ClusterShape &clusterShape(m_clusterShapes[clusterIndex]);
 
-    try
-    {
-        p_Cluster->setPhi(std::atan2(pClusterShapes->getEigenVecInertia()[1], pClusterShapes->getEigenVecInertia()[0]));
-        p_Cluster->setITheta(std::acos(pClusterShapes->getEigenVecInertia()[2]));
-        p_Cluster->setPosition(pClusterShapes->getCentreOfGravity());
-        clusterPositionVec.SetValues(pClusterShapes->getCentreOfGravity()[0], pClusterShapes->getCentreOfGravity()[1], pClusterShapes->getCentreOfGravity()[2]);
-    }
-    catch (...)
-    {
-        std::cout<<"WARNING PfoCreator::SetClusterPositionAndError: unidentified exception caught." << std::endl;
-    }
+    if (!clusterShape.m_isValid)
+        return;
 
-    delete pClusterShapes;
+    p_Cluster->setPhi(clusterShape.m_phi);
+    p_Cluster->setITheta(clusterShape.m_iTheta);
+    p_Cluster->setPosition(clusterShape.m_position);
+    clusterPositionVec.SetValues(clusterShape.m_position[0], clusterShape.m_position[1], clusterShape.m_position[2]);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------------------
@@ -32,6 +32,9 @@
 //#include "Tools/KiTrackMarlinCEDTools.h"
 #include "Tools/FTDHelixFitter.h"
 
+// Root, for calculating the chi2 probability of the helix fit
+#include "Math/ProbFunc.h"
+
 using namespace MarlinTrk ;
 
 // Used to fedine the quality of the track output collection
@@ -60,6 +63,12 @@ StatusCode ForwardTrackingAlg::initialize(){
   _nRun = 0 ;
   _nEvt = 0 ;
 
+  _nTrackCandidates = 0;
+  _nTrackCandidatesPlus = 0;
+  _nRejectedHitsMin = 0;
+  _nRejectedHelix = 0;
+  _nRejectedKalman = 0;
+
   _useCED = false; // Setting this to on will initialise CED in the processor and tracks or segments (from the CA)
   // can be printed. As this is mainly used for debugging it is not a steerable parameter.
   //if( _useCED )MarlinCED::init(this) ;    //CED
@@ -162,6 +171,8 @@ StatusCode ForwardTrackingAlg::initialize(){
   // Use a sensible chi2prob cut. (chi squared probability, like any probability must range from 0 to 1)
   assert( _chi2ProbCut >= 0. );
   assert( _chi2ProbCut <= 1. );
+  assert( _helixFitChi2ProbCut >= 0. );
+  assert( _helixFitChi2ProbCut <= 1. );
      
   // Make sure, every used criterion exists and has at least one min and max set
   for( unsigned i=0; i<_criteriaNames.size(); i++ ){
@@ -437,9 +448,14 @@ StatusCode ForwardTrackingAlg::execute(){
     /**********************************************************************************************/
     /*                Add the overlapping hits                                                    */
     /**********************************************************************************************/
-    debug() << "\t\t---Add hits from overlapping petals + fit + helix and Kalman cuts---" << endmsg;
+    debug() << "\t\t---Add hits from overlapping petals + helix pre-filter---" << endmsg;
     
-    std::vector <ITrack*> trackCandidates;
+    // The candidates are processed in two stages: first every version of every raw track goes through the
+    // cheap helix fit (circle in xy + line in sz) and only the survivors are handed over to the much more
+    // expensive Kalman fit in the second stage. The survivors are stored per raw track, so that the best
+    // version of a track can still be chosen afterwards.
+    std::vector< std::vector< FTDTrack* > > preFilteredTrackCands;
+    preFilteredTrackCands.reserve( rawTracks.size() );
     
     // for all raw tracks we got from the automaton
     for( unsigned i=0; i < rawTracks.size(); i++){
@@ -453,9 +469,9 @@ StatusCode ForwardTrackingAlg::execute(){
       debug() << "For raw track number " << i << " there are " << rawTracksPlus.size() << " versions" << endmsg;
                   
       /**********************************************************************************************/
-      /*                Make track candidates, fit them and throw away bad ones                     */
+      /*                Make track candidates, helix fit them and throw away bad ones               */
       /**********************************************************************************************/
-      std::vector< ITrack* > overlappingTrackCands;
+      std::vector< FTDTrack* > helixTrackCands;
         
       for( unsigned j=0; j < rawTracksPlus.size(); j++ ){
 	_nTrackCandidatesPlus++;
@@ -464,6 +480,7 @@ StatusCode ForwardTrackingAlg::execute(){
         
 	if( rawTrackPlus.size() < unsigned( _hitsPerTrackMin ) ){
 	  debug() << "Trackversion discarded, too few hits: only " << rawTrackPlus.size() << " < " << _hitsPerTrackMin << "(hitsPerTrackMin)" << endmsg;
+	  _nRejectedHitsMin++;
 	  continue;
 	}
             
@@ -485,6 +502,8 @@ StatusCode ForwardTrackingAlg::execute(){
 	/*-----------------------------------------------*/
 	/*                Helix Fit                      */
 	/*-----------------------------------------------*/
+	// One fit per candidate: the fast helix fit iterates a different number of times per track and bails out
+	// early on degenerate circles, and a candidate only has a few hits, so there is nothing to batch across tracks.
 	debug() << "Fitting with Helix Fit" << endmsg;
 	try{
 	  FTDHelixFitter helixFitter( trackCand->getLcioTrack() );
@@ -493,17 +512,50 @@ StatusCode ForwardTrackingAlg::execute(){
           
 	  if( chi2OverNdf > _helixFitMax ){
 	    debug() << "Discarding track because of bad helix fit: chi2/ndf = " << chi2OverNdf << endmsg;
+	    _nRejectedHelix++;
 	    delete trackCand;
 	    continue;
 	  }
-	  else debug() << "Keeping track because of good helix fit: chi2/ndf = " << chi2OverNdf << endmsg;
+	  
+	  if( _helixFitChi2ProbCut > 0. ){
+	    double chi2Prob = ROOT::Math::chisquared_cdf_c( helixFitter.getChi2(), helixFitter.getNdf() );
+	    if( chi2Prob < _helixFitChi2ProbCut ){
+	      debug() << "Discarding track because of bad helix fit: chi2prob = " << chi2Prob << " < " << _helixFitChi2ProbCut << " (HelixFitChi2ProbCut)" << endmsg;
+	      _nRejectedHelix++;
+	      delete trackCand;
+	      continue;
+	    }
+	  }
+	  
+	  debug() << "Keeping track because of good helix fit: chi2/ndf = " << chi2OverNdf << endmsg;
 	}
 	catch( FTDHelixFitterException& e ){
 	  debug() << "Track rejected, because fit failed: " <<  e.what() << endmsg;
+	  _nRejectedHelix++;
 	  delete trackCand;
 	  continue;
 	}
-            
+	
+	helixTrackCands.push_back( trackCand );
+      }
+      
+      preFilteredTrackCands.push_back( helixTrackCands );
+    }
+    
+    /**********************************************************************************************/
+    /*                Kalman fit the survivors of the helix pre-filter                            */
+    /**********************************************************************************************/
+    debug() << "\t\t---Kalman fit + cuts---" << endmsg;
+    
+    std::vector <ITrack*> trackCandidates;
+    
+    for( unsigned i=0; i < preFilteredTrackCands.size(); i++ ){
+      
+      std::vector< ITrack* > overlappingTrackCands;
+      
+      for( unsigned j=0; j < preFilteredTrackCands[i].size(); j++ ){
+	FTDTrack* trackCand = preFilteredTrackCands[i][j];
+	
 	/*-----------------------------------------------*/
 	/*                Kalman Fit                      */
 	/*-----------------------------------------------*/
@@ -522,6 +574,7 @@ StatusCode ForwardTrackingAlg::execute(){
 	  }
 	  else{
 	    debug() << "Track rejected (chi2prob " << trackCand->getChi2Prob() << " < " << _chi2ProbCut << endmsg;
+	    _nRejectedKalman++;
 	    delete trackCand;
             
 	    continue;
@@ -529,6 +582,7 @@ StatusCode ForwardTrackingAlg::execute(){
 	}
 	catch( FitterException& e ){
 	  debug() << "Track rejected, because fit failed: " <<  e.what() << endmsg;
+	  _nRejectedKalman++;
 	  delete trackCand;
 	  continue;
 	}
@@ -697,6 +751,10 @@ StatusCode ForwardTrackingAlg::finalize(){
 	  << " track Candidates with hits from overlapping hits" << endmsg
 	  << "The ratio is " << float( _nTrackCandidatesPlus )/_nTrackCandidates << endmsg;
 
+  info() << "Track candidate statistics: " << _nTrackCandidatesPlus << " candidates, rejected by "
+	 << "HitsPerTrackMin: " << _nRejectedHitsMin << ", helix fit: " << _nRejectedHelix
+	 << ", Kalman fit: " << _nRejectedKalman << endmsg;
+
   return GaudiAlgorithm::finalize();
 }
 
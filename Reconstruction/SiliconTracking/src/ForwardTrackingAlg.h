@@ -61,6 +61,10 @@ typedef std::vector< IHit* > RawTrack;
  * @param HelixFitMax the maximum chi2/Ndf that is allowed as result of a helix fit
  * (default value 500 )
  * 
+ * @param HelixFitChi2ProbCut Tracks with a chi2 probability of the helix fit below this are sorted out before
+ * the Kalman fit. 0 switches the cut off<br>
+ * (default value 0 )
+ * 
  * @param OverlappingHitsDistMax The maximum distance of hits from overlapping petals belonging to one track<br>
  * (default value 3.5 )
  * 
@@ -160,8 +164,9 @@ class ForwardTrackingAlg : public GaudiAlgorithm {
    *    -# Next we iterate over every trackcandidate we got.
    *    -# The hits from overlapping petals are added and every possible combination of the trackcandidate and the hits
    * we could add is created. The best version is then taken (if this is switched on in the steering parameters).
-   *    -# Cuts: First we do a helix fit. If the result (chi2 / Ndf ) is too bad the track is dropped. Then we do a 
-   * Kalman Fit. Also if the results here (chi squared probability) are bad the track is not saved.
+   *    -# Cuts: First all versions of all track candidates get a helix fit. If the result (chi2 / Ndf or the chi2
+   * probability) is too bad the track is dropped. Only the survivors get a Kalman Fit. Also if the results here
+   * (chi squared probability) are bad the track is not saved.
    *    -# Find the best subset: the tracks we now gathered may not be all compatible with each other (i.e. share hits).
    * This situation is resolved with a best subset finder like the Hopfield Neural Network.
    *    -# Now the tracks are all compatible and suited our different criteria. It is time to save them. At the end they
@@ -240,6 +245,7 @@ class ForwardTrackingAlg : public GaudiAlgorithm {
 
   Gaudi::Property<double> _chi2ProbCut{this, "Chi2ProbCut", 0.005};
   Gaudi::Property<double> _helixFitMax{this, "HelixFitMax", 500};
+  Gaudi::Property<double> _helixFitChi2ProbCut{this, "HelixFitChi2ProbCut", 0.};
   Gaudi::Property<double> _overlappingHitsDistMax{this, "OverlappingHitsDistMax", 3.5};
   Gaudi::Property<int>    _hitsPerTrackMin{this, "HitsPerTrackMin", 4};
   Gaudi::Property<std::string> _bestSubsetFinder{this, "BestSubsetFinder", "SubsetHopfieldNN"};
@@ -283,6 +289,11 @@ class ForwardTrackingAlg : public GaudiAlgorithm {
   
   unsigned _nTrackCandidates;
   unsigned _nTrackCandidatesPlus;
+  
+  /** Number of track candidates rejected by the different stages: too few hits, helix fit and Kalman fit */
+  unsigned _nRejectedHitsMin;
+  unsigned _nRejectedHelix;
+  unsigned _nRejectedKalman;
      
   MarlinTrk::IMarlinTrkSystem* _trkSystem;
   
@@ -20,6 +20,7 @@
 #include "CLHEP/Matrix/SymMatrix.h"
 #include "CLHEP/Matrix/Matrix.h"
 
+#include <algorithm>
 #include <cmath>
 #include <sstream>
 
@@ -97,6 +98,7 @@ StatusCode SpacePointBuilderAlg::execute(){
     _nOutOfBoundary = 0;
     _nStripsTooParallel = 0;
     _nPlanesNotParallel = 0;
+    _nStripsNotCrossing = 0;
     
     //edm4hep::TrackerHitCollection* spCol = new edm4hep::TrackerHitCollection();    // output spacepoint collection
     //edm4hep::MCRecoTrackerAssociationCollection* relCol = new edm4hep::MCRecoTrackerAssociationCollection();    // output relation collection
@@ -117,6 +119,14 @@ StatusCode SpacePointBuilderAlg::execute(){
       map_cellID0_hits[ trkHit.getCellID() ].push_back( trkHit );
     }
     
+    //index the sim hits of the association collection by the id of their reco hit, so that they don't have to be
+    //searched for every combination of strip hits
+    std::map<unsigned, std::vector<edm4hep::ConstSimTrackerHit> > map_hitID_simHits;
+    for(auto hitAss : *hitAssCol){
+      map_hitID_simHits[ hitAss.getRec().id() ].push_back( hitAss.getSim() );
+    }
+    const std::vector<edm4hep::ConstSimTrackerHit> noSimHits;
+    
     UTIL::BitField64  cellID( UTIL::ILDCellID0::encoder_string );
     // now loop over all CellID0s
     for( it= map_cellID0_hits.begin(); it!= map_cellID0_hits.end(); it++ ){
@@ -125,6 +135,32 @@ StatusCode SpacePointBuilderAlg::execute(){
       unsigned long long cellID0 = it->first;
       //get the CellID0s at the back of this sensor
       std::vector<int> cellID0sBack = getCellID0sAtBack( cellID0 );
+      if( cellID0sBack.empty() ) continue;
+      
+      cellID.setValue( cellID0 );
+      int subdet = cellID[ UTIL::ILDCellID0::subdet ] ;
+      double strip_length_mm = 0;
+      if (subdet == UTIL::ILDDetID::SIT) {
+	strip_length_mm = _GEAR->getSITParameters().getDoubleVal("strip_length_mm");
+      }
+      else if (subdet == UTIL::ILDDetID::SET) {
+	strip_length_mm = _GEAR->getSETParameters().getDoubleVal("strip_length_mm");
+      }
+      else if (subdet == UTIL::ILDDetID::FTD) {
+	strip_length_mm = _GEAR->getFTDParameters().getDoubleVal("strip_length_mm");
+      }
+      else {
+	std::stringstream errorMsg;
+	errorMsg << "SpacePointBuilderAlg::processEvent: unsupported detector ID = " << subdet << ": file " << __FILE__ << " line " << __LINE__ ;
+	throw GaudiException( errorMsg.str(), "CellID not matched", StatusCode::FAILURE );  
+      }
+      
+      // add tolerence 
+      strip_length_mm = strip_length_mm * (1.0 + _striplength_tolerance);
+      
+      // the end points of the front strips, for all the sensors at the back
+      std::vector< double > stripsFront;
+      getStripEnds( hitsFront, strip_length_mm, stripsFront );
       
       for( unsigned i=0; i< cellID0sBack.size(); i++ ){ 
         int cellID0Back = cellID0sBack[i];
@@ -135,106 +171,95 @@ StatusCode SpacePointBuilderAlg::execute(){
 		<< "--> " << hitsFront.size() * hitsBack.size() << " possible combinations" << endmsg;
         
         possibleSpacePoints += hitsFront.size() * hitsBack.size();
-	// Now iterate over all combinations and store those that make sense
+        if( hitsBack.empty() ) continue;
+        
+        // the sensors have to be parallel, their strips not: this holds for all the combinations or for none
+        if( !checkSensorPair( hitsFront, hitsBack ) ) continue;
+        
+        std::vector< double > stripsBack;
+        getStripEnds( hitsBack, strip_length_mm, stripsBack );
+        
+        // only the combinations, where the strips can cross at all, are tried
+        std::vector< std::vector<unsigned> > compatibleBackHits = getCompatibleStripPairs( hitsFront, hitsBack, stripsBack );
         for( unsigned ifront=0; ifront<hitsFront.size(); ifront++ ){
-	  edm4hep::TrackerHit& hitFront = hitsFront[ifront];
-	  for( unsigned j=0; j<hitsBack.size(); j++ ){
-	    edm4hep::TrackerHit& hitBack = hitsBack[j];
-
-	    std::vector<edm4hep::ConstSimTrackerHit> simHitsFront;
-	    std::vector<edm4hep::ConstSimTrackerHit> simHitsBack;
-	    for(auto hitAss : *hitAssCol){
-	      if(hitAss.getRec().id()==hitFront.id()) simHitsFront.push_back(hitAss.getSim());
-	      if(hitAss.getRec().id()==hitBack.id()) simHitsBack.push_back(hitAss.getSim());
-	    }
-	    debug() << "attempt to create space point from:" << endmsg;
-            debug() << "   front hit: " << hitFront.id() << " no. of simhit = " << simHitsFront.size() ;
-            if( simHitsFront.size()!=0 ) { 
-	      edm4hep::ConstSimTrackerHit& simhit = simHitsFront[0];
-              debug() << "   first simhit = " << simhit.id() << " mcp = " << simhit.getMCParticle().id() << " (" << simhit.getPosition() << ") " ; 
-            }
-            debug() << endmsg;
-            debug() << "  rear hit: " << hitBack.id() << " no. of simhit = " << simHitsBack.size() ;
-            if( simHitsBack.size()!=0 ) { 
-	      edm4hep::ConstSimTrackerHit& simhit = simHitsBack[0];
-              debug() << "   first simhit = " << simhit.id() << " mcp = "<< simhit.getMCParticle().id() << " (" << simhit.getPosition() << ") " ; 
-            }
-	    debug() << endmsg;
-            
-            bool ghost_hit = true;
-	    if (simHitsFront.size()==1 && simHitsBack.size() == 1) {
-              debug() << "SpacePoint creation from two good hits:" << endmsg;
-	      ghost_hit = simHitsFront[0].getMCParticle().id() != simHitsBack[0].getMCParticle().id();
-	    }
-	    if ( ghost_hit == true ) {
-              debug() << "SpacePoint Ghosthit!" << endmsg;
-            }
-            
-            cellID.setValue( cellID0 );
-	    int subdet = cellID[ UTIL::ILDCellID0::subdet ] ;
-            double strip_length_mm = 0;
-            if (subdet == UTIL::ILDDetID::SIT) {
-	      strip_length_mm = _GEAR->getSITParameters().getDoubleVal("strip_length_mm");
-            }
-	    else if (subdet == UTIL::ILDDetID::SET) {
-              strip_length_mm = _GEAR->getSETParameters().getDoubleVal("strip_length_mm");
-            }
-	    else if (subdet == UTIL::ILDDetID::FTD) {
-              strip_length_mm = _GEAR->getFTDParameters().getDoubleVal("strip_length_mm");
-            }
-	    else {
-	      std::stringstream errorMsg;
-              errorMsg << "SpacePointBuilderAlg::processEvent: unsupported detector ID = " << subdet << ": file " << __FILE__ << " line " << __LINE__ ;
-              throw GaudiException( errorMsg.str(), "CellID not matched", StatusCode::FAILURE );  
-            }
-
-            // add tolerence 
-            strip_length_mm = strip_length_mm * (1.0 + _striplength_tolerance);
-	    try{
-	      edm4hep::TrackerHit spacePoint = createSpacePoint( &hitFront, &hitBack, strip_length_mm);
-
-	      //UTIL::CellIDEncoder<TrackerHitImpl> cellid_encoder( UTIL::ILDCellID0::encoder_string , spCol );
-              //cellid_encoder.setValue( cellID0 ); //give the new hit, the CellID0 of the front hit
-              //cellid_encoder.setCellID( spacePoint ) ;
-	      spacePoint.setCellID(cellID0);
-
-              // store the hits it's composed of:
-              spacePoint.addToRawHits( hitFront.getObjectID() );
-              spacePoint.addToRawHits( hitBack.getObjectID() );
-
-              spacePoint.setType( UTIL::set_bit( spacePoint.getType() ,  UTIL::ILDTrkHitTypeBit::COMPOSITE_SPACEPOINT ) ) ;
-
-              spCol->push_back( spacePoint ); 
-	      //debug() << "push_back space point's id=" << spCol->at(spCol->size()-1).id() << endmsg;
-              createdSpacePoints++;
-              
-              ///////////////////////////////
-              // make the relations
-              if( simHitsFront.size() == 1 ){
-		edm4hep::ConstSimTrackerHit& simHit = simHitsFront[0];
-		edm4hep::MCRecoTrackerAssociation spAss = relCol->create();
-		spAss.setRec(spacePoint);
-		spAss.setSim(simHit);
-		spAss.setWeight( 0.5 );
-              }
-              if( simHitsBack.size() == 1 ){
-		edm4hep::ConstSimTrackerHit& simHit = simHitsBack[0];
-		edm4hep::MCRecoTrackerAssociation spAss = relCol->create();
-                spAss.setRec(spacePoint);
-		spAss.setSim(simHit);
-                spAss.setWeight( 0.5 );
-	      }
-	    }
-	    catch(std::runtime_error& e){
-	      if ( ghost_hit == true ) {
-                debug() << "Ghosthit correctly rejected" << endmsg;
-              }
-	      else {
-                debug() << "True hit rejected!" << endmsg;
-              }
-            }
-          }
-        }
+	  _nStripsNotCrossing += hitsBack.size() - compatibleBackHits[ifront].size();
+	}
+        
+        // calculate the space points of all these combinations at once
+        std::vector< SpacePointCandidate > spacePointCands = createSpacePoints( hitsFront, hitsBack, stripsFront, stripsBack, compatibleBackHits );
+        
+	// Now store the space points that make sense
+        for( unsigned k=0; k<spacePointCands.size(); k++ ){
+	  const SpacePointCandidate& spacePointCand = spacePointCands[k];
+	  edm4hep::TrackerHit& hitFront = hitsFront[ spacePointCand.front ];
+	  edm4hep::TrackerHit& hitBack = hitsBack[ spacePointCand.back ];
+	  
+	  std::map<unsigned, std::vector<edm4hep::ConstSimTrackerHit> >::const_iterator itSimFront = map_hitID_simHits.find( hitFront.id() );
+	  const std::vector<edm4hep::ConstSimTrackerHit>& simHitsFront = ( itSimFront != map_hitID_simHits.end() ) ? itSimFront->second : noSimHits;
+	  
+	  std::map<unsigned, std::vector<edm4hep::ConstSimTrackerHit> >::const_iterator itSimBack = map_hitID_simHits.find( hitBack.id() );
+	  const std::vector<edm4hep::ConstSimTrackerHit>& simHitsBack = ( itSimBack != map_hitID_simHits.end() ) ? itSimBack->second : noSimHits;
+	  
+	  debug() << "space point created from:" << endmsg;
+	  debug() << "   front hit: " << hitFront.id() << " no. of simhit = " << simHitsFront.size() ;
+	  if( simHitsFront.size()!=0 ) { 
+	    const edm4hep::ConstSimTrackerHit& simhit = simHitsFront[0];
+	    debug() << "   first simhit = " << simhit.id() << " mcp = " << simhit.getMCParticle().id() << " (" << simhit.getPosition() << ") " ; 
+	  }
+	  debug() << endmsg;
+	  debug() << "  rear hit: " << hitBack.id() << " no. of simhit = " << simHitsBack.size() ;
+	  if( simHitsBack.size()!=0 ) { 
+	    const edm4hep::ConstSimTrackerHit& simhit = simHitsBack[0];
+	    debug() << "   first simhit = " << simhit.id() << " mcp = "<< simhit.getMCParticle().id() << " (" << simhit.getPosition() << ") " ; 
+	  }
+	  debug() << endmsg;
+	  
+	  bool ghost_hit = true;
+	  if (simHitsFront.size()==1 && simHitsBack.size() == 1) {
+	    debug() << "SpacePoint creation from two good hits:" << endmsg;
+	    ghost_hit = simHitsFront[0].getMCParticle().id() != simHitsBack[0].getMCParticle().id();
+	  }
+	  if ( ghost_hit == true ) {
+	    debug() << "SpacePoint Ghosthit!" << endmsg;
+	  }
+	  
+	  //Create the new TrackerHit
+	  edm4hep::TrackerHit spacePoint;
+	  spacePoint.setPosition( spacePointCand.position );
+	  spacePoint.setCovMatrix( spacePointCand.cov );
+	  
+	  //UTIL::CellIDEncoder<TrackerHitImpl> cellid_encoder( UTIL::ILDCellID0::encoder_string , spCol );
+	  //cellid_encoder.setValue( cellID0 ); //give the new hit, the CellID0 of the front hit
+	  //cellid_encoder.setCellID( spacePoint ) ;
+	  spacePoint.setCellID(cellID0);
+	  
+	  // store the hits it's composed of:
+	  spacePoint.addToRawHits( hitFront.getObjectID() );
+	  spacePoint.addToRawHits( hitBack.getObjectID() );
+	  
+	  spacePoint.setType( UTIL::set_bit( spacePoint.getType() ,  UTIL::ILDTrkHitTypeBit::COMPOSITE_SPACEPOINT ) ) ;
+	  
+	  spCol->push_back( spacePoint ); 
+	  //debug() << "push_back space point's id=" << spCol->at(spCol->size()-1).id() << endmsg;
+	  createdSpacePoints++;
+	  
+	  ///////////////////////////////
+	  // make the relations
+	  if( simHitsFront.size() == 1 ){
+	    const edm4hep::ConstSimTrackerHit& simHit = simHitsFront[0];
+	    edm4hep::MCRecoTrackerAssociation spAss = relCol->create();
+	    spAss.setRec(spacePoint);
+	    spAss.setSim(simHit);
+	    spAss.setWeight( 0.5 );
+	  }
+	  if( simHitsBack.size() == 1 ){
+	    const edm4hep::ConstSimTrackerHit& simHit = simHitsBack[0];
+	    edm4hep::MCRecoTrackerAssociation spAss = relCol->create();
+	    spAss.setRec(spacePoint);
+	    spAss.setSim(simHit);
+	    spAss.setWeight( 0.5 );
+	  }
+	}
       }
     }
     
@@ -248,7 +273,8 @@ StatusCode SpacePointBuilderAlg::execute(){
 	    << possibleSpacePoints << " possible space points" << endmsg;
     debug() << "  " << _nStripsTooParallel << " space points couldn't be created, because the strips were too parallel\n"
 	    << "  " << _nPlanesNotParallel << " space points couldn't be created, because the planes of the measurement surfaces where not parallel enough\n"
-	    << "  " << _nOutOfBoundary     << " space points couldn't be created, because the result was outside the sensor boundary\n" << endmsg; 
+	    << "  " << _nOutOfBoundary     << " space points couldn't be created, because the result was outside the sensor boundary\n"
+	    << "  " << _nStripsNotCrossing << " combinations weren't tried, because the strips can't cross each other\n" << endmsg; 
   }
 
   _nEvt ++ ;
@@ -260,48 +286,29 @@ StatusCode SpacePointBuilderAlg::finalize(){
   return GaudiAlgorithm::finalize();
 }
 
-edm4hep::TrackerHit SpacePointBuilderAlg::createSpacePoint( edm4hep::TrackerHit* a , edm4hep::TrackerHit* b, double stripLength ){
+bool SpacePointBuilderAlg::checkSensorPair( std::vector<edm4hep::TrackerHit>& hitsFront, std::vector<edm4hep::TrackerHit>& hitsBack ){
   
-  const edm4hep::Vector3d& pa = a->getPosition();
-  double xa = pa[0];
-  double ya = pa[1];
-  double za = pa[2];
-  CLHEP::Hep3Vector PA( xa,ya,za );
-  //double du_a = a->getdU();  
-  float du_a = a->getCovMatrix(2);
+  const unsigned nCombinations = hitsFront.size() * hitsBack.size();
   
-  gear::MeasurementSurface const* msA = _GEAR->getMeasurementSurfaceStore().GetMeasurementSurface( a->getCellID() );
+  gear::MeasurementSurface const* msA = _GEAR->getMeasurementSurfaceStore().GetMeasurementSurface( hitsFront[0].getCellID() );
   gear::CartesianCoordinateSystem* ccsA = dynamic_cast< gear::CartesianCoordinateSystem* >( msA->getCoordinateSystem() );
- 
-  CLHEP::Hep3Vector WA = ccsA->getLocalZAxis(); // the vector W of the local coordinate system the measurement surface has
-  CLHEP::Hep3Vector VA = ccsA->getLocalYAxis(); // the vector V of the local coordinate system the measurement surface has
-  CLHEP::Hep3Vector UA = ccsA->getLocalXAxis(); // the vector U of the local coordinate system the measurement surface has
-  
-  const edm4hep::Vector3d& pb = b->getPosition();
-  double xb = pb[0];
-  double yb = pb[1];
-  double zb = pb[2];
-  CLHEP::Hep3Vector PB( xb,yb,zb );
-  //double du_b = b->getdU();  
-  float du_b = b->getCovMatrix(2);
-
-  gear::MeasurementSurface const* msB = _GEAR->getMeasurementSurfaceStore().GetMeasurementSurface( b->getCellID() );
+  gear::MeasurementSurface const* msB = _GEAR->getMeasurementSurfaceStore().GetMeasurementSurface( hitsBack[0].getCellID() );
   gear::CartesianCoordinateSystem* ccsB = dynamic_cast< gear::CartesianCoordinateSystem* >( msB->getCoordinateSystem() );
-  CLHEP::Hep3Vector WB = ccsB->getLocalZAxis(); // the vector W of the local coordinate system the measurement surface has
-  CLHEP::Hep3Vector VB = ccsB->getLocalYAxis(); // the vector V of the local coordinate system the measurement surface has
-  CLHEP::Hep3Vector UB = ccsB->getLocalXAxis(); // the vector U of the local coordinate system the measurement surface has
   
-  debug() << "\t ( " << xa << " " << ya << " " << za << " ) <--> ( " << xb << " " << yb << " " << zb << " )" << endmsg;
+  CLHEP::Hep3Vector WA = ccsA->getLocalZAxis(); // the vector W of the local coordinate system the measurement surface has
+  CLHEP::Hep3Vector VA = ccsA->getLocalYAxis(); // the vector V of the local coordinate system the measurement surface has
+  CLHEP::Hep3Vector WB = ccsB->getLocalZAxis();
+  CLHEP::Hep3Vector VB = ccsB->getLocalYAxis();
   
   //////////////////////////////////////////////////////////////////////////////////////////////////////
   // First: check if the two measurement surfaces are parallel (i.e. the w are parallel or antiparallel)
   double angle = fabs(WB.angle(WA));
   double angleMax = 1.*M_PI/180.;
   if(( angle > angleMax )&&( angle < M_PI-angleMax )){
-    _nPlanesNotParallel++;
+    _nPlanesNotParallel += nCombinations;
     debug() << "\tThe planes of the measurement surfaces are not parallel enough, the angle between the W vectors is " << angle
 	    << " where the angle has to be smaller than " << angleMax << " or bigger than " << M_PI-angleMax << endmsg;
-    throw std::runtime_error(""); //calculate the xing point and if that fails don't create a spacepoint
+    return false;
   }
   //////////////////////////////////////////////////////////////////////////////////////////////////////
  
@@ -310,111 +317,69 @@ edm4hep::TrackerHit SpacePointBuilderAlg::createSpacePoint( edm4hep::TrackerHit*
   angle = fabs(VB.angle(VA));
   double angleMin= 1.*M_PI/180.;
   if(( angle < angleMin )||( angle > M_PI-angleMin )){
-    _nStripsTooParallel++;
+    _nStripsTooParallel += nCombinations;
     debug() << "\tThe strips (V vectors) of the measurement surfaces are too parallel, the angle between the V vectors is " << angle
 	    << " where the angle has to be between " << angleMax << " or bigger than " << M_PI-angleMin << endmsg;
-    throw std::runtime_error(""); //calculate the xing point and if that fails don't create a spacepoint
+    return false;
   }
   //////////////////////////////////////////////////////////////////////////////////////////////////////
- 
-  //////////////////////////////////////////////////////////////////////////////////////////////////////
-  // Next we want to calculate the crossing point.
-  
-  CLHEP::Hep3Vector point;
-
-//  calculatePointBetweenTwoLines( PA, VA, PB, VB, point );
-//  
-//  // we want to set the space point on the surface of the hit closest to the IP
-//  if (PA.mag2() < PB.mag2()) {
-//    calculatePointBetweenTwoLines( PA, VA, PB, VB, point );
-//  } else {
-//    calculatePointBetweenTwoLines( PB, VB, PA, VA, point );
-//  }
-//  
-//
-//  
-//  streamlog_out( DEBUG2 ) << "\tStandard: Position of space point (global) : ( " << point.x() << " " << point.y() << " " << point.z() << " )\n";
-   
-  CLHEP::Hep3Vector vertex(0.,0.,0.);
-  CLHEP::Hep3Vector L1 = ccsA->getLocalPoint(PA);
-  CLHEP::Hep3Vector L2 = ccsB->getLocalPoint(PB);
-
-  debug() << " L1 = " << L1 << endmsg;
-  debug() << " L2 = " << L2 << endmsg;
-      
-  L1.setY(-stripLength/2.0);
-  CLHEP::Hep3Vector SL1 = L1;
-  L1.setY( stripLength/2.0);
-  CLHEP::Hep3Vector EL1 = L1;
   
+  return true;
+}
+
+void SpacePointBuilderAlg::getStripEnds( std::vector<edm4hep::TrackerHit>& hits, double stripLength, std::vector< double >& strips ){
   
-  L2.setY(-stripLength/2.0);
-  CLHEP::Hep3Vector SL2 = L2;
-  L2.setY( stripLength/2.0);
-  CLHEP::Hep3Vector EL2 = L2;
+  strips.resize( 6*hits.size() );
+  if( hits.empty() ) return;
   
+  gear::MeasurementSurface const* ms = _GEAR->getMeasurementSurfaceStore().GetMeasurementSurface( hits[0].getCellID() );
+  gear::CartesianCoordinateSystem* ccs = dynamic_cast< gear::CartesianCoordinateSystem* >( ms->getCoordinateSystem() );
   
-  CLHEP::Hep3Vector S1 = ccsA->getGlobalPoint(SL1);
-  CLHEP::Hep3Vector E1 = ccsA->getGlobalPoint(EL1);
-
-  CLHEP::Hep3Vector S2 = ccsB->getGlobalPoint(SL2);
-  CLHEP::Hep3Vector E2 = ccsB->getGlobalPoint(EL2);
-
-  debug() << " stripLength = " << stripLength << endmsg;
-  debug() << " S1 = " << S1 << endmsg;
-  debug() << " E1 = " << E1 << endmsg;
-  debug() << " S2 = " << S2 << endmsg;
-  debug() << " E2 = " << E2 << endmsg;
-
-  point.set(0.0, 0.0, 0.0);
+  // S = start, E = end of the strip
+  for( unsigned i=0; i<hits.size(); i++ ){
+    const edm4hep::Vector3d& p = hits[i].getPosition();
+    CLHEP::Hep3Vector L = ccs->getLocalPoint( CLHEP::Hep3Vector( p[0], p[1], p[2] ) );
     
-  int valid_intersection = calculatePointBetweenTwoLines_UsingVertex( S1, E1, S2, E2, vertex, point );
-  
-  if (valid_intersection != 0) {
-    debug() << "\tNo valid intersection for lines" << endmsg;
-    throw std::runtime_error("");
+    L.setY(-stripLength/2.0);
+    CLHEP::Hep3Vector S = ccs->getGlobalPoint(L);
+    L.setY( stripLength/2.0);
+    CLHEP::Hep3Vector E = ccs->getGlobalPoint(L);
+    
+    double* strip = &strips[6*i];
+    strip[0] = S.x(); strip[1] = S.y(); strip[2] = S.z();
+    strip[3] = E.x(); strip[4] = E.y(); strip[5] = E.z();
   }
+}
+
+std::vector< SpacePointBuilderAlg::SpacePointCandidate > SpacePointBuilderAlg::createSpacePoints( std::vector<edm4hep::TrackerHit>& hitsFront,
+                                                                                                   std::vector<edm4hep::TrackerHit>& hitsBack,
+                                                                                                   const std::vector< double >& stripsFront,
+                                                                                                   const std::vector< double >& stripsBack,
+                                                                                                   const std::vector< std::vector< unsigned > >& compatibleBackHits ){
+  std::vector< SpacePointCandidate > spacePoints;
   
-  debug() << "\tVertex: Position of space point (global) : ( " << point.x() << " " << point.y() << " " << point.z() << " )" << endmsg;
-  
-  // Check if the new hit is within the boundaries
-  CLHEP::Hep3Vector localPointA = ccsA->getLocalPoint(point);
-  localPointA.setZ(0.);// we set w to 0 so it is in the plane ( we are only interested if u and v are in or out of range, to exclude w from the check it is set to 0)
-  
-  CLHEP::Hep3Vector localPointB = ccsB->getLocalPoint(point);
-  localPointB.setZ(0.);// we set w to 0 so it is in the plane ( we are only interested if u and v are in or out of range, to exclude w from the check it is set to 0)
+  unsigned nPairs = 0;
+  for( unsigned i=0; i<compatibleBackHits.size(); i++ ) nPairs += compatibleBackHits[i].size();
+  if( nPairs == 0 ) return spacePoints;
   
-  if( !msA->isLocalInBoundary( localPointA ) ){
-    _nOutOfBoundary++;
-    debug() << "\tSpacePoint position lies outside the boundary of the first layer: local coordinates are ( " 
-	    << localPointA.x() << " " << localPointA.y() << " " << localPointA.z() << " )" << endmsg;
-    throw std::runtime_error("");
-  }
-  if( !msB->isLocalInBoundary( localPointB ) ){
-    _nOutOfBoundary++;
-    debug() << "\tSecond hit is out of boundary: local coordinates are ( " 
-	    << localPointB.x() << " " << localPointB.y() << " " << localPointB.z() << " )" << endmsg;
-    throw std::runtime_error("");
-  }
+  gear::MeasurementSurface const* msA = _GEAR->getMeasurementSurfaceStore().GetMeasurementSurface( hitsFront[0].getCellID() );
+  gear::CartesianCoordinateSystem* ccsA = dynamic_cast< gear::CartesianCoordinateSystem* >( msA->getCoordinateSystem() );
   
-  //Create the new TrackerHit
-  edm4hep::TrackerHit spacePoint;// = new edm4hep::TrackerHit();
+  CLHEP::Hep3Vector WA = ccsA->getLocalZAxis(); // the vector W of the local coordinate system the measurement surface has
+  CLHEP::Hep3Vector VA = ccsA->getLocalYAxis(); // the vector V of the local coordinate system the measurement surface has
+  CLHEP::Hep3Vector UA = ccsA->getLocalXAxis(); // the vector U of the local coordinate system the measurement surface has
   
-  edm4hep::Vector3d pos(point.x(), point.y(), point.z());
-  spacePoint.setPosition(pos) ;
+  gear::MeasurementSurface const* msB = _GEAR->getMeasurementSurfaceStore().GetMeasurementSurface( hitsBack[0].getCellID() );
+  gear::CartesianCoordinateSystem* ccsB = dynamic_cast< gear::CartesianCoordinateSystem* >( msB->getCoordinateSystem() );
   
-  // set error treating the strips as stereo with equal and opposite rotation -- for reference see Karimaki NIM A 374 p367-370
-
-  // first calculate the covariance matrix in the cartisian coordinate system defined by the sensor 
-  // here we assume that du is the same for both sides
+  CLHEP::Hep3Vector WB = ccsB->getLocalZAxis(); // the vector W of the local coordinate system the measurement surface has
+  CLHEP::Hep3Vector VB = ccsB->getLocalYAxis(); // the vector V of the local coordinate system the measurement surface has
+  CLHEP::Hep3Vector UB = ccsB->getLocalXAxis(); // the vector U of the local coordinate system the measurement surface has
   
-  if( fabs(du_a - du_b) > 1.0e-06 ){
-    error() << "\tThe measurement errors of the two 1D hits must be equal " << endmsg;    
-    assert( fabs(du_a - du_b) > 1.0e-06 == false );
-    throw std::runtime_error(""); //measurement errors are not equal don't create a spacepoint
-  }
-   
-  double du2 = du_a*du_a;
+  //////////////////////////////////////////////////////////////////////////////////////////////////////
+  // The covariance matrix: set error treating the strips as stereo with equal and opposite rotation 
+  // -- for reference see Karimaki NIM A 374 p367-370
+  // It only depends on the sensors and scales with du^2, so it is calculated once for du = 1.
   
   // rotate the strip system back to double-layer wafer system
   CLHEP::Hep3Vector u_sensor = UA + UB;
@@ -430,34 +395,206 @@ edm4hep::TrackerHit SpacePointBuilderAlg::createSpacePoint( edm4hep::TrackerHit*
   
   CLHEP::HepSymMatrix cov_plane(3,0); // u,v,w
   
-  cov_plane(1,1) = (0.5 * du2) / cos2_alpha;
-  cov_plane(2,2) = (0.5 * du2) / sin2_alpha;
+  cov_plane(1,1) = 0.5 / cos2_alpha;
+  cov_plane(2,2) = 0.5 / sin2_alpha;
   
-  debug() << "\t cov_plane  = " << cov_plane << endmsg;  
+  debug() << "\t cov_plane / du^2 = " << cov_plane << endmsg;  
   debug() << "\tstrip_angle = " << VA.angle(VB)/(M_PI/180) / 2.0 << " degrees " << endmsg;
   
   CLHEP::HepSymMatrix cov_xyz= cov_plane.similarity(rot_sensor_matrix);
   
-  debug() << "\t cov_xyz  = " << cov_xyz << endmsg;
-  
-  std::array<float, 6> cov;
-  //EVENT::FloatVec cov( 9 )  ; 
+  double covUnit[6];
   int icov = 0 ;
   for(int irow=0; irow<3; ++irow ){
     for(int jcol=0; jcol<irow+1; ++jcol){
-      //      std::cout << "row = " << irow << " col = " << jcol << std::endl ;
-      cov[icov] = cov_xyz[irow][jcol] ;
-//      std::cout << "cov["<< icov << "] = " << cov[icov] << std::endl ;
+      covUnit[icov] = cov_xyz[irow][jcol] ;
       ++icov ;
     }
   }
+  //////////////////////////////////////////////////////////////////////////////////////////////////////
   
-  spacePoint.setCovMatrix(cov);
+  //////////////////////////////////////////////////////////////////////////////////////////////////////
+  // Calculate the crossing points of all combinations in one go, on contiguous arrays (one entry per
+  // combination), so that the compiler can vectorise the loop.
+  //
+  // A general point on the line joining point A to point B is x, where 2*x=(1+m)*A + (1-m)*B. Similarly for
+  // 2*y=(1+n)*C + (1-n)*D. Requiring that the two 'general points' lie on a straight line through the vertex
+  // (the origin) means that the vector x is a multiple of y. This condition fixes the parameters m and n.
+  // The space point is x, on the layer of the front strip. We require that -1<m<1, otherwise x lies 
+  // outside the segment A to B; and similarly for n.
+  
+  std::vector< unsigned > pairFront;
+  std::vector< unsigned > pairBack;
+  pairFront.reserve( nPairs );
+  pairBack.reserve( nPairs );
+  for( unsigned i=0; i<compatibleBackHits.size(); i++ ){
+    for( unsigned k=0; k<compatibleBackHits[i].size(); k++ ){
+      pairFront.push_back( i );
+      pairBack.push_back( compatibleBackHits[i][k] );
+    }
+  }
+  
+  // the end points of the strips per combination: A, B of the front strip, C, D of the back strip
+  std::vector< double > ax( nPairs ), ay( nPairs ), az( nPairs ), bx( nPairs ), by( nPairs ), bz( nPairs );
+  std::vector< double > cx( nPairs ), cy( nPairs ), cz( nPairs ), dx( nPairs ), dy( nPairs ), dz( nPairs );
+  for( unsigned k=0; k<nPairs; k++ ){
+    const double* front = &stripsFront[ 6*pairFront[k] ];
+    const double* back  = &stripsBack[ 6*pairBack[k] ];
+    ax[k] = front[0]; ay[k] = front[1]; az[k] = front[2];
+    bx[k] = front[3]; by[k] = front[4]; bz[k] = front[5];
+    cx[k] = back[0];  cy[k] = back[1];  cz[k] = back[2];
+    dx[k] = back[3];  dy[k] = back[4];  dz[k] = back[5];
+  }
   
-  debug() << "\tHit accepted id=" << spacePoint.id() << endmsg;
+  std::vector< double > px( nPairs ), py( nPairs ), pz( nPairs );
+  std::vector< char > valid( nPairs );
   
-  return spacePoint;
+  for( unsigned k=0; k<nPairs; k++ ){
+    // direction vectors of the strips
+    double vabx = ax[k] - bx[k], vaby = ay[k] - by[k], vabz = az[k] - bz[k];
+    double vcdx = cx[k] - dx[k], vcdy = cy[k] - dy[k], vcdz = cz[k] - dz[k];
+    
+    // twice the vectors from the vertex to the midpoints
+    double sx = ax[k] + bx[k], sy = ay[k] + by[k], sz = az[k] + bz[k];
+    double tx = cx[k] + dx[k], ty = cy[k] + dy[k], tz = cz[k] + dz[k];
+    
+    // qs = VAB x s, rt = VCD x t
+    double qsx = vaby*sz - vabz*sy, qsy = vabz*sx - vabx*sz, qsz = vabx*sy - vaby*sx;
+    double rtx = vcdy*tz - vcdz*ty, rty = vcdz*tx - vcdx*tz, rtz = vcdx*ty - vcdy*tx;
+    
+    double m = -( sx*rtx + sy*rty + sz*rtz ) / ( vabx*rtx + vaby*rty + vabz*rtz ); // ratio for first line
+    double n = -( tx*qsx + ty*qsy + tz*qsz ) / ( vcdx*qsx + vcdy*qsy + vcdz*qsz ); // ratio for second line
+    
+    valid[k] = ( m >= -1. ) & ( m <= 1. ) & ( n >= -1. ) & ( n <= 1. );
+    
+    px[k] = 0.5*( ax[k] + bx[k] + m*vabx );
+    py[k] = 0.5*( ay[k] + by[k] + m*vaby );
+    pz[k] = 0.5*( az[k] + bz[k] + m*vabz );
+  }
+  //////////////////////////////////////////////////////////////////////////////////////////////////////
+  
+  //////////////////////////////////////////////////////////////////////////////////////////////////////
+  // Only the valid crossing points are checked against the sensor boundaries and get stored
+  
+  for( unsigned k=0; k<nPairs; k++ ){
+    if( !valid[k] ){
+      debug() << "\tNo valid intersection for lines" << endmsg;
+      continue;
+    }
+    
+    CLHEP::Hep3Vector point( px[k], py[k], pz[k] );
+    
+    debug() << "\tVertex: Position of space point (global) : ( " << point.x() << " " << point.y() << " " << point.z() << " )" << endmsg;
+    
+    // Check if the new hit is within the boundaries
+    CLHEP::Hep3Vector localPointA = ccsA->getLocalPoint(point);
+    localPointA.setZ(0.);// we set w to 0 so it is in the plane ( we are only interested if u and v are in or out of range, to exclude w from the check it is set to 0)
+    
+    CLHEP::Hep3Vector localPointB = ccsB->getLocalPoint(point);
+    localPointB.setZ(0.);// we set w to 0 so it is in the plane ( we are only interested if u and v are in or out of range, to exclude w from the check it is set to 0)
+    
+    if( !msA->isLocalInBoundary( localPointA ) ){
+      _nOutOfBoundary++;
+      debug() << "\tSpacePoint position lies outside the boundary of the first layer: local coordinates are ( " 
+	      << localPointA.x() << " " << localPointA.y() << " " << localPointA.z() << " )" << endmsg;
+      continue;
+    }
+    if( !msB->isLocalInBoundary( localPointB ) ){
+      _nOutOfBoundary++;
+      debug() << "\tSecond hit is out of boundary: local coordinates are ( " 
+	      << localPointB.x() << " " << localPointB.y() << " " << localPointB.z() << " )" << endmsg;
+      continue;
+    }
+    
+    // here we assume that du is the same for both sides
+    float du_a = hitsFront[ pairFront[k] ].getCovMatrix(2);
+    float du_b = hitsBack[ pairBack[k] ].getCovMatrix(2);
+    if( fabs(du_a - du_b) > 1.0e-06 ){
+      error() << "\tThe measurement errors of the two 1D hits must be equal " << endmsg;    
+      assert( fabs(du_a - du_b) > 1.0e-06 == false );
+      continue; //measurement errors are not equal don't create a spacepoint
+    }
+    
+    double du2 = du_a*du_a;
+    
+    SpacePointCandidate spacePoint;
+    spacePoint.front = pairFront[k];
+    spacePoint.back  = pairBack[k];
+    spacePoint.position = edm4hep::Vector3d( point.x(), point.y(), point.z() );
+    for( int i=0; i<6; i++ ) spacePoint.cov[i] = du2 * covUnit[i];
+    
+    spacePoints.push_back( spacePoint );
+  }
+  
+  return spacePoints;
 }
+
+std::vector< std::vector< unsigned > > SpacePointBuilderAlg::getCompatibleStripPairs( std::vector<edm4hep::TrackerHit>& hitsFront,
+                                                                                      std::vector<edm4hep::TrackerHit>& hitsBack,
+                                                                                      const std::vector< double >& stripsBack ){
+  std::vector< std::vector< unsigned > > compatible( hitsFront.size() );
+  if( hitsFront.empty() || hitsBack.empty() ) return compatible;
+  
+  gear::MeasurementSurface const* msA = _GEAR->getMeasurementSurfaceStore().GetMeasurementSurface( hitsFront[0].getCellID() );
+  gear::CartesianCoordinateSystem* ccsA = dynamic_cast< gear::CartesianCoordinateSystem* >( msA->getCoordinateSystem() );
+  
+  // the same vertex as in createSpacePoints
+  CLHEP::Hep3Vector localVertex = ccsA->getLocalPoint( CLHEP::Hep3Vector(0.,0.,0.) );
+  
+  // the front strips lie in the plane of the front sensor: take w of the first one
+  const edm4hep::Vector3d& p0 = hitsFront[0].getPosition();
+  double wA = ccsA->getLocalPoint( CLHEP::Hep3Vector( p0[0], p0[1], p0[2] ) ).z();
+  
+  // margin for rounding and the spread of w of the front strips
+  const double uTolerance = 1.e-3;
+  
+  std::vector< std::pair< double, unsigned > > centre_index; // u of the centre of the projected back strip and its index
+  std::vector< double > halfWidths( hitsBack.size(), 0. );
+  std::vector< unsigned > alwaysCompatible; // back strips, that can't be projected
+  double halfWidthMax = 0.;
+  
+  for( unsigned j=0; j<hitsBack.size(); j++ ){
+    const double* strip = &stripsBack[6*j];
+    CLHEP::Hep3Vector S2 = ccsA->getLocalPoint( CLHEP::Hep3Vector( strip[0], strip[1], strip[2] ) );
+    CLHEP::Hep3Vector E2 = ccsA->getLocalPoint( CLHEP::Hep3Vector( strip[3], strip[4], strip[5] ) );
+    
+    double dwS = S2.z() - localVertex.z();
+    double dwE = E2.z() - localVertex.z();
+    if( fabs( dwS ) < 1.e-9 || fabs( dwE ) < 1.e-9 ){
+      alwaysCompatible.push_back( j );
+      continue;
+    }
+    
+    double uS = localVertex.x() + ( wA - localVertex.z() ) / dwS * ( S2.x() - localVertex.x() );
+    double uE = localVertex.x() + ( wA - localVertex.z() ) / dwE * ( E2.x() - localVertex.x() );
+    
+    halfWidths[j] = fabs( uE - uS ) / 2. + uTolerance;
+    if( halfWidths[j] > halfWidthMax ) halfWidthMax = halfWidths[j];
+    centre_index.push_back( std::make_pair( ( uS + uE ) / 2., j ) );
+  }
+  
+  std::sort( centre_index.begin(), centre_index.end() );
+  
+  for( unsigned ifront=0; ifront<hitsFront.size(); ifront++ ){
+    const edm4hep::Vector3d& pa = hitsFront[ifront].getPosition();
+    double uA = ccsA->getLocalPoint( CLHEP::Hep3Vector( pa[0], pa[1], pa[2] ) ).x();
+    
+    std::vector< unsigned >& backIndices = compatible[ifront];
+    backIndices = alwaysCompatible;
+    
+    std::vector< std::pair< double, unsigned > >::const_iterator itBack =
+      std::lower_bound( centre_index.begin(), centre_index.end(), std::make_pair( uA - halfWidthMax, 0u ) );
+    for( ; itBack != centre_index.end() && itBack->first <= uA + halfWidthMax; ++itBack ){
+      if( fabs( itBack->first - uA ) <= halfWidths[ itBack->second ] ) backIndices.push_back( itBack->second );
+    }
+    
+    // keep the order of the back hits, so the space points are created in the same order as without this preselection
+    std::sort( backIndices.begin(), backIndices.end() );
+  }
+  
+  return compatible;
+}
+
 /*
 TrackerHitImpl* SpacePointBuilderAlg::createSpacePointOld( TrackerHitPlane* a , TrackerHitPlane* b ){
   
@@ -528,76 +665,6 @@ TrackerHitImpl* SpacePointBuilderAlg::createSpacePointOld( TrackerHitPlane* a ,
 
 
 
-int SpacePointBuilderAlg::calculatePointBetweenTwoLines_UsingVertex( 
-                                                const CLHEP::Hep3Vector& PA, 
-                                                const CLHEP::Hep3Vector& PB, 
-                                                const CLHEP::Hep3Vector& PC, 
-                                                const CLHEP::Hep3Vector& PD,
-                                                const CLHEP::Hep3Vector& Vertex,
-                                                CLHEP::Hep3Vector& point){
-
-  
-  // A general point on the line joining point PA to point PB is
-  // x, where 2*x=(1+m)*PA + (1-m)*PB. Similarly for 2*y=(1+n)*PC + (1-n)*PD.
-  // Suppose that v is the vertex. Requiring that the two 'general
-  // points' lie on a straight through v means that the vector x-v is a 
-  // multiple of y-v. This condition fixes the parameters m and n.
-  // We then return the 'space-point' x, supposed to be the layer containing PA and PB. 
-  // We require that -1<m<1, otherwise x lies 
-  // outside the segment PA to PB; and similarly for n.
-  
-  bool ok = true;
-  
-//  streamlog_out( DEBUG1 ) << " Vertex = " << Vertex << std::endl; 
-//  
-//  streamlog_out( DEBUG1 ) << " PA = " << PA << std::endl;
-//  streamlog_out( DEBUG1 ) << " PB = " << PB << std::endl;
-//  streamlog_out( DEBUG1 ) << " PC = " << PC << std::endl;
-//  streamlog_out( DEBUG1 ) << " PD = " << PD << std::endl;
-  
-  CLHEP::Hep3Vector VAB(PA-PB);
-  CLHEP::Hep3Vector VCD(PC-PD);
-
-//  streamlog_out( DEBUG1 ) << " VAB = " << VAB << std::endl;
-//  streamlog_out( DEBUG1 ) << " VCD = " << VCD << std::endl;
-  
-  CLHEP::Hep3Vector  s(PA+PB-2*Vertex);   // twice the vector from vertex to midpoint
-  CLHEP::Hep3Vector  t(PC+PD-2*Vertex);   // twice the vector from vertex to midpoint
-
-  CLHEP::Hep3Vector  qs(VAB.cross(s));  
-  CLHEP::Hep3Vector  rt(VCD.cross(t));  
-
-//  streamlog_out( DEBUG1 ) << " s = " << s << std::endl;
-//  streamlog_out( DEBUG1 ) << " t = " << t << std::endl;
-//  streamlog_out( DEBUG1 ) << " qs = " << qs << std::endl;
-//  streamlog_out( DEBUG1 ) << " rt = " << rt << std::endl;
-  
-  
-  double m = (-(s*rt)/(VAB*rt)); // ratio for first line
-    
-  double limit = 1.0;
-  
-  if (m>limit || m<-1.*limit) {
-    debug() << "m' = " << m << endmsg;
-    ok = false;
-  }
-  else {
-    double n = (-(t*qs)/(VCD*qs)); // ratio for second line
-    if (n>limit || n<-1.*limit) {
-      debug() << "n' = " << n << endmsg;
-      ok = false;
-    }
-  }
-  
-  if (ok) {
-    point = 0.5*(PA + PB + m*VAB);
-  }
-  
-  return ok ? 0 : 1;
-}
-
-
-
 int SpacePointBuilderAlg::calculatePointBetweenTwoLines( const CLHEP::Hep3Vector& P1, const CLHEP::Hep3Vector& V1, const CLHEP::Hep3Vector& P2, const CLHEP::Hep3Vector& V2, CLHEP::Hep3Vector& point ){
   
   // Richgungsvektor normal auf die anderen beiden:
@@ -11,6 +11,8 @@
 
 #include "CLHEP/Vector/ThreeVector.h"
 
+#include <array>
+
 /** ================= FTD Space Point Builder =================
  * 
  * Builds space points for pairs of silicon strip detectors. 
@@ -123,28 +125,69 @@ class SpacePointBuilderAlg : public GaudiAlgorithm {
 
   
   
-  /** Calculates the intersection of a line L and line PAPB ( strip on the first sensor ). 
-   *  L is constrained to pass through the point "Vertex" and bisect both lines PAPB ( strip on the first sensor ) and PCPD ( strip on the second sensor )
-   * @param PA start of the first line
-   * @param PB end of the first line
-   * @param PC start of the second line
-   * @param PD end of the second line
-   * @param Vertex the position 
+  /** Checks that the two sensors are parallel and that their strips are not. As this holds for all combinations 
+   * of their hits or for none, a failing pair adds all the combinations to _nPlanesNotParallel or _nStripsTooParallel.
    * 
-   * @param point the reference to a point where the result will be stored
+   * @return whether space points can be made from the hits on the two sensors
+   * 
+   * @param hitsFront the hits on the front sensor
+   * @param hitsBack the hits on the sensor at the back of it, not empty
    */
-  //static
-    int calculatePointBetweenTwoLines_UsingVertex( 
-                                                  const CLHEP::Hep3Vector& PA, 
-                                                  const CLHEP::Hep3Vector& PB, 
-                                                  const CLHEP::Hep3Vector& PC, 
-                                                  const CLHEP::Hep3Vector& PD,
-                                                  const CLHEP::Hep3Vector& Vertex,
-                                                  CLHEP::Hep3Vector& point);
+  bool checkSensorPair( std::vector<edm4hep::TrackerHit>& hitsFront, std::vector<edm4hep::TrackerHit>& hitsBack );
   
+  /** Calculates the global end points of the strips of the hits on one sensor. They are calculated once per hit
+   * and used both to find the compatible strip pairs and to create the space points.
+   * 
+   * @param hits the hits on one sensor
+   * @param stripLength the length of the strips
+   * @param strips filled with Sx, Sy, Sz, Ex, Ey, Ez (S = start, E = end of the strip) for every hit
+   */
+  void getStripEnds( std::vector<edm4hep::TrackerHit>& hits, double stripLength, std::vector< double >& strips );
   
-  /** @return a spacepoint (in the form of a TrackerHitImpl* ) created from two TrackerHitPlane* which stand for si-strips */
-  edm4hep::TrackerHit createSpacePoint( edm4hep::TrackerHit* a , edm4hep::TrackerHit* b, double stripLength );
+  /** Finds the combinations of front and back strip hits, where the strips can cross each other at all.
+   * 
+   * The back strips are projected through the vertex onto the plane of the front sensor. There every front strip
+   * has a fixed u coordinate, so a back strip can only cross it, if the u range covered by its projection contains it.
+   * The projected back strips are sorted by u, so that for every front strip only the back strips in a window around 
+   * it have to be checked.
+   * 
+   * @return for every front hit the indices of the compatible back hits (in ascending order)
+   * 
+   * @param hitsFront the hits on the front sensor
+   * @param hitsBack the hits on the sensor at the back of it
+   * @param stripsBack the end points of the back strips, see getStripEnds
+   */
+  std::vector< std::vector< unsigned > > getCompatibleStripPairs( std::vector<edm4hep::TrackerHit>& hitsFront,
+                                                                  std::vector<edm4hep::TrackerHit>& hitsBack,
+                                                                  const std::vector< double >& stripsBack );
+  
+  /** A space point, that passed all checks, before it gets stored as edm4hep::TrackerHit */
+  struct SpacePointCandidate{
+    unsigned front; // index of the front hit
+    unsigned back;  // index of the back hit
+    edm4hep::Vector3d position;
+    std::array<float, 6> cov;
+  };
+  
+  /** Creates the space points for all compatible combinations of strip hits on a front and a back sensor at once.
+   * 
+   * The sensors have to pass checkSensorPair. The covariance matrix per du^2 depends only on the two sensors
+   * and is calculated once. The crossing points of all combinations are then calculated in one pass over
+   * contiguous arrays and only the valid ones are checked against the sensor boundaries.
+   * 
+   * @return the space points, that are within both sensors
+   * 
+   * @param hitsFront the hits on the front sensor
+   * @param hitsBack the hits on the sensor at the back of it
+   * @param stripsFront the end points of the front strips, see getStripEnds
+   * @param stripsBack the end points of the back strips, see getStripEnds
+   * @param compatibleBackHits for every front hit the indices of the back hits to combine it with
+   */
+  std::vector< SpacePointCandidate > createSpacePoints( std::vector<edm4hep::TrackerHit>& hitsFront,
+                                                        std::vector<edm4hep::TrackerHit>& hitsBack,
+                                                        const std::vector< double >& stripsFront,
+                                                        const std::vector< double >& stripsBack,
+                                                        const std::vector< std::vector< unsigned > >& compatibleBackHits );
   
 //   TrackerHitImpl* createSpacePointOld( TrackerHitPlane* a , TrackerHitPlane* b );
   
@@ -173,6 +216,7 @@ class SpacePointBuilderAlg : public GaudiAlgorithm {
   unsigned _nOutOfBoundary;
   unsigned _nStripsTooParallel;
   unsigned _nPlanesNotParallel;
+  unsigned _nStripsNotCrossing;
 
   CLHEP::Hep3Vector _nominal_vertex;
 } ;
@@ -78,6 +78,11 @@ StatusCode TrackSubsetAlg::initialize() {
   // initialise the tracking system
   //_trkSystem->init() ;
 
+  if( _bestSubsetFinder != "SubsetHopfieldNN" && _bestSubsetFinder != "SubsetSimple" ){
+    error() << "Unknown BestSubsetFinder " << _bestSubsetFinder.value() << ", available are SubsetHopfieldNN and SubsetSimple" << endmsg;
+    return StatusCode::FAILURE;
+  }
+
   return GaudiAlgorithm::initialize();
 }
 
@@ -145,7 +150,7 @@ StatusCode TrackSubsetAlg::execute(){
   /**********************************************************************************************/
   /*       Make sure that all tracks are compatible: find the best subset                       */
   /**********************************************************************************************/
-  debug() << "Find the best subset of tracks using the Hopfield Neural Network" << endmsg;
+  debug() << "Find the best subset of tracks using " << _bestSubsetFinder.value() << endmsg;
   
   TrackQI trackQI( _trkSystem );
   
@@ -172,16 +177,9 @@ StatusCode TrackSubsetAlg::execute(){
     debug() << ")" << endmsg;
   }
   
-  TrackCompatibility comp;
-  
-  SubsetHopfieldNN<edm4hep::Track*> subset;
-  //SubsetSimple<edm4hep::Track* > subset;
-  subset.add( tracks_p );
-  subset.setOmega( _omega );
-  subset.calculateBestSet( comp, trackQI );
-
-  std::vector<edm4hep::Track*> accepted = subset.getAccepted();
-  std::vector<edm4hep::Track*> rejected = subset.getRejected();
+  std::vector<edm4hep::Track*> accepted;
+  std::vector<edm4hep::Track*> rejected;
+  getBestSubset( tracks_p, accepted, rejected );
   
   debug() << "\tThe accepted tracks:" << endmsg;
   for( unsigned i=0; i < accepted.size(); i++ ){
@@ -339,3 +337,108 @@ StatusCode TrackSubsetAlg::execute(){
 
 
 
+
+void TrackSubsetAlg::getBestSubset( const std::vector<edm4hep::Track*>& tracks, std::vector<edm4hep::Track*>& accepted, std::vector<edm4hep::Track*>& rejected ){
+  
+  TrackQI trackQI( _trkSystem );
+  TrackCompatibility comp;
+  
+  /**********************************************************************************************/
+  /*       Split the tracks into groups connected by shared hits                               */
+  /**********************************************************************************************/
+  // Tracks are only incompatible if they share a hit, so the best subset can be searched within each group
+  // of tracks that are connected by shared hits (directly or via other tracks) independently.
+  // The groups are found with a union-find: the root of every group is the track with the smallest index.
+  std::vector<unsigned> root( tracks.size() );
+  for( unsigned i=0; i < tracks.size(); i++ ) root[i] = i;
+  
+  auto findRoot = [&root]( unsigned i ){
+    while( root[i] != i ){
+      root[i] = root[ root[i] ];
+      i = root[i];
+    }
+    return i;
+  };
+  
+  std::map<unsigned, unsigned> map_hitID_track; // the id of a hit and the first track it was found on
+  for( unsigned i=0; i < tracks.size(); i++ ){
+    for( auto it = tracks[i]->trackerHits_begin(); it != tracks[i]->trackerHits_end(); ++it ){
+      std::pair< std::map<unsigned, unsigned>::iterator, bool > inserted = map_hitID_track.insert( std::make_pair( it->id(), i ) );
+      if( inserted.second ) continue;
+      
+      // the hit is shared with another track: join the groups
+      unsigned rootA = findRoot( inserted.first->second );
+      unsigned rootB = findRoot( i );
+      if( rootA < rootB ) root[rootB] = rootA;
+      else if( rootB < rootA ) root[rootA] = rootB;
+    }
+  }
+  
+  std::map<unsigned, std::vector<edm4hep::Track*> > map_root_tracks;
+  for( unsigned i=0; i < tracks.size(); i++ ){
+    map_root_tracks[ findRoot( i ) ].push_back( tracks[i] );
+  }
+  
+  debug() << "The " << tracks.size() << " tracks form " << map_root_tracks.size() << " groups connected by shared hits" << endmsg;
+  
+  /**********************************************************************************************/
+  /*       Find the best subset in every group                                                  */
+  /**********************************************************************************************/
+  for( std::map<unsigned, std::vector<edm4hep::Track*> >::iterator it = map_root_tracks.begin(); it != map_root_tracks.end(); ++it ){
+    std::vector<edm4hep::Track*>& group = it->second;
+    
+    if( group.size() == 1 ){ // compatible with all others
+      accepted.push_back( group[0] );
+    }
+    else if( group.size() == 2 ){ // the two tracks share a hit: take the better one
+      if( trackQI( group[1] ) > trackQI( group[0] ) ) std::swap( group[0], group[1] );
+      accepted.push_back( group[0] );
+      rejected.push_back( group[1] );
+    }
+    else{
+      debug() << "Find the best subset of a group of " << group.size() << " tracks" << endmsg;
+      
+      std::vector<edm4hep::Track*> groupAccepted;
+      std::vector<edm4hep::Track*> groupRejected;
+      
+      if( _bestSubsetFinder == "SubsetSimple" ){
+        SubsetSimple<edm4hep::Track*> subset;
+        subset.add( group );
+        subset.calculateBestSet( comp, trackQI );
+        groupAccepted = subset.getAccepted();
+        groupRejected = subset.getRejected();
+      }
+      else{
+        SubsetHopfieldNN<edm4hep::Track*> subset;
+        subset.add( group );
+        subset.setOmega( _omega );
+        subset.calculateBestSet( comp, trackQI );
+        groupAccepted = subset.getAccepted();
+        groupRejected = subset.getRejected();
+      }
+      
+      accepted.insert( accepted.end(), groupAccepted.begin(), groupAccepted.end() );
+      rejected.insert( rejected.end(), groupRejected.begin(), groupRejected.end() );
+    }
+  }
+  
+  /**********************************************************************************************/
+  /*       Restore the order of the input tracks                                                */
+  /**********************************************************************************************/
+  // The groups come out one after the other and the finders have their own order, the output collection
+  // keeps the order of the input tracks instead, whichever finder is used.
+  std::map<edm4hep::Track*, unsigned> map_track_index;
+  for( unsigned i=0; i < tracks.size(); i++ ) map_track_index.insert( std::make_pair( tracks[i], i ) );
+  
+  auto sortByInput = [&map_track_index]( std::vector<edm4hep::Track*>& trackVec ){
+    std::vector< std::pair<unsigned, edm4hep::Track*> > index_track; // the input index next to the track
+    index_track.reserve( trackVec.size() );
+    for( unsigned i=0; i < trackVec.size(); i++ ){
+      index_track.push_back( std::make_pair( map_track_index.find( trackVec[i] )->second, trackVec[i] ) );
+    }
+    std::sort( index_track.begin(), index_track.end() ); // the indices are unique
+    for( unsigned i=0; i < trackVec.size(); i++ ) trackVec[i] = index_track[i].second;
+  };
+  sortByInput( accepted );
+  sortByInput( rejected );
+}
@@ -37,6 +37,11 @@
  * @param Omega The parameter omega for the HNN. Controls the influence of the quality indicator. Between 0 and 1:
  * 1 means high influence of quality indicator, 0 means no influence. 
  * 
+ * @param BestSubsetFinder The method used to find the best non overlapping subset of tracks. Available are SubsetHopfieldNN
+ * and SubsetSimple. The tracks are split into groups connected by shared hits first and the method is only used on groups
+ * of more than two tracks. For SubsetSimple this gives the same result as using it on all tracks at once.<br>
+ * (default value SubsetHopfieldNN )
+ * 
  * @author Robin Glattauer, HEPHY
  * 
  */
@@ -53,6 +58,14 @@ class TrackSubsetAlg : public GaudiAlgorithm {
   virtual StatusCode finalize() ;
   
  protected:
+  /* Finds the best subset of compatible tracks.
+   * The tracks are split into groups connected by shared hits. Groups of one track are accepted, of two tracks the one with
+   * the better quality is taken and for bigger groups the best subset is searched with the chosen BestSubsetFinder.
+   * The accepted and the rejected tracks keep the order they have in the input.
+   */
+  void getBestSubset( const std::vector<edm4hep::Track*>& tracks, std::vector<edm4hep::Track*>& accepted, std::vector<edm4hep::Track*>& rejected );
+  
+
   MarlinTrk::IMarlinTrkSystem* _trkSystem;
   /* Input collection */
   std::vector<DataHandle<edm4hep::TrackCollection>* > _inTrackColHdls;
@@ -73,6 +86,7 @@ class TrackSubsetAlg : public GaudiAlgorithm {
   Gaudi::Property<float> _initialTrackError_tanL{this, "InitialTrackErrorTanL",1e2};
   Gaudi::Property<double> _maxChi2PerHit{this, "MaxChi2PerHit", 1e2};
   Gaudi::Property<double> _omega{this, "Omega", 0.75};
+  Gaudi::Property<std::string> _bestSubsetFinder{this, "BestSubsetFinder", "SubsetHopfieldNN"};
   
   float _bField;
   
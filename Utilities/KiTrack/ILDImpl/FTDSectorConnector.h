@@ -5,6 +5,8 @@
 
 #include "ILDImpl/SectorSystemFTD.h"
 
+#include <vector>
+
 
 
 namespace KiTrackMarlin{
@@ -44,6 +46,13 @@ namespace KiTrackMarlin{
       unsigned _petalStepMax;
       unsigned _lastLayerToIP;
       
+      /** For every module: the module and sensor part of the sector codes of all sensors on the petals in reach.
+       * Only side and layer have to be added to get the target sectors. */
+      std::vector< std::vector< int > > _neighbourCodes;
+      
+      /** The module and sensor part of the sector codes of all sensors on a layer (used for the jump to the IP) */
+      std::vector< int > _allSensorCodes;
+      
       
    };
    
@@ -0,0 +1,75 @@
+#ifndef SectorCodeField_h
+#define SectorCodeField_h
+
+
+
+namespace KiTrackMarlin{
+
+   /** One field of a packed sector code.
+    *
+    * A sector code is made of several fields (like layer, module, sensor), each occupying a contiguous group of bits.
+    * The width of a field is the smallest number of bits able to hold all its values and is fixed when the sector
+    * system is configured. Encoding and decoding a field are then a shift and a mask.
+    *
+    * Fields are laid out from the least to the most significant bits in the order they are created, so
+    * sector codes keep the ordering of the old mixed radix numbering.
+    */
+   class SectorCodeField{
+
+
+   public:
+
+      SectorCodeField(): _shift(0), _width(0), _mask(0){}
+
+      /**
+       * @param nValues the number of values the field has to hold (0 to nValues-1)
+       *
+       * @param shift the position of the lowest bit of the field
+       */
+      SectorCodeField( unsigned nValues , unsigned shift ):
+         _shift( shift ), _width( bitsNeeded( nValues ) ), _mask( _width < 32 ? ( 1u << _width ) - 1u : ~0u ){}
+
+      /** @return the bits of the value shifted into the place of the field */
+      int encode( unsigned value ) const { return int( value << _shift ); }
+
+      /** @return the value of the field in the passed sector code */
+      unsigned decode( int sector ) const { return ( unsigned( sector ) >> _shift ) & _mask; }
+
+      /** @return the sector code with this field replaced by value */
+      int replace( int sector , unsigned value ) const {
+
+         return int( ( unsigned( sector ) & ~( _mask << _shift ) ) | ( value << _shift ) );
+
+      }
+
+      /** @return the position of the first bit after this field, i.e. the shift of the next field */
+      unsigned getEnd() const { return _shift + _width; }
+
+      unsigned getShift() const { return _shift; }
+      unsigned getWidth() const { return _width; }
+
+
+      /** @return the number of bits needed to store the values 0 to nValues-1 */
+      static unsigned bitsNeeded( unsigned nValues ){
+
+         unsigned bits = 0;
+         while( bits < 32 && ( 1ull << bits ) < nValues ) bits++;
+         return bits;
+
+      }
+
+
+   private:
+
+      unsigned _shift;
+      unsigned _width;
+      unsigned _mask;
+
+   };
+
+
+}
+
+
+#endif
+
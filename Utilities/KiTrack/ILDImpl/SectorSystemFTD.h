@@ -3,6 +3,10 @@
 
 #include "KiTrack/ISectorSystem.h"
 
+#include "ILDImpl/SectorCodeField.h"
+
+#include <cassert>
+
 using namespace KiTrack;
 
 namespace KiTrackMarlin{
@@ -19,6 +23,10 @@ namespace KiTrackMarlin{
     * 
     * @param sensor: the sensor on the module
     * 
+    * The sector is a packed code: sensor, module, layer and side each get a bit field (in this order from
+    * the lowest bits on), with widths fixed by the configuration. So encoding and decoding are only shifts and masks.
+    * getSector throws OutOfRange for values outside the configuration; decoding a sector only asserts its range
+    * (i.e. in debug builds), as this is called for every hit and segment.
     * 
     */ 
    class SectorSystemFTD : public ISectorSystem{
@@ -34,20 +42,36 @@ namespace KiTrackMarlin{
        * @param nModules the number of modules per disk.
        * 
        * @param nSensors the number of sensors on one module.
+       * 
+       * @throws OutOfRange if the packed sector code would not fit into an int
        */
       SectorSystemFTD( unsigned nLayers , unsigned nModules , unsigned nSensors );
       
       
       /** Calculates the sector number corresponding to the passed parameters
+       * 
+       * @throws OutOfRange if the side, layer, module or sensor is not in the configuration
        */
-      int getSector( int side, unsigned layer , unsigned module , unsigned sensor ) const ;
+      int getSector( int side, unsigned layer , unsigned module , unsigned sensor ) const {
+         
+         if ( ( ( side != 1 )&&( side != -1 ) )||( layer >= _nLayers )||( module >= _nModules )||( sensor >= _nSensors ) ){
+            
+            throwSectorOutOfRange( side, layer, module, sensor );
+            
+         }
+         
+         // (side+1) /2 gives 0 for backward (-1) and 1 for forward (+1)
+         return _sideField.encode( unsigned( side + 1 ) >> 1 ) | _layerField.encode( layer ) 
+              | _moduleField.encode( module ) | _sensorField.encode( sensor );
+         
+      }
       
       
       /** Virtual, because this method is demanded by the Interface ISectorSystem
        * 
        * @return the layer corresponding to the passed sector number
        */
-      virtual unsigned getLayer( int sector ) const ;
+      virtual unsigned getLayer( int sector ) const { assert( isSectorInRange( sector ) ); return _layerField.decode( sector ); }
       
       
       /** @return some information on the sector as string */
@@ -55,21 +79,27 @@ namespace KiTrackMarlin{
       
       /** @return the side the sector is on (+1 = forward, -1 = backward)
        */
-      int getSide( int sector ) const ;
+      int getSide( int sector ) const { assert( isSectorInRange( sector ) ); return int( _sideField.decode( sector ) )*2 - 1; }
       
       /** @return the module of the sector
        */
-      unsigned getModule( int sector ) const ; 
+      unsigned getModule( int sector ) const { assert( isSectorInRange( sector ) ); return _moduleField.decode( sector ); }
       
       /** @return the sensor of the sector
        */
-      unsigned getSensor( int sector ) const ;
+      unsigned getSensor( int sector ) const { assert( isSectorInRange( sector ) ); return _sensorField.decode( sector ); }
       
       
       
       unsigned getNumberOfModules() const { return _nModules; }
       unsigned getNumberOfSensors() const { return _nSensors; }
       
+      /** The bit fields of the sector code. Sector connectors can use them to precompute the codes of their target sectors. */
+      const SectorCodeField& getSideField() const { return _sideField; }
+      const SectorCodeField& getLayerField() const { return _layerField; }
+      const SectorCodeField& getModuleField() const { return _moduleField; }
+      const SectorCodeField& getSensorField() const { return _sensorField; }
+      
       virtual ~SectorSystemFTD(){}
       
    private:
@@ -77,10 +107,19 @@ namespace KiTrackMarlin{
       unsigned _nModules;
       unsigned _nSensors;
       
+      SectorCodeField _sensorField;
+      SectorCodeField _moduleField;
+      SectorCodeField _layerField;
+      SectorCodeField _sideField;
+      
       int _sectorMax;
       
+      bool isSectorInRange( int sector ) const { return ( sector >= 0 )&&( sector <= _sectorMax ); }
+      
       void checkSectorIsInRange( int sector ) const ;
       
+      void throwSectorOutOfRange( int side, unsigned layer, unsigned module, unsigned sensor ) const ;
+      
    };
 
 
@@ -3,7 +3,10 @@
 
 #include "KiTrack/ISectorSystem.h"
 
+#include "ILDImpl/SectorCodeField.h"
+
 #include <vector>
+#include <cassert>
 
 using namespace KiTrack;
 
@@ -21,6 +24,9 @@ namespace KiTrackMarlin{
     * 
     * @param sensor: the sensor on the module
     * 
+    * The sector is a packed code: layer, phi and theta division each get a bit field (in this order from
+    * the lowest bits on), with widths fixed by the configuration. getSector throws OutOfRange for divisions
+    * outside the configuration, decoding a sector only asserts its range.
     * 
     */ 
    class SectorSystemVXD : public ISectorSystem{
@@ -44,21 +50,49 @@ namespace KiTrackMarlin{
        * 
        * @return the layer corresponding to the passed sector number
        */
-      virtual unsigned getLayer( int sector ) const ;
+      virtual unsigned getLayer( int sector ) const { assert( isSectorInRange( sector ) ); return _layerField.decode( sector ); }
       
-      virtual unsigned getPhi( int sector ) const ;
+      virtual unsigned getPhi( int sector ) const { assert( isSectorInRange( sector ) ); return _phiField.decode( sector ); }
 
-      virtual unsigned getTheta( int sector ) const ;
+      virtual unsigned getTheta( int sector ) const { assert( isSectorInRange( sector ) ); return _thetaField.decode( sector ); }
 
       /** @return some information on the sector as string */
       virtual std::string getInfoOnSector( int sector) const;
 
 
       /** Calculates the sector number corresponding to the passed parameters
+       * 
+       * @throws OutOfRange if the layer, phi or theta division is not in the configuration
        */
-      int getSector( int layer, int phi, int theta ) const ;
-
-      int getSector( int layer, double phi, double cosTheta ) const ;
+      int getSector( int layer, int phi, int theta ) const {
+        
+        if ( ( unsigned( layer ) >= _nLayers )||( unsigned( phi ) >= _nDivisionsInPhi )||( unsigned( theta ) >= _nDivisionsInTheta ) ){
+          
+          throwSectorOutOfRange( layer, phi, theta );
+          
+        }
+        
+        return _layerField.encode( layer ) | _phiField.encode( phi ) | _thetaField.encode( theta );
+        
+      }
+
+      /** Calculates the sector number of a position given by phi in [0, 2pi] and cos(theta) in [-1, 1].
+       * phi = 2pi and cos(theta) = 1 belong to the last division.
+       */
+      int getSector( int layer, double phi, double cosTheta ) const {
+        
+        int iPhi = int( phi / _dPhi );
+        int iTheta = int( ( cosTheta + 1.0 ) / _dTheta );
+        
+        if ( iPhi < 0 ) iPhi = 0;
+        else if ( unsigned( iPhi ) >= _nDivisionsInPhi ) iPhi = _nDivisionsInPhi - 1;
+        
+        if ( iTheta < 0 ) iTheta = 0;
+        else if ( unsigned( iTheta ) >= _nDivisionsInTheta ) iTheta = _nDivisionsInTheta - 1;
+        
+        return getSector( layer, iPhi, iTheta );
+        
+      }
       
       unsigned getPhiSectors() const ;
 
@@ -66,6 +100,11 @@ namespace KiTrackMarlin{
 
       unsigned getNLayers() const ;
 
+      /** The bit fields of the sector code. Sector connectors can use them to precompute the codes of their target sectors. */
+      const SectorCodeField& getLayerField() const { return _layerField; }
+      const SectorCodeField& getPhiField() const { return _phiField; }
+      const SectorCodeField& getThetaField() const { return _thetaField; }
+
       virtual ~SectorSystemVXD(){}
       
    private:
@@ -75,7 +114,16 @@ namespace KiTrackMarlin{
       unsigned _nDivisionsInPhi ;
       unsigned _nDivisionsInTheta ;
       
-      void checkSectorIsInRange( int sector ) const ;
+      double _dPhi ;   // size of a phi division
+      double _dTheta ; // size of a cos(theta) division
+      
+      SectorCodeField _layerField;
+      SectorCodeField _phiField;
+      SectorCodeField _thetaField;
+      
+      bool isSectorInRange( int sector ) const { return ( sector >= 0 )&&( sector <= _sectorMax ); }
+      
+      void throwSectorOutOfRange( int layer, int phi, int theta ) const ;
       
    };
 
@@ -12,6 +12,47 @@ FTDSectorConnector::FTDSectorConnector( const SectorSystemFTD* sectorSystemFTD ,
    _lastLayerToIP = lastLayerToIP;
    _petalStepMax = petalStepMax;
    
+   
+   const SectorCodeField& moduleField = _sectorSystemFTD->getModuleField();
+   const SectorCodeField& sensorField = _sectorSystemFTD->getSensorField();
+   
+   unsigned nModules = _sectorSystemFTD->getNumberOfModules();
+   unsigned nSensors = _sectorSystemFTD->getNumberOfSensors();
+   
+   _neighbourCodes.resize( nModules );
+   
+   for ( unsigned module=0; module < nModules; module++ ){
+      
+      for ( unsigned iSensor=0; iSensor < nSensors ; iSensor++){ //over all sensors
+         
+         
+         for ( int iPetal= int(module) - int(_petalStepMax); iPetal <= int(module) + int(_petalStepMax) ; iPetal++ ){ 
+            
+            //if iPetal is out of the range from 0 to nModules-1, move it back there. 
+            //And of course use a different variable for that. 
+            //(Or else we would create and endless loop: imagine we have iPetal = 16 and set it back to 0--> the loop will continue from there until it reaches 16 again and so on...)
+            int iModule = iPetal;
+            while( iModule < 0 ) iModule+= nModules;
+            while( iModule >= int(nModules) ) iModule -= nModules;
+            
+            _neighbourCodes[module].push_back( moduleField.encode( iModule ) | sensorField.encode( iSensor ) );
+            
+         }
+         
+      }
+      
+   }
+   
+   for ( unsigned iModule=0; iModule < nModules ; iModule++){ //over all modules
+      
+      for ( unsigned iSensor=0; iSensor < nSensors ; iSensor++ ){ //over all sensors
+         
+         _allSensorCodes.push_back( moduleField.encode( iModule ) | sensorField.encode( iSensor ) );
+         
+      }
+      
+   }
+   
 }
 
 
@@ -26,11 +67,8 @@ std::set< int > FTDSectorConnector::getTargetSectors ( int sector ){
    int side = _sectorSystemFTD->getSide( sector );
    unsigned layer = _sectorSystemFTD->getLayer( sector );
    unsigned module = _sectorSystemFTD->getModule( sector );
-//    unsigned sensor = _sectorSystemFTD->getSensor( sector );
    
-//    unsigned nLayers = _sectorSystemFTD->getNumberOfLayers();
-   unsigned nModules = _sectorSystemFTD->getNumberOfModules();
-   unsigned nSensors = _sectorSystemFTD->getNumberOfSensors();
+   const std::vector< int >& neighbourCodes = _neighbourCodes[module];
    
    
    for( unsigned layerStep = 1; layerStep <= _layerStepMax; layerStep++ ){
@@ -42,24 +80,10 @@ std::set< int > FTDSectorConnector::getTargetSectors ( int sector ){
          
          unsigned layerTarget = layer - layerStep;
          
+         // module 0 and sensor 0 are all zero bits, so this is only the side and layer part of the code
+         int sideLayerCode = _sectorSystemFTD->getSector ( side , layerTarget , 0 , 0 );
          
-         for ( unsigned iSensor=0; iSensor < nSensors ; iSensor++){ //over all sensors
-            
-            
-            for ( int iPetal= int(module) - _petalStepMax; iPetal <= int(module) + int(_petalStepMax) ; iPetal++ ){ 
-               
-               //if iPetal is out of the range from 0 to nModules-1, move it back there. 
-               //And of course use a different variable for that. 
-               //(Or else we would create and endless loop: imagine we have iPetal = 16 and set it back to 0--> the loop will continue from there until it reaches 16 again and so on...)
-               int iModule = iPetal;
-               while( iModule < 0 ) iModule+= nModules;
-               while( iModule >= int(nModules) ) iModule -= nModules;
-               
-               targetSectors.insert( _sectorSystemFTD->getSector ( side , layerTarget , iModule , iSensor ) ); 
-               
-            }
-            
-         }
+         for ( unsigned i=0; i < neighbourCodes.size(); i++ ) targetSectors.insert( sideLayerCode | neighbourCodes[i] ); 
       
       }
       
@@ -71,16 +95,9 @@ std::set< int > FTDSectorConnector::getTargetSectors ( int sector ){
       
       unsigned layerTarget = 0;
       
-      for ( unsigned iModule=0; iModule < nModules ; iModule++){ //over all modules
-         
-         for ( unsigned iSensor=0; iSensor < nSensors ; iSensor++ ){ //over all sensors
-            
-            
-            targetSectors.insert( _sectorSystemFTD->getSector ( side , layerTarget , iModule , iSensor ) ); 
-            
-         }
-         
-      }
+      int sideLayerCode = _sectorSystemFTD->getSector ( side , layerTarget , 0 , 0 );
+      
+      for ( unsigned i=0; i < _allSensorCodes.size(); i++ ) targetSectors.insert( sideLayerCode | _allSensorCodes[i] ); 
       
    }
    
@@ -88,5 +105,3 @@ std::set< int > FTDSectorConnector::getTargetSectors ( int sector ){
    
    
 }
-
-
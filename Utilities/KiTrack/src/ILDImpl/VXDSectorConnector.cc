@@ -17,6 +17,43 @@ VXDSectorConnector::VXDSectorConnector( const SectorSystemVXD* sectorSystemVXD ,
    _neighPhi = neighPhi ;
    _neighTheta = neighTheta ;
    _layerMax = layerMax ;
+
+   // Precompute the codes of the neighbouring phi and theta divisions, so that
+   // the target sectors are only a combination of bits
+
+   const SectorCodeField& phiField = sectorSystemVXD->getPhiField();
+   const SectorCodeField& thetaField = sectorSystemVXD->getThetaField();
+
+   _neighbourPhiCodes.resize( _nDivisionsInPhi );
+   
+   for ( int iPhi = 0; iPhi < int( _nDivisionsInPhi ); iPhi++ ){
+
+     for ( int ip = iPhi - _neighPhi ; ip <= iPhi + _neighPhi ; ip++ ){
+
+       int wrapped = ip;
+
+       // catch wrap-around
+       if (wrapped < 0) wrapped = _nDivisionsInPhi-1;          
+       if (wrapped >= int(_nDivisionsInPhi)) wrapped = wrapped - _nDivisionsInPhi;
+
+       _neighbourPhiCodes[iPhi].push_back( phiField.encode( wrapped ) );
+
+     }
+   }
+
+   _neighbourThetaCodes.resize( _nDivisionsInTheta );
+
+   for ( int iTheta = 0; iTheta < int( _nDivisionsInTheta ); iTheta++ ){
+
+     int iTheta_Up  = iTheta + _neighTheta; 
+     int iTheta_Low = iTheta - _neighTheta;
+     if (iTheta_Low < 0) iTheta_Low = 0;
+     if (iTheta_Up  >= int(_nDivisionsInTheta)) iTheta_Up = _nDivisionsInTheta-1;
+
+     for ( int it = iTheta_Low ; it <= iTheta_Up ; it++ ) _neighbourThetaCodes[iTheta].push_back( thetaField.encode( it ) );
+
+   }
+
 }
 
 
@@ -26,48 +63,33 @@ std::set< int > VXDSectorConnector::getTargetSectors ( int sector ){
    
    std::set <int> targetSectors;
 
-   //std::cout << " check : n layers " << _nLayers << " n phi divisions " << _nDivisionsInPhi << " n theta divisions " << _nDivisionsInTheta << std::endl ;
-
    // Decode the sector integer,  and take the layer, phi and theta bin
    
-   int iTheta = sector/(_nLayers*_nDivisionsInPhi) ;
-   
-   int iPhi = ((sector - (iTheta*_nLayers*_nDivisionsInPhi)) / _nLayers) ;
+   unsigned layer = _sectorSystemVXD->getLayer( sector );
    
-   int layer = sector - (iTheta*_nLayers*_nDivisionsInPhi) - (iPhi*_nLayers) ; 
+   // search for sectors at the neighbouring theta and phi bins
 
-   // search for sectors at the neighbouring theta nad phi bins
-
-   int iPhi_Up    = iPhi + _neighPhi;
-   int iPhi_Low   = iPhi - _neighPhi;
-   int iTheta_Up  = iTheta + _neighTheta; 
-   int iTheta_Low = iTheta - _neighTheta;
-   if (iTheta_Low < 0) iTheta_Low = 0;
-   if (iTheta_Up  >= _nDivisionsInTheta) iTheta_Up = _nDivisionsInTheta-1;
+   const std::vector< int >& phiCodes = _neighbourPhiCodes[ _sectorSystemVXD->getPhi( sector ) ];
+   const std::vector< int >& thetaCodes = _neighbourThetaCodes[ _sectorSystemVXD->getTheta( sector ) ];
    
    //*************************************************************************************
 
-   //streamlog_out(DEBUG2) << " checking sector " << sector << " layer " << layer << " phi " << iPhi << " theta " << iTheta <<std::endl ;
-   
    for( unsigned layerStep = 1; layerStep <= _layerStepMax; layerStep++ ){
      
      if ( layer >= layerStep ){ // +1 makes sense if I use IP as innermost layer
        
        unsigned layerTarget = layer - layerStep;
 
-        if (layerTarget >= 0 && layerTarget < _layerMax ){   // just a test to run cellular automaton over the whole VXD - SIT
-	 
-	 for (int iPhi = iPhi_Low ; iPhi <= iPhi_Up ; iPhi++){
+        if ( int(layerTarget) < _layerMax ){   // just a test to run cellular automaton over the whole VXD - SIT
 
-	   int ip = iPhi;
-	   
-	   // catch wrap-around
-	   if (ip < 0) ip = _nDivisionsInPhi-1;          
-	   if (ip >= _nDivisionsInPhi) ip = ip - _nDivisionsInPhi;
+	 // phi 0 and theta 0 are all zero bits, so this is only the layer part of the code
+	 int layerCode = _sectorSystemVXD->getSector( int(layerTarget) , 0 , 0 );
+	 
+	 for ( unsigned i = 0 ; i < phiCodes.size() ; i++ ){
 	   
-	   for (int iTheta = iTheta_Low ; iTheta <= iTheta_Up ; iTheta++){
+	   for ( unsigned j = 0 ; j < thetaCodes.size() ; j++ ){
 	     
-	     targetSectors.insert( _sectorSystemVXD->getSector ( layerTarget , ip , iTheta ) ); 
+	     targetSectors.insert( layerCode | phiCodes[i] | thetaCodes[j] ); 
 	     
 	   }
 	 }
@@ -78,17 +100,9 @@ std::set< int > VXDSectorConnector::getTargetSectors ( int sector ){
 
    if ( layer > 0 && ( layer <= _lastLayerToIP ) ){
       
-     unsigned layerTarget = 0;
-      
-     for (int ip = iPhi_Low ; ip <= iPhi_Up ; ip++){
-       
-       for (int iTheta = iTheta_Low ; iTheta <= iTheta_Up ; iTheta++){
-	 
-	 //streamlog_out(DEBUG1) << " VXDSectorConnector: from layer " << layer << " to layer " << layerTarget << std::endl ;
-	 
-	 targetSectors.insert( 0 ) ;
-       }
-     }
+     // the IP is layer 0, phi 0, theta 0
+     targetSectors.insert( 0 ) ;
+     
    }
    
 										 
@@ -96,5 +110,3 @@ std::set< int > VXDSectorConnector::getTargetSectors ( int sector ){
    
    
 }
-
-
@@ -5,6 +5,8 @@
 
 #include "ILDImpl/SectorSystemVXD.h"
 
+#include <vector>
+
 
 
 namespace KiTrackMarlin{
@@ -41,6 +43,12 @@ namespace KiTrackMarlin{
       int _layerMax ;   
       int _neighTheta ;
       int _neighPhi ;
+      
+      /** For every phi division: the phi part of the sector codes of the phi divisions in reach */
+      std::vector< std::vector< int > > _neighbourPhiCodes;
+      
+      /** For every theta division: the theta part of the sector codes of the theta divisions in reach */
+      std::vector< std::vector< int > > _neighbourThetaCodes;
    };
    
    